@@ -0,0 +1,162 @@
+/**
+ * @file
+ * @brief Header for the EnumXMLTag enum
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2COMMON_ENUMXMLTAG_HPP
+#define SMBLEVELWORKSHOP2_WS2COMMON_ENUMXMLTAG_HPP
+
+#include "ws2common_export.h"
+#include <QStringRef>
+
+namespace WS2Common {
+
+    /**
+     * @brief Every element and attribute name the XML config parser and the scene node deserializer know about
+     *
+     * Parsers look a name up once with XMLTag::fromName and then compare enums, rather than comparing the name against
+     * every string literal in an if/else chain (Each of which converts the literal to a QString first).
+     */
+    enum class EnumXMLTag {
+        /**
+         * @brief Returned for any element name not listed here
+         */
+        UNRECOGNISED,
+
+        //XML config elements and attributes, and elements inside serialized scene nodes
+        ANIMATION_GROUP_ID,
+        ANIMATION_SEESAW_TYPE,
+        ANIM_GROUP_ID,
+        ANIM_INITIAL_STATE,
+        ANIM_KEYFRAMES,
+        ANIM_LOOP_TIME,
+        ANIM_SEESAW_TYPE,
+        BACKGROUND_MODEL,
+        BANANA,
+        BITFLAG,
+        BLUE,
+        BOOSTER,
+        BUMPER,
+        CAST_SHADOW,
+        COLLISION,
+        COLLISION_FLAG,
+        COLLISION_GRID,
+        CONE,
+        CONVEYOR_SPEED,
+        COUNT,
+        CYLINDER,
+        DESTINATION_NAME,
+        DESTINATION_UUID,
+        EASING,
+        EFFECT_KEYFRAMES,
+        EFFECT_TYPE1,
+        EFFECT_TYPE2,
+        END,
+        FALLOUT_PLANE,
+        FALLOUT_VOLUME,
+        FOG,
+        FOG_ANIMATION_KEYFRAMES,
+        FOREGROUND_MODEL,
+        GOAL,
+        GOLF_HOLE,
+        GREEN,
+        HANDLE_A,
+        HANDLE_B,
+        HEIGHT,
+        INITIAL_ROTATION,
+        ITEM_GROUP,
+        JAMABAR,
+        KEYFRAME,
+        LEVEL_MODEL,
+        MESH_COLLISION,
+        MESH_NAME,
+        MESH_TYPE,
+        MODEL_IMPORT,
+        NAME,
+        ORIGIN_POSITION,
+        ORIGIN_ROTATION,
+        PLAYER_ID,
+        POSITION,
+        POS_X,
+        POS_Y,
+        POS_Z,
+        RADIUS,
+        RED,
+        ROTATION,
+        ROTATION_CENTER,
+        ROT_X,
+        ROT_Y,
+        ROT_Z,
+        RUNTIME_REFLECTIVE,
+        SCALE,
+        SCALE_X,
+        SCALE_Y,
+        SCALE_Z,
+        SEESAW_FRICTION,
+        SEESAW_RESET_STIFFNESS,
+        SEESAW_ROTATION_BOUNDS,
+        SEESAW_SENSITIVITY,
+        SEESAW_SPRING,
+        SPHERE,
+        STAGE_MODEL,
+        STAGE_TYPE,
+        START,
+        STEP,
+        SUPER_MONKEY_BALL_STAGE,
+        SWITCH,
+        TEXTURE_SCROLL,
+        TIME,
+        TRACK_PATH,
+        TRANSFORM_ANIMATION,
+        TYPE,
+        UNKNOWN,
+        UNKNOWN1,
+        UNKNOWN2,
+        UNKNOWN_BYTE1,
+        UNKNOWN_BYTE2,
+        UNKNOWN_BYTE3,
+        UNKNOWN_BYTE4,
+        UUID,
+        VALUE,
+        WORMHOLE,
+
+        //Serialized scene node elements
+        NODE_BANANA_SCENE_NODE,
+        NODE_BUMPER_SCENE_NODE,
+        NODE_GOAL_SCENE_NODE,
+        NODE_GROUP_SCENE_NODE,
+        NODE_JAMABAR_SCENE_NODE,
+        NODE_MESH_COLLISION_SCENE_NODE,
+        NODE_MESH_SCENE_NODE,
+        NODE_SCENE_NODE,
+        NODE_START_SCENE_NODE,
+        NODE_WORMHOLE_SCENE_NODE,
+        DATA_BANANA_SCENE_NODE,
+        DATA_COLLISION_SCENE_NODE,
+        DATA_GOAL_SCENE_NODE,
+        DATA_GROUP_SCENE_NODE,
+        DATA_MESH_COLLISION_SCENE_NODE,
+        DATA_MESH_SCENE_NODE,
+        DATA_SCENE_NODE,
+        DATA_WORMHOLE_SCENE_NODE,
+        CHILDREN,
+        DATA
+    };
+
+    namespace XMLTag {
+
+        /**
+         * @brief Looks up the enum for an element or attribute name
+         *
+         * This is a single hash table lookup and one string comparison, and never allocates memory.
+         *
+         * @param name The name, such as from QXmlStreamReader::name() or QXmlStreamAttribute::name()
+         *
+         * @return The EnumXMLTag for the name, or EnumXMLTag::UNRECOGNISED if it isn't a known name
+         */
+        WS2COMMON_EXPORT EnumXMLTag fromName(const QStringRef &name);
+    }
+}
+
+#endif
+
@@ -0,0 +1,97 @@
+/**
+ * @file
+ * @brief Header for the MemoryArena class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2COMMON_MEMORYARENA_HPP
+#define SMBLEVELWORKSHOP2_WS2COMMON_MEMORYARENA_HPP
+
+#include "ws2common_export.h"
+#include <QVector>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+
+namespace WS2Common {
+
+    /**
+     * @brief Hands out memory from a few large blocks, and frees it all at once when destroyed
+     *
+     * Allocating from an arena is just moving a pointer along the current block, which is much quicker than a heap
+     * allocation for each of many small objects (Such as the keyframes in a big config).
+     *
+     * Objects in an arena are never deleted individually and their destructors are never run, so only trivially
+     * destructible objects may be created in one. An arena isn't thread safe - give each thread its own.
+     */
+    class WS2COMMON_EXPORT MemoryArena {
+        protected:
+            size_t blockSize;
+            QVector<char*> blocks;
+
+            /**
+             * @brief The next free byte in the current block
+             */
+            char *current = nullptr;
+
+            /**
+             * @brief How many bytes are left in the current block
+             */
+            size_t remaining = 0;
+
+            size_t bytesAllocated = 0;
+
+        public:
+            /**
+             * @param blockSize How many bytes to allocate from the heap at a time
+             */
+            explicit MemoryArena(size_t blockSize = 64 * 1024);
+
+            /**
+             * @brief Frees every block, and with them every object created in this arena
+             */
+            ~MemoryArena();
+
+            MemoryArena(const MemoryArena&) = delete;
+            MemoryArena& operator=(const MemoryArena&) = delete;
+
+            /**
+             * @brief Allocates memory from the arena
+             *
+             * Allocations bigger than the block size get a block of their own.
+             *
+             * @param size How many bytes to allocate
+             * @param alignment The alignment the memory needs - This must be a power of 2
+             *
+             * @return The memory allocated, which lives as long as the arena
+             */
+            void* allocate(size_t size, size_t alignment);
+
+            /**
+             * @brief Constructs an object in the arena
+             *
+             * @param args Arguments passed to T's constructor
+             *
+             * @return The object created, which lives as long as the arena - Never delete it
+             */
+            template<typename T, typename... Args>
+            T* create(Args&&... args) {
+                static_assert(std::is_trivially_destructible<T>::value, "MemoryArena never runs destructors");
+                return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @return How many bytes have been allocated from this arena, not counting padding and unused space at
+             *         the end of each block
+             */
+            size_t getBytesAllocated() const;
+
+            /**
+             * @return How many blocks have been allocated from the heap
+             */
+            int getBlockCount() const;
+    };
+}
+
+#endif
+
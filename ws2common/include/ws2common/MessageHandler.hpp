@@ -17,8 +17,47 @@ namespace WS2Common {
 
     WS2COMMON_EXPORT void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
     WS2COMMON_EXPORT void setDebugLoggingEnabled(bool enable);
+
+    /**
+     * @brief Makes messageHandler prefix every message logged on this thread until the scope ends
+     *
+     * Used to tell apart the output of jobs running at the same time. Scopes may be nested - the previous prefix is
+     * used again once a scope ends. Work handed to other threads should open a scope with getCurrentPrefix() too.
+     */
+    class WS2COMMON_EXPORT MessagePrefixScope {
+        protected:
+            QString previous;
+
+        public:
+            /**
+             * @param prefix The prefix to put before each message (Such as "[Job 3] ")
+             */
+            explicit MessagePrefixScope(const QString &prefix);
+
+            /**
+             * @brief Makes the previous prefix current again
+             */
+            ~MessagePrefixScope();
+
+            MessagePrefixScope(const MessagePrefixScope&) = delete;
+            MessagePrefixScope& operator=(const MessagePrefixScope&) = delete;
+
+            /**
+             * @return The prefix current on this thread, or an empty string if there isn't one
+             */
+            static QString getCurrentPrefix();
+    };
 }
 
+/**
+ * @brief Use like qDebug(), but the message is only built when debug logging is enabled
+ *
+ * qDebug() formats every message, and only then does messageHandler throw it away if debug logging is disabled. This
+ * skips the whole statement instead - including evaluating what's streamed into it - so it's free to use in hot loops.
+ */
+#define ws2Debug() \
+    for (bool ws2DebugEnabled = WS2Common::enableDebugLogging; ws2DebugEnabled; ws2DebugEnabled = false) qDebug()
+
 //Custom types
 WS2COMMON_EXPORT QDebug operator<<(QDebug debug, const glm::vec3 &vec);
 WS2COMMON_EXPORT QDebug operator<<(QDebug debug, const glm::vec2 &vec);
@@ -0,0 +1,176 @@
+/**
+ * @file
+ * @brief Header for the Profiler class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2COMMON_PROFILER_HPP
+#define SMBLEVELWORKSHOP2_WS2COMMON_PROFILER_HPP
+
+#include "ws2common_export.h"
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QByteArray>
+
+namespace WS2Common {
+
+    /**
+     * @brief Records wall time, CPU time and peak memory usage for named stages of a pipeline
+     *
+     * Stages are timed with Profiler::Scope. A Scope constructed with a nullptr profiler does nothing, so code can be
+     * instrumented unconditionally and only pay for the timing when a profiler is attached.
+     *
+     * Scopes may be opened from multiple threads at once.
+     */
+    class WS2COMMON_EXPORT Profiler {
+        public:
+            /**
+             * @brief A single timed stage
+             */
+            struct Entry {
+                QString name;
+                QString category;
+
+                /**
+                 * @brief A small integer identifying the thread the stage ran on (The thread the profiler was
+                 *        constructed on is 0)
+                 */
+                int threadIndex;
+
+                /**
+                 * @brief How long after the profiler was constructed the stage started, in nanoseconds
+                 */
+                qint64 startNs;
+
+                qint64 wallNs;
+
+                /**
+                 * @brief CPU time spent by the thread that ran the stage, in nanoseconds
+                 */
+                qint64 threadCpuNs;
+
+                /**
+                 * @brief CPU time spent by the whole process (all threads) while the stage ran, in nanoseconds
+                 */
+                qint64 processCpuNs;
+
+                /**
+                 * @brief The peak resident memory of the process when the stage finished, in bytes
+                 */
+                qint64 peakMemoryBytes;
+            };
+
+            /**
+             * @brief RAII helper - Times from construction until destruction and records the result in a profiler
+             */
+            class WS2COMMON_EXPORT Scope {
+                protected:
+                    Profiler *profiler;
+                    QString name;
+                    QString category;
+                    qint64 startNs;
+                    qint64 startThreadCpuNs;
+                    qint64 startProcessCpuNs;
+
+                public:
+                    /**
+                     * @brief Starts timing a stage
+                     *
+                     * @param profiler The profiler to record to - may be nullptr, in which case nothing is recorded
+                     * @param name The name of the stage
+                     * @param category The category of the stage, used to group related stages
+                     */
+                    Scope(Profiler *profiler, const QString &name, const QString &category = QString());
+
+                    /**
+                     * @brief Stops timing the stage and records it
+                     */
+                    ~Scope();
+
+                    Scope(const Scope&) = delete;
+                    Scope& operator=(const Scope&) = delete;
+            };
+
+            enum class EnumOutputFormat {
+                /**
+                 * @brief A flat JSON object with an array of stages
+                 */
+                JSON,
+
+                /**
+                 * @brief The Chrome trace event format - viewable in chrome://tracing or Perfetto
+                 */
+                TRACE_EVENT
+            };
+
+        protected:
+            QElapsedTimer timer;
+            QVector<Entry> entries;
+            QHash<Qt::HANDLE, int> threadIndices;
+            QMutex mutex;
+
+        public:
+            Profiler();
+
+            /**
+             * @brief Records a stage - Usually you want to use Profiler::Scope instead of calling this directly
+             *
+             * @param entry The stage to record (threadIndex is filled in by the profiler)
+             */
+            void addEntry(Entry entry);
+
+            /**
+             * @brief Returns a copy of all stages recorded so far, in the order they finished
+             *
+             * @return All recorded stages
+             */
+            QVector<Entry> getEntries();
+
+            /**
+             * @brief Discards all recorded stages
+             */
+            void clear();
+
+            /**
+             * @brief Returns how long ago the profiler was constructed, in nanoseconds
+             *
+             * @return Nanoseconds since construction
+             */
+            qint64 getElapsedNs() const;
+
+            /**
+             * @brief Serializes all recorded stages
+             *
+             * @param format Whether to output plain JSON or Chrome trace events
+             *
+             * @return UTF-8 encoded JSON
+             */
+            QByteArray toJson(EnumOutputFormat format);
+
+            /**
+             * @brief Returns the CPU time used by the calling thread
+             *
+             * @return The CPU time in nanoseconds, or 0 if unsupported on this platform
+             */
+            static qint64 getThreadCpuTimeNs();
+
+            /**
+             * @brief Returns the CPU time used by the process across all threads
+             *
+             * @return The CPU time in nanoseconds, or 0 if unsupported on this platform
+             */
+            static qint64 getProcessCpuTimeNs();
+
+            /**
+             * @brief Returns the peak resident memory (high water mark) of the process
+             *
+             * @return The peak memory in bytes, or 0 if unsupported on this platform
+             */
+            static qint64 getPeakMemoryBytes();
+    };
+}
+
+#endif
+
@@ -74,6 +74,27 @@ namespace WS2Common {
                 QString zAttrName = "z"
                 );
 
+        /**
+         * @brief Parses a float, giving exactly the same result as QStringRef::toFloat but much quicker
+         *
+         * Plain decimal numbers (Such as "-12.5" or "3e-4") with up to 15 significant digits are parsed straight from
+         * the UTF-16 characters, without allocating or going through the locale. Anything else (Whitespace, "inf",
+         * very long or very large numbers, invalid input) is handed to QStringRef::toFloat.
+         *
+         * @param str The string to parse
+         * @param ok If not nullptr, set to whether the string was a valid number
+         *
+         * @return The parsed float, or 0 if the string isn't a valid number
+         */
+        WS2COMMON_EXPORT float parseFloat(const QStringRef &str, bool *ok = nullptr);
+
+        /**
+         * @brief Parses a float, giving exactly the same result as QString::toFloat but much quicker
+         *
+         * @see parseFloat(const QStringRef&, bool*)
+         */
+        WS2COMMON_EXPORT float parseFloat(const QString &str, bool *ok = nullptr);
+
         /**
          * @brief Gets an XML attribute with the name attrName
          *
@@ -82,7 +103,7 @@ namespace WS2Common {
          *
          * @return The value of the attribute
          */
-        WS2COMMON_EXPORT QStringRef getAttribute(const QXmlStreamAttributes &attrs, const QString attrName);
+        WS2COMMON_EXPORT QStringRef getAttribute(const QXmlStreamAttributes &attrs, QLatin1String attrName);
 
         /**
          * @brief Gets 3 XML attributes with the names x, y, z, and puts them in a glm::vec3
@@ -95,7 +116,7 @@ namespace WS2Common {
          * @return A vec3 of the float values read from the x, y, z attrubutes
          */
         WS2COMMON_EXPORT glm::vec3 getVec3Attributes(const QXmlStreamAttributes &attrs,
-                const QString x = "x", const QString y = "y", const QString z = "z");
+                QLatin1String x = QLatin1String("x"), QLatin1String y = QLatin1String("y"), QLatin1String z = QLatin1String("z"));
 
         /**
          * @brief Gets 2 XML attributes with the names x, y and puts them in a glm::vec2
@@ -107,7 +128,7 @@ namespace WS2Common {
          * @return A vec2 of the float values read from the x, y attrubutes
          */
         WS2COMMON_EXPORT glm::vec2 getVec2Attributes(const QXmlStreamAttributes &attrs,
-                const QString x = "x", const QString y = "y");
+                QLatin1String x = QLatin1String("x"), QLatin1String y = QLatin1String("y"));
 
         /**
          * @brief Gets 2 XML attributes with the names x, y and puts them in a glm::uvec2
@@ -119,7 +140,7 @@ namespace WS2Common {
          * @return A uvec2 of the float values read from the x, y attrubutes
          */
         WS2COMMON_EXPORT glm::uvec2 getUVec2Attributes(const QXmlStreamAttributes &attrs,
-                const QString x = "x", const QString y = "y");
+                QLatin1String x = QLatin1String("x"), QLatin1String y = QLatin1String("y"));
     }
 }
 
@@ -42,10 +42,17 @@ namespace WS2Common {
             Stage();
 
             /**
-             * @brief Destructor for Stage - Performs cleanup
+             * @brief Destructor for Stage - Deletes the scene graph, fog and fog animation
              */
             ~Stage();
 
+            /**
+             * @brief Deep copies the stage's scene graph, fog and fog animation along with the rest of its settings
+             *
+             * @return A new copy of this stage
+             */
+            Stage* clone() const;
+
             /**
              * @brief Setter for rootNode
              *
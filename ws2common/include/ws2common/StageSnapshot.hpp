@@ -0,0 +1,79 @@
+/**
+ * @file
+ * @brief Header for the StageSnapshot namespace
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2COMMON_STAGESNAPSHOT_HPP
+#define SMBLEVELWORKSHOP2_WS2COMMON_STAGESNAPSHOT_HPP
+
+#include "ws2common_export.h"
+#include "ws2common/Stage.hpp"
+#include <QIODevice>
+#include <QString>
+
+namespace WS2Common {
+
+    /**
+     * @brief Reads and writes a versioned binary snapshot of a whole Stage and its scene graph
+     *
+     * A snapshot holds everything in the stage - the stage type, fallout plane, fog, fog animation and model URLs -
+     * and every scene node with its type, UUID, transform, animations and type specific data (Such as mesh names,
+     * collision grids and wormhole destinations). Nodes are written depth first, each followed by its children.
+     *
+     * This is much quicker to save and load than XML for big scenes, as nothing needs formatting or parsing as text.
+     * XML is still what to use for interchange - snapshots are only readable by a Workshop 2 build that knows their
+     * format version, and an older snapshot is rejected rather than converted.
+     *
+     * Snapshots are big endian, so they can be shared between machines.
+     *
+     * @note Nodes share effect animations and track paths when cloned, but each node in a snapshot gets its own copy
+     *       when read back.
+     */
+    namespace StageSnapshot {
+        /**
+         * @brief Writes a snapshot of a stage
+         *
+         * @param device The device to write to - This must already be open for writing
+         * @param stage The stage to write
+         *
+         * @return Whether the snapshot was written successfully
+         */
+        WS2COMMON_EXPORT bool write(QIODevice &device, const Stage &stage);
+
+        /**
+         * @brief Writes a snapshot of a stage to a file
+         *
+         * The file is only replaced once the whole snapshot has been written, so a failed save never leaves a
+         * half written file behind.
+         *
+         * @param filePath The path to write the snapshot to
+         * @param stage The stage to write
+         *
+         * @return Whether the snapshot was written successfully
+         */
+        WS2COMMON_EXPORT bool writeFile(const QString &filePath, const Stage &stage);
+
+        /**
+         * @brief Reads a stage from a snapshot
+         *
+         * @param device The device to read from - This must already be open for reading
+         *
+         * @return The stage read, or nullptr if the snapshot is invalid, truncated, or from another format version
+         */
+        WS2COMMON_EXPORT Stage* read(QIODevice &device);
+
+        /**
+         * @brief Reads a stage from a snapshot file
+         *
+         * The file is memory mapped and read in place, rather than read into memory first.
+         *
+         * @param filePath The path to the snapshot file
+         *
+         * @return The stage read, or nullptr if the file couldn't be read or isn't a valid snapshot
+         */
+        WS2COMMON_EXPORT Stage* readFile(const QString &filePath);
+    }
+}
+
+#endif
+
@@ -0,0 +1,65 @@
+/**
+ * @file
+ * @brief Header for the ThreadPoolUtils namespace
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2COMMON_THREADPOOLUTILS_HPP
+#define SMBLEVELWORKSHOP2_WS2COMMON_THREADPOOLUTILS_HPP
+
+#include "ws2common_export.h"
+#include <QRunnable>
+
+namespace WS2Common {
+
+    /**
+     * @brief Helpers for running work on, and waiting for work on, the global thread pool
+     *
+     * Qt can't tell whether a thread belongs to the global thread pool, so tasks started with startGlobal mark the
+     * thread they run on. Code that blocks waiting for tasks in the global pool uses a WaitScope, which only gives the
+     * thread back to the pool if it was one of the pool's to begin with.
+     */
+    namespace ThreadPoolUtils {
+
+        /**
+         * @brief Starts a task on the global thread pool, marking the thread it runs on as a global pool thread
+         *        while it runs
+         *
+         * The task is deleted after it runs if its autoDelete is set, as QThreadPool::start would
+         *
+         * @param task The task to run
+         */
+        WS2COMMON_EXPORT void startGlobal(QRunnable *task);
+
+        /**
+         * @return Whether this thread is running a task started with startGlobal
+         */
+        WS2COMMON_EXPORT bool isGlobalPoolThread();
+
+        /**
+         * @brief Lets the global thread pool run another thread in this one's place until the scope ends, if this
+         *        thread is a global pool thread - Use around waiting for tasks started on the global pool
+         *
+         * Without this, a global pool thread waiting for other global pool tasks takes up a thread they could run
+         * on, and deadlocks if every thread is waiting. Other threads aren't counted by the pool, so nothing is
+         * released for them.
+         */
+        class WS2COMMON_EXPORT WaitScope {
+            protected:
+                bool released;
+
+            public:
+                WaitScope();
+
+                /**
+                 * @brief Takes the thread back from the global thread pool, if it was released
+                 */
+                ~WaitScope();
+
+                WaitScope(const WaitScope&) = delete;
+                WaitScope& operator=(const WaitScope&) = delete;
+        };
+    }
+}
+
+#endif
+
@@ -0,0 +1,84 @@
+/**
+ * @file
+ * @brief Header for the UuidGenerator class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2COMMON_UUIDGENERATOR_HPP
+#define SMBLEVELWORKSHOP2_WS2COMMON_UUIDGENERATOR_HPP
+
+#include "ws2common_export.h"
+#include <QUuid>
+#include <random>
+
+namespace WS2Common {
+
+    /**
+     * @brief Generates random (Version 4) UUIDs from a seeded pseudo random number generator
+     *
+     * QUuid::createUuid reads from the system's random number generator for every UUID, which adds up when creating
+     * many thousands of scene nodes at once. A UuidGenerator is seeded from the system's random number generator
+     * once, and is then just as unlikely to repeat a UUID in practice.
+     *
+     * Scene nodes get their UUID from UuidGenerator::createUuid, which uses the generator made current on this thread
+     * with a UuidGenerator::Scope, if there is one. A UuidGenerator isn't thread safe - give each thread its own.
+     */
+    class WS2COMMON_EXPORT UuidGenerator {
+        protected:
+            std::mt19937_64 randGen;
+
+        public:
+            /**
+             * @brief Makes a UUID generator seeded from the system's random number generator
+             */
+            UuidGenerator();
+
+            /**
+             * @brief Makes a UUID generator with a fixed seed, which always generates the same UUIDs
+             *
+             * @param seed The seed to use
+             */
+            explicit UuidGenerator(quint64 seed);
+
+            /**
+             * @return The next UUID
+             */
+            QUuid generate();
+
+            /**
+             * @brief Generates a UUID with the generator current on this thread, or with QUuid::createUuid if there
+             *        isn't one
+             *
+             * @return A new UUID
+             */
+            static QUuid createUuid();
+
+            /**
+             * @brief Makes a generator current on this thread until the scope ends
+             *
+             * Scopes may be nested - the previous generator is current again once a scope ends. A Scope constructed
+             * with a nullptr generator makes QUuid::createUuid current, so code can open a scope unconditionally.
+             */
+            class WS2COMMON_EXPORT Scope {
+                protected:
+                    UuidGenerator *previous;
+
+                public:
+                    /**
+                     * @param generator The generator to make current, or nullptr to use QUuid::createUuid - This
+                     *                  must outlive the scope
+                     */
+                    explicit Scope(UuidGenerator *generator);
+
+                    /**
+                     * @brief Makes the previous generator current again
+                     */
+                    ~Scope();
+
+                    Scope(const Scope&) = delete;
+                    Scope& operator=(const Scope&) = delete;
+            };
+    };
+}
+
+#endif
+
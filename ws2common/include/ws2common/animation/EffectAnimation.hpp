@@ -3,7 +3,9 @@
 #include "ws2common_export.h"
 #include "ws2common/animation/KeyframeEffect1.hpp"
 #include "ws2common/animation/KeyframeEffect2.hpp"
+#include "ws2common/MemoryArena.hpp"
 #include <QVector>
+#include <QSharedPointer>
 
 namespace WS2Common {
     namespace Animation {
@@ -12,6 +14,12 @@ namespace WS2Common {
                 QVector<KeyframeEffect1*> effect1Keyframes;
                 QVector<KeyframeEffect2*> effect2Keyframes;
 
+                /**
+                 * @brief The arena the keyframes were created in, if any - Shared by copies of this animation, so the
+                 *        keyframes live as long as any animation using them
+                 */
+                QSharedPointer<MemoryArena> keyframeArena;
+
             public:
                 const QVector<KeyframeEffect1*>& getEffect1Keyframes() const;
                 QVector<KeyframeEffect1*>& getEffect1Keyframes();
@@ -19,6 +27,18 @@ namespace WS2Common {
                 const QVector<KeyframeEffect2*>& getEffect2Keyframes() const;
                 QVector<KeyframeEffect2*>& getEffect2Keyframes();
                 void setEffect2Keyframes(QVector<KeyframeEffect2*> &value);
+
+                /**
+                 * @return The arena the keyframes were created in, or a null pointer if they were created with new
+                 */
+                QSharedPointer<MemoryArena> getKeyframeArena() const;
+
+                /**
+                 * @brief Keeps an arena alive as long as this animation is, for keyframes created in it
+                 *
+                 * @param keyframeArena The arena the keyframes were created in
+                 */
+                void setKeyframeArena(QSharedPointer<MemoryArena> keyframeArena);
         };
     }
 }
@@ -18,6 +18,12 @@ namespace WS2Common {
 
                 std::set<KeyframeF*, KeyframeCompare> unknownKeyframes;
 
+                /**
+                 * @brief The arena the keyframes were created in, if any - Shared by copies of this animation, so the
+                 *        keyframes live as long as any animation using them
+                 */
+                QSharedPointer<MemoryArena> keyframeArena;
+
             public:
                 std::set<KeyframeF *, KeyframeCompare>& getRedKeyframes();
                 std::set<KeyframeF *, KeyframeCompare>& getGreenKeyframes();
@@ -36,6 +42,18 @@ namespace WS2Common {
                 const std::set<KeyframeF *, KeyframeCompare>& getEndDistanceKeyframes() const;
 
                 const std::set<KeyframeF *, KeyframeCompare>& getUnknownKeyframes() const;
+
+                /**
+                 * @return The arena the keyframes were created in, or a null pointer if they were created with new
+                 */
+                QSharedPointer<MemoryArena> getKeyframeArena() const;
+
+                /**
+                 * @brief Keeps an arena alive as long as this animation is, for keyframes created in it
+                 *
+                 * @param keyframeArena The arena the keyframes were created in
+                 */
+                void setKeyframeArena(QSharedPointer<MemoryArena> keyframeArena);
         };
     }
 }
@@ -10,6 +10,8 @@
 #include "ws2common/EnumPlaybackState.hpp"
 #include "ws2common/animation/EnumLoopType.hpp"
 #include "ws2common/animation/Keyframe.hpp"
+#include "ws2common/MemoryArena.hpp"
+#include <QSharedPointer>
 #include <set>
 
 namespace WS2Common {
@@ -41,6 +43,12 @@ namespace WS2Common {
                 std::set<KeyframeF*, KeyframeCompare> unknown1Keyframes;
                 std::set<KeyframeF*, KeyframeCompare> unknown2Keyframes;
 
+                /**
+                 * @brief The arena the keyframes were created in, if any - Shared by copies of this animation, so the
+                 *        keyframes live as long as any animation using them
+                 */
+                QSharedPointer<MemoryArena> keyframeArena;
+
             public:
                 EnumPlaybackState getInitialState() const;
                 void setInitialState(EnumPlaybackState state);
@@ -76,6 +84,18 @@ namespace WS2Common {
                 const std::set<KeyframeF*, KeyframeCompare>& getUnknown1Keyframes() const;
                 std::set<KeyframeF*, KeyframeCompare>& getUnknown2Keyframes();
                 const std::set<KeyframeF*, KeyframeCompare>& getUnknown2Keyframes() const;
+
+                /**
+                 * @return The arena the keyframes were created in, or a null pointer if they were created with new
+                 */
+                QSharedPointer<MemoryArena> getKeyframeArena() const;
+
+                /**
+                 * @brief Keeps an arena alive as long as this animation is, for keyframes created in it
+                 *
+                 * @param keyframeArena The arena the keyframes were created in
+                 */
+                void setKeyframeArena(QSharedPointer<MemoryArena> keyframeArena);
         };
     }
 }
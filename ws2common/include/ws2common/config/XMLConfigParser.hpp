@@ -29,16 +29,90 @@
 #include "ws2common/scene/GoalSceneNode.hpp"
 #include "ws2common/EnumAnimationSeesawType.hpp"
 #include "ws2common/CollisionGrid.hpp"
+#include "ws2common/MemoryArena.hpp"
 #include <QXmlStreamAttributes>
 #include <QHash>
+#include <QVector>
+#include <QPair>
+#include <QStringList>
 #include <QUrl>
 #include <QDir>
+#include <QIODevice>
+#include <QByteArray>
 
 namespace WS2Common {
     namespace Config {
         class WS2COMMON_EXPORT XMLConfigParser {
+            public:
+                /**
+                 * @brief Problems found when linking wormholes to their destinations, after a config is parsed
+                 */
+                struct WormholeLinkReport {
+                    /**
+                     * @brief How many wormholes were linked to their destination
+                     */
+                    int linkedCount = 0;
+
+                    /**
+                     * @brief Names given to more than one wormhole, in the order they were first duplicated
+                     *
+                     * Destinations with one of these names link to the first wormhole with it in the config.
+                     */
+                    QStringList duplicateNames;
+
+                    /**
+                     * @brief Wormhole name, destination name pairs for wormholes whose destination doesn't exist
+                     */
+                    QVector<QPair<QString, QString>> missingDestinations;
+
+                    /**
+                     * @return Whether every wormhole was linked, and no wormhole names were duplicated
+                     */
+                    bool isOk() const;
+                };
+
+                /**
+                 * @brief A problem found in an XML config by validateStage
+                 */
+                struct ValidationError {
+                    /**
+                     * @brief Where the element or text with the problem starts, as counted by QXmlStreamReader
+                     */
+                    qint64 line;
+                    qint64 column;
+
+                    QString message;
+                };
+
             protected:
-                QHash<Scene::WormholeSceneNode*, QString> wormholeDestMap;
+                /**
+                 * @brief Every wormhole parsed, in config order
+                 */
+                QVector<Scene::WormholeSceneNode*> wormholes;
+
+                /**
+                 * @brief Wormholes with a destination, and the name of their destination, in config order
+                 */
+                QVector<QPair<Scene::WormholeSceneNode*, QString>> wormholeDests;
+
+                WormholeLinkReport wormholeLinkReport;
+
+                /**
+                 * @brief Element name, the number to give the next node of that type without a name (Such as "Goal 3")
+                 */
+                QHash<QString, unsigned int> defaultNameIds;
+
+                /**
+                 * @brief Item groups already parsed in parallel, in config order, to use in place of each itemGroup
+                 *        element
+                 */
+                QVector<Scene::GroupSceneNode*> parsedItemGroups;
+                int nextParsedItemGroup = 0;
+
+                /**
+                 * @brief The arena keyframes are created in while parsing, if pooled allocation is enabled
+                 */
+                QSharedPointer<MemoryArena> keyframeArena;
 
             public:
                 /**
@@ -51,7 +125,121 @@ namespace WS2Common {
                  */
                 Stage* parseStage(QString config, QDir relativeRoot);
 
+                /**
+                 * @brief Parses an XML config straight from a device and converts it into a Stage object
+                 *
+                 * The config is read as it is parsed, rather than read into a string first, so memory use doesn't grow
+                 * with the size of the config file.
+                 *
+                 * @param device The device to read the XML from - This must already be open for reading
+                 * @param relativeRoot The directory the config file resides in, to allow obtaining paths for relative files
+                 *
+                 * @return A pointer to stage created
+                 */
+                Stage* parseStage(QIODevice &device, QDir relativeRoot);
+
+                /**
+                 * @return Problems found linking wormholes in the last config parsed
+                 */
+                const WormholeLinkReport& getWormholeLinkReport() const;
+
+                /**
+                 * @brief Checks an XML config against XMLConfigSchema, without creating a Stage
+                 *
+                 * The config is streamed through once and no scene nodes are created, so this is much quicker than
+                 * parseStage for checking a config is valid. Unrecognised elements and attributes, missing required
+                 * attributes, values that aren't valid numbers, booleans or enum names, missing modelImport files and
+                 * malformed XML are all reported, with where in the config they are.
+                 *
+                 * Wormhole destinations aren't checked, as that needs every wormhole in the config.
+                 *
+                 * @param device The device to read the XML from - This must already be open for reading
+                 * @param relativeRoot The directory the config file resides in, to check relative modelImport paths
+                 *
+                 * @return Every problem found, in the order they appear in the config - Empty if the config is valid
+                 */
+                static QVector<ValidationError> validateStage(QIODevice &device, QDir relativeRoot);
+
+                /**
+                 * @brief Sets whether item groups are parsed in parallel
+                 *
+                 * When enabled, the config is read into memory and quickly scanned for each itemGroup element, and
+                 * the item groups are then parsed on the global thread pool, each with its own XML reader. The stage
+                 * created is identical to parsing one item group after another.
+                 *
+                 * Configs that can't be safely split up (Such as ones with a DOCTYPE, or not encoded as UTF-8) are
+                 * still parsed serially. Disabled by default.
+                 *
+                 * @param enabled Whether parallel parsing is enabled
+                 */
+                static void setParallelParsingEnabled(bool enabled);
+
+                /**
+                 * @return Whether item groups are parsed in parallel
+                 */
+                static bool isParallelParsingEnabled();
+
+                /**
+                 * @brief Sets whether configs are parsed with pooled allocation
+                 *
+                 * When enabled, every keyframe in a config is created in a MemoryArena shared by the stage's
+                 * animations, rather than allocated one at a time, and is freed along with the last animation using it.
+                 * Scene nodes are given UUIDs from a UuidGenerator seeded once per config, rather than each reading from
+                 * the system's random number generator.
+                 *
+                 * Scene nodes themselves are still allocated one at a time, as they can be deleted and moved between
+                 * parents individually. Disabled by default.
+                 *
+                 * @param enabled Whether pooled allocation is enabled
+                 */
+                static void setPooledAllocationEnabled(bool enabled);
+
+                /**
+                 * @return Whether configs are parsed with pooled allocation
+                 */
+                static bool isPooledAllocationEnabled();
+
             protected:
+                /**
+                 * @brief Parses an XML config with the reader given and converts it into a Stage object
+                 *
+                 * @param xml The QXmlStreamReader, before anything has been read
+                 * @param relativeRoot The directory the config file resides in, to allow obtaining paths for relative files
+                 *
+                 * @return A pointer to stage created
+                 */
+                Stage* parseStage(QXmlStreamReader &xml, QDir relativeRoot);
+
+                /**
+                 * @brief Parses an XML config, with each item group parsed in parallel
+                 *
+                 * @param config The whole XML config, as UTF-8
+                 * @param relativeRoot The directory the config file resides in, to allow obtaining paths for relative files
+                 *
+                 * @return A pointer to stage created, or nullptr if the config can't be split up into item groups (Or
+                 *         has fewer than 2), in which case it should be parsed serially instead
+                 */
+                Stage* parseStageParallel(const QByteArray &config, QDir relativeRoot);
+
+                /**
+                 * @brief Links every wormhole parsed to its destination, filling in the wormhole link report
+                 *
+                 * The wormholes are indexed by name first, so this is two passes over the wormholes, however many
+                 * there are.
+                 */
+                void linkWormholes();
+
+                /**
+                 * @brief Gets the number for a node without a name, such as the 3 in "Goal 3"
+                 *
+                 * Nodes are numbered from 0 in config order, for each element name separately.
+                 *
+                 * @param elementName The name of the element being parsed
+                 *
+                 * @return The number to use in the node's default name
+                 */
+                unsigned int nextDefaultNameId(const QString &elementName);
+
                 /**
                  * @brief Parses a model import of an XML config
                  *
@@ -197,9 +385,9 @@ namespace WS2Common {
                 Scene::FalloutVolumeSceneNode* parseFalloutVolume(QXmlStreamReader &xml);
 
                 /**
-                 * @brief Parses a wormhole in an XML config
+                 * @brief Parses a wormhole in an XML config, and keeps track of it for linking later
                  *
-                 * Make sure the XML reader is within the switch element before calling this
+                 * Make sure the XML reader is within the wormhole element before calling this
                  *
                  * @param xml The QXmlStreamReader
                  *
@@ -0,0 +1,121 @@
+/**
+ * @file
+ * @brief Header for the XMLConfigSchema namespace
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2COMMON_CONFIG_XMLCONFIGSCHEMA_HPP
+#define SMBLEVELWORKSHOP2_WS2COMMON_CONFIG_XMLCONFIGSCHEMA_HPP
+
+#include "ws2common_export.h"
+#include "ws2common/EnumXMLTag.hpp"
+#include <QStringRef>
+#include <QString>
+
+namespace WS2Common {
+    namespace Config {
+
+        /**
+         * @brief A built in description of which elements and attributes an XML config may have, and which values
+         *        they may hold
+         *
+         * This is what XMLConfigParser::validateStage checks configs against. It mirrors what XMLConfigParser reads -
+         * when the parser learns a new element, add a rule for it here too.
+         */
+        namespace XMLConfigSchema {
+                /**
+                 * @brief What an element or attribute holds
+                 */
+                enum class EnumValueType {
+                    ELEMENTS, //Child elements, each checked against the schema in turn
+                    EMPTY, //Nothing but attributes (Such as <position x="0" y="0" z="0"/>)
+                    TEXT, //Any text
+                    FLOAT,
+                    INTEGER,
+                    BOOL, //true or false
+                    ENUM, //One of a list of names
+                    VERSION //Numbers separated by dots (Such as 1.3.0)
+                };
+
+                struct ValueRule {
+                    EnumValueType type;
+
+                    /**
+                     * @brief The smallest and largest values allowed, for FLOAT and INTEGER values
+                     */
+                    double min;
+                    double max;
+
+                    /**
+                     * @brief The names allowed for ENUM values, ending with nullptr
+                     */
+                    const char * const *enumNames;
+                };
+
+                struct AttributeRule {
+                    /**
+                     * @brief The attribute's name - Attributes are only ever looked up in an element's short list, so
+                     *        aren't interned as EnumXMLTags
+                     */
+                    const char *name;
+
+                    bool required;
+                    ValueRule value;
+                };
+
+                struct ElementRule {
+                    /**
+                     * @brief The element this may be in
+                     */
+                    EnumXMLTag parent;
+
+                    /**
+                     * @brief The element the parent must be in, or EnumXMLTag::UNRECOGNISED if the parent can be anywhere
+                     */
+                    EnumXMLTag grandparent;
+
+                    EnumXMLTag name;
+                    ValueRule content;
+
+                    /**
+                     * @brief The attributes this may have, ending with one with a nullptr name, or nullptr if it can't
+                     *        have any
+                     */
+                    const AttributeRule *attributes;
+                };
+
+                /**
+                 * @brief Finds the rule for an element
+                 *
+                 * @param grandparent The element the parent is in, or EnumXMLTag::UNRECOGNISED if the parent is the root
+                 * @param parent The element this is in
+                 * @param name The element to look up
+                 *
+                 * @return The rule, or nullptr if the element isn't allowed there
+                 */
+                WS2COMMON_EXPORT const ElementRule* findElementRule(EnumXMLTag grandparent, EnumXMLTag parent, EnumXMLTag name);
+
+                /**
+                 * @brief Finds the rule for an attribute of an element
+                 *
+                 * @param element The element's rule
+                 * @param name The attribute to look up
+                 *
+                 * @return The rule, or nullptr if the element can't have the attribute
+                 */
+                WS2COMMON_EXPORT const AttributeRule* findAttributeRule(const ElementRule &element, const QStringRef &name);
+
+                /**
+                 * @brief Checks a value against a rule
+                 *
+                 * @param rule The rule to check against
+                 * @param value The text of the element or attribute
+                 *
+                 * @return Why the value isn't allowed, or a null string if it is
+                 */
+                WS2COMMON_EXPORT QString checkValue(const ValueRule &rule, const QStringRef &value);
+        }
+    }
+}
+
+#endif
+
@@ -0,0 +1,123 @@
+/**
+ * @file
+ * @brief Header for the CollisionMesh class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2COMMON_MODEL_COLLISIONMESH_HPP
+#define SMBLEVELWORKSHOP2_WS2COMMON_MODEL_COLLISIONMESH_HPP
+
+#include "ws2common_export.h"
+#include "ws2common/model/Vertex.hpp"
+#include "ws2common/resource/ResourceMesh.hpp"
+#include <glm/glm.hpp>
+#include <QVector>
+
+namespace WS2Common {
+    namespace Model {
+
+        /**
+         * @brief A compact triangle mesh holding only what collision needs - vertex positions and triangle indices
+         *
+         * Positions are stored as a structure of arrays (All X, then all Y, then all Z), at 12 bytes per vertex
+         * rather than the 32 of a full Vertex, so that loops over triangles touch as little memory as possible.
+         *
+         * Triangles appended from several sources are numbered consecutively, in the order they were appended.
+         */
+        class WS2COMMON_EXPORT CollisionMesh {
+            protected:
+                QVector<float> positionsX;
+                QVector<float> positionsY;
+                QVector<float> positionsZ;
+
+                /**
+                 * @brief Every 3 indices here correspond to vertices for a triangle
+                 */
+                QVector<quint32> indices;
+
+            public:
+                /**
+                 * @brief Reserves space for vertices and indices, to avoid reallocating when appending
+                 *
+                 * @param vertexCount The total number of vertices expected
+                 * @param indexCount The total number of indices expected
+                 */
+                void reserve(int vertexCount, int indexCount);
+
+                /**
+                 * @brief Appends triangles, keeping only vertex positions
+                 *
+                 * @param vertices The vertices of the triangles to append
+                 * @param indices Every 3 integers here corresponds to vertices for a triangle in the vertices vector
+                 * @param transform An affine transform to apply to every position as it's appended - Skipped if this is
+                 *                  the identity matrix
+                 */
+                void append(
+                        const QVector<Vertex> &vertices,
+                        const QVector<unsigned int> &indices,
+                        const glm::mat4 &transform = glm::mat4(1.0f)
+                        );
+
+                /**
+                 * @brief Appends every segment of a loaded mesh, in order
+                 *
+                 * Triangles are numbered the same as when walking the mesh's segments one after another.
+                 *
+                 * @param mesh The mesh to append
+                 * @param transform An affine transform to apply to every position as it's appended - Skipped if this is
+                 *                  the identity matrix
+                 */
+                void append(const Resource::ResourceMesh &mesh, const glm::mat4 &transform = glm::mat4(1.0f));
+
+                void clear();
+
+                int getVertexCount() const;
+                int getTriangleCount() const;
+
+                /**
+                 * @return Every vertex's X position
+                 */
+                const QVector<float>& getPositionsX() const;
+
+                /**
+                 * @return Every vertex's Y position
+                 */
+                const QVector<float>& getPositionsY() const;
+
+                /**
+                 * @return Every vertex's Z position
+                 */
+                const QVector<float>& getPositionsZ() const;
+
+                /**
+                 * @return A reference to the indices vector - Every 3 indices correspond to vertices for a triangle
+                 */
+                const QVector<quint32>& getIndices() const;
+
+                /**
+                 * @brief Gets a vertex position
+                 *
+                 * @param vertex The index of the vertex
+                 *
+                 * @return The vertex's position
+                 */
+                inline glm::vec3 getPosition(quint32 vertex) const {
+                    return glm::vec3(positionsX.at(vertex), positionsY.at(vertex), positionsZ.at(vertex));
+                }
+
+                /**
+                 * @brief Gets the position of one of a triangle's corners
+                 *
+                 * @param triangle The triangle number
+                 * @param corner 0, 1 or 2
+                 *
+                 * @return The corner's position
+                 */
+                inline glm::vec3 getTrianglePosition(int triangle, int corner) const {
+                    return getPosition(indices.at(triangle * 3 + corner));
+                }
+        };
+    }
+}
+
+#endif
+
@@ -0,0 +1,100 @@
+/**
+ * @file
+ * @brief Header for the MeshCache namespace
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2COMMON_MODEL_MESHCACHE_HPP
+#define SMBLEVELWORKSHOP2_WS2COMMON_MODEL_MESHCACHE_HPP
+
+#include "ws2common_export.h"
+#include "ws2common/resource/ResourceMesh.hpp"
+#include "ws2common/model/MeshRequirements.hpp"
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QMutex>
+
+namespace WS2Common {
+    namespace Model {
+
+        /**
+         * @brief Reads and writes a compact binary copy of the meshes imported from a model file, so that unchanged
+         *        models can skip Assimp entirely
+         *
+         * A cache file holds, for each mesh, its name and for each segment its raw vertex and index arrays and the
+         * file paths of its textures. It is only used if it was made from the same source file (Path, modification
+         * time and size - or if those differ, a SHA-1 hash of the file contents) with the same MeshRequirements and
+         * vertex welding setting, and every other file the import depended on (Such as an OBJ's MTL file, or its
+         * textures) still has the same modification time and size - or still doesn't exist, if it was missing.
+         * When the source file was only touched and its hash still matches, its new modification time is written back
+         * to the cache file, so it isn't hashed again on the next load.
+         *
+         * Cache files are memory mapped when read. They use the native byte order and aren't meant to be shared
+         * between machines - a cache file from a different byte order is just ignored.
+         *
+         * @note Dependencies aren't hashed like the source file is, so just touching one (Such as a texture being
+         *       re-saved) invalidates the cache file.
+         */
+        namespace MeshCache {
+            /**
+             * @brief Gets the path a model's cache file is stored at
+             *
+             * @param cacheDirectory The directory holding cache files
+             * @param sourcePath The path to the model file
+             * @param requirements What is loaded from the model (Optional) - nullptr for everything
+             *
+             * @return The path to the cache file
+             */
+            WS2COMMON_EXPORT QString getCacheFilePath(
+                    const QString &cacheDirectory,
+                    const QString &sourcePath,
+                    const MeshRequirements *requirements = nullptr
+                    );
+
+            /**
+             * @brief Loads meshes from a cache file, if it is valid for the model file given
+             *
+             * @param cacheFilePath The path to the cache file (See getCacheFilePath)
+             * @param sourcePath The path to the model file
+             * @param meshVector Populated with the meshes read
+             * @param requirements What is loaded from the model (Optional) - nullptr for everything
+             * @param resources A vector of resources (Optional) - Used to prevent creating duplicate resources, and
+             *                  is appended to when loading models and textures
+             * @param resourcesMutex A mutex to prevent multiple threads from writing to resources simultaneously (optional)
+             *
+             * @return Whether the cache file was valid and meshes were loaded from it
+             */
+            WS2COMMON_EXPORT bool readCache(
+                    const QString &cacheFilePath,
+                    const QString &sourcePath,
+                    QVector<Resource::ResourceMesh*> &meshVector,
+                    const MeshRequirements *requirements = nullptr,
+                    QVector<Resource::AbstractResource*> *resources = nullptr,
+                    QMutex *resourcesMutex = nullptr
+                    );
+
+            /**
+             * @brief Writes meshes loaded from a model file to a cache file
+             *
+             * @param cacheFilePath The path to the cache file (See getCacheFilePath)
+             * @param sourcePath The path to the model file the meshes were loaded from
+             * @param meshVector The meshes loaded
+             * @param requirements What was loaded from the model (Optional) - nullptr for everything
+             * @param dependencies The absolute paths of the other files the import depended on (Optional) - See the
+             *                     dependencies parameter of ModelLoader::addModelFromFile
+             *
+             * @return Whether the cache file was written successfully
+             */
+            WS2COMMON_EXPORT bool writeCache(
+                    const QString &cacheFilePath,
+                    const QString &sourcePath,
+                    const QVector<Resource::ResourceMesh*> &meshVector,
+                    const MeshRequirements *requirements = nullptr,
+                    const QStringList &dependencies = QStringList()
+                    );
+        }
+    }
+}
+
+#endif
+
@@ -0,0 +1,68 @@
+/**
+ * @file
+ * @brief Header for the MeshOptimizer namespace
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2COMMON_MODEL_MESHOPTIMIZER_HPP
+#define SMBLEVELWORKSHOP2_WS2COMMON_MODEL_MESHOPTIMIZER_HPP
+
+#include "ws2common_export.h"
+#include "ws2common/model/Vertex.hpp"
+#include <QVector>
+
+namespace WS2Common {
+    namespace Model {
+
+        /**
+         * @brief Functions to shrink and reorder mesh data after import
+         */
+        namespace MeshOptimizer {
+                /**
+                 * @brief Merges vertices with the same position, normal and texture coordinate, and rewrites indices to
+                 *        match
+                 *
+                 * Vertices are compared after quantizing each attribute, so vertices that only differ by float rounding
+                 * are merged too. The first vertex of each merged group is kept as is. The order of the remaining
+                 * vertices is kept.
+                 *
+                 * If any index is out of range, nothing is welded and both vectors are left as they are.
+                 *
+                 * @param vertices The vertices to weld - Replaced with the welded vertices
+                 * @param indices The indices into vertices - Rewritten to index the welded vertices
+                 *
+                 * @return The number of vertices removed
+                 */
+                WS2COMMON_EXPORT int weldVertices(QVector<Vertex> &vertices, QVector<unsigned int> &indices);
+
+                /**
+                 * @brief Reorders triangles so that vertices are reused while still in the GPU's post transform vertex
+                 *        cache
+                 *
+                 * Uses Tom Forsyth's linear speed vertex cache optimization. Only the order of triangles changes - each
+                 * triangle keeps its vertices and winding.
+                 *
+                 * Indices that aren't a whole number of triangles, or that are out of range, are left as they are.
+                 *
+                 * @param indices Triangle list indices to reorder in place
+                 * @param vertexCount The number of vertices indices refers to
+                 */
+                WS2COMMON_EXPORT void optimizeVertexCache(QVector<unsigned int> &indices, int vertexCount);
+
+                /**
+                 * @brief Calculates the average cache miss ratio (Transformed vertices per triangle) for a FIFO
+                 *        post transform cache
+                 *
+                 * 3.0 is the worst possible, and around 0.5 to 0.7 is typical for a well optimized mesh.
+                 *
+                 * @param indices Triangle list indices
+                 * @param cacheSize The number of vertices the simulated cache holds
+                 *
+                 * @return The average number of cache misses per triangle
+                 */
+                WS2COMMON_EXPORT float getAverageCacheMissRatio(const QVector<unsigned int> &indices, int cacheSize = 32);
+        }
+    }
+}
+
+#endif
+
@@ -0,0 +1,116 @@
+/**
+ * @file
+ * @brief Header for the MeshRequirements class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2COMMON_MODEL_MESHREQUIREMENTS_HPP
+#define SMBLEVELWORKSHOP2_WS2COMMON_MODEL_MESHREQUIREMENTS_HPP
+
+#include "ws2common_export.h"
+#include <QHash>
+#include <QString>
+#include <QByteArray>
+
+namespace WS2Common {
+    namespace Model {
+
+        /**
+         * @brief Describes which meshes of a model, and which of their vertex attributes, need loading
+         *
+         * Vertex positions and indices are always loaded for a required mesh. Anything else is only loaded when asked
+         * for, so a consumer that only needs collision (Such as an LZ exporter) can skip the rest.
+         */
+        class WS2COMMON_EXPORT MeshRequirements {
+            public:
+                /**
+                 * @brief Optional data to load for a mesh
+                 */
+                struct WS2COMMON_EXPORT Attributes {
+                    bool normals = false;
+                    bool texCoords = false;
+
+                    /**
+                     * @brief Whether to resolve material texture file paths
+                     */
+                    bool textures = false;
+
+                    /**
+                     * @return Whether this has every attribute other has
+                     */
+                    bool covers(const Attributes &other) const;
+
+                    /**
+                     * @brief Adds every attribute other has to this
+                     */
+                    void merge(const Attributes &other);
+
+                    /**
+                     * @return Attributes with everything enabled
+                     */
+                    static Attributes all();
+                };
+
+            protected:
+                /**
+                 * @brief If true, every mesh is loaded with allMeshAttributes, and meshes is unused
+                 */
+                bool allMeshes = false;
+                Attributes allMeshAttributes;
+
+                QHash<QString, Attributes> meshes; //Mesh name, attributes
+
+            public:
+                /**
+                 * @brief Creates requirements that don't need any meshes
+                 */
+                MeshRequirements() = default;
+
+                /**
+                 * @return Requirements that load every mesh with every attribute - What ModelLoader does when not
+                 *         given any requirements
+                 */
+                static MeshRequirements everything();
+
+                /**
+                 * @brief Marks a mesh as needed
+                 *
+                 * @param meshName The name of the mesh
+                 * @param attributes Optional data to load for the mesh - merged with anything already required
+                 */
+                void require(const QString &meshName, const Attributes &attributes = Attributes());
+
+                /**
+                 * @return Whether the mesh named should be loaded
+                 */
+                bool isMeshRequired(const QString &meshName) const;
+
+                /**
+                 * @return The attributes to load for the mesh named
+                 */
+                Attributes getAttributes(const QString &meshName) const;
+
+                /**
+                 * @return Whether any required mesh needs normals - Normal generation can be skipped entirely otherwise
+                 */
+                bool needsNormals() const;
+
+                /**
+                 * @return Whether a model loaded with these requirements has everything other would need
+                 */
+                bool covers(const MeshRequirements &other) const;
+
+                /**
+                 * @brief Adds everything other requires to this
+                 */
+                void merge(const MeshRequirements &other);
+
+                /**
+                 * @return A string that is the same for any two equal sets of requirements, for use in cache keys
+                 */
+                QByteArray toKey() const;
+        };
+    }
+}
+
+#endif
+
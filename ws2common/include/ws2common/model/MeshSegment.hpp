@@ -34,6 +34,8 @@ namespace WS2Common {
                 /**
                  * @brief Create a new Mesh object with the arguments given and calculates its bounding box (AABB)
                  *
+                 * The arguments are moved into the segment, so pass them with std::move to avoid copying them
+                 *
                  * @param vertices
                  * @param indices
                  * @param textures
@@ -8,8 +8,11 @@
 
 #include "ws2common_export.h"
 #include "ws2common/resource/ResourceMesh.hpp"
+#include "ws2common/resource/TextureManager.hpp"
+#include "ws2common/model/MeshRequirements.hpp"
 #include <assimp/scene.h>
 #include <QVector>
+#include <QStringList>
 #include <QFile>
 #include <QDir>
 #include <QMutex>
@@ -17,6 +20,79 @@
 namespace WS2Common {
     namespace Model {
         namespace ModelLoader {
+                /**
+                 * @brief Sets a directory to cache imported meshes in (See MeshCache)
+                 *
+                 * When set, loadModel reads unchanged model files from the cache instead of importing them with
+                 * Assimp, and caches any model it does import.
+                 *
+                 * @param cacheDirectory The directory to use (It will be created if it doesn't exist), or an empty
+                 *                       string to disable the mesh cache (The default)
+                 */
+                WS2COMMON_EXPORT void setMeshCacheDirectory(const QString &cacheDirectory);
+
+                /**
+                 * @return The mesh cache directory, or an empty string if the mesh cache is disabled
+                 */
+                WS2COMMON_EXPORT QString getMeshCacheDirectory();
+
+                /**
+                 * @brief Sets a texture manager to look textures up with, instead of searching through the whole
+                 *        resources vector for every texture of every material
+                 *
+                 * It's only used when loading into the resources vector the texture manager was created with.
+                 *
+                 * @param manager The texture manager to use, or nullptr to not use one (The default) - This must stay
+                 *                alive until it is unset
+                 */
+                WS2COMMON_EXPORT void setTextureManager(Resource::TextureManager *manager);
+
+                /**
+                 * @return The texture manager set with setTextureManager, or nullptr
+                 */
+                WS2COMMON_EXPORT Resource::TextureManager* getTextureManager();
+
+                /**
+                 * @brief Sets whether to weld duplicate vertices and reorder triangles for the vertex cache when
+                 *        importing models (See MeshOptimizer)
+                 *
+                 * This shrinks most imported meshes considerably, but changes the order of triangles from what the
+                 * model file has. Disabled by default.
+                 *
+                 * @param enabled Whether vertex welding is enabled
+                 */
+                WS2COMMON_EXPORT void setVertexWeldingEnabled(bool enabled);
+
+                /**
+                 * @return Whether vertex welding is enabled
+                 */
+                WS2COMMON_EXPORT bool isVertexWeldingEnabled();
+
+                /**
+                 * @brief Applies an affine transform to every vertex position, and optionally normal, in place
+                 *
+                 * Normals are transformed by the inverse transpose of the transform and renormalized.
+                 *
+                 * @param vertices The vertices to transform
+                 * @param transform The transformation matrix
+                 * @param transformNormals Whether to transform normals too
+                 */
+                WS2COMMON_EXPORT void transformVertices(
+                        QVector<WS2Common::Model::Vertex> &vertices,
+                        const glm::mat4 &transform,
+                        bool transformNormals
+                        );
+
+                /**
+                 * @brief Gets the Assimp post processing steps needed to load meshes
+                 *
+                 * @param requirements Which meshes and vertex attributes will be loaded (Optional) - Everything is
+                 *                     assumed if this is nullptr
+                 *
+                 * @return Assimp aiPostProcessSteps flags
+                 */
+                WS2COMMON_EXPORT unsigned int getPostProcessFlags(const MeshRequirements *requirements = nullptr);
+
                 /**
                  * @brief Loads a model into the scene.
                  *
@@ -25,6 +101,8 @@ namespace WS2Common {
                  * @param resources A vector of resources (Optional) - Used to prevent creating duplicate resources, and
                  *                  is appended to when loading models and textures
                  * @param resourcesMutex A mutex to prevent multiple threads from writing to resources simultaneously (optional)
+                 * @param requirements Which meshes and vertex attributes to load (Optional) - Everything is loaded if
+                 *                     this is nullptr
                  *
                  * @return A vector of added meshes
                  *
@@ -34,7 +112,8 @@ namespace WS2Common {
                 WS2COMMON_EXPORT QVector<WS2Common::Resource::ResourceMesh*> loadModel(
                         QFile &file,
                         QVector<Resource::AbstractResource*> *resources = nullptr,
-                        QMutex *resourcesMutex = nullptr
+                        QMutex *resourcesMutex = nullptr,
+                        const MeshRequirements *requirements = nullptr
                         );
 
                 /**
@@ -44,6 +123,12 @@ namespace WS2Common {
                  * @param resources A vector of resources (Optional) - Used to prevent creating duplicate resources, and
                  *                  is appended to when loading models and textures
                  * @param resourcesMutex A mutex to prevent multiple threads from writing to resources simultaneously (optional)
+                 * @param requirements Which meshes and vertex attributes to load (Optional) - Everything is loaded if
+                 *                     this is nullptr
+                 *
+                 * @param dependencies Appended with the absolute paths of every other file the model depends on (Optional) -
+                 *                     Every file Assimp looked for or opened (Such as an OBJ's MTL file), and every
+                 *                     texture the materials refer to, whether or not they exist
                  *
                  * @return A vector of added meshes
                  *
@@ -52,7 +137,9 @@ namespace WS2Common {
                 WS2COMMON_EXPORT QVector<WS2Common::Resource::ResourceMesh*> addModelFromFile(
                         const char *filePath,
                         QVector<Resource::AbstractResource*> *resources = nullptr,
-                        QMutex *resourcesMutex = nullptr
+                        QMutex *resourcesMutex = nullptr,
+                        const MeshRequirements *requirements = nullptr,
+                        QStringList *dependencies = nullptr
                         );
 
                 /**
@@ -62,6 +149,8 @@ namespace WS2Common {
                  * @param resources A vector of resources (Optional) - Used to prevent creating duplicate resources, and
                  *                  is appended to when loading models and textures
                  * @param resourcesMutex A mutex to prevent multiple threads from writing to resources simultaneously (optional)
+                 * @param requirements Which meshes and vertex attributes to load (Optional) - Everything is loaded if
+                 *                     this is nullptr
                  *
                  * @return A vector of added meshes
                  *
@@ -71,7 +160,8 @@ namespace WS2Common {
                         const void *bytes,
                         size_t byteCount,
                         QVector<Resource::AbstractResource*> *resources = nullptr,
-                        QMutex *resourcesMutex = nullptr
+                        QMutex *resourcesMutex = nullptr,
+                        const MeshRequirements *requirements = nullptr
                         );
 
                 /**
@@ -80,12 +170,14 @@ namespace WS2Common {
                  *
                  * @param node The parent node to process. This is usually the root node if calling it yourself.
                  * @param scene The scene that the node belongs to
-                 * @param globalTransform A matrix transformation to apply to all vertices
+                 * @param globalTransform A matrix transformation to apply to all vertices (And normals)
                  * @param parentDir The parent directory of the file
                  * @param meshVector A reference to a vector that will be populated with all meshes processed
                  * @param resources A vector of resources (Optional) - Used to prevent creating duplicate resources, and
                  *                  is appended to when loading models and textures
                  * @param resourcesMutex A mutex to prevent multiple threads from writing to resources simultaneously (optional)
+                 * @param requirements Which meshes and vertex attributes to load (Optional) - Everything is loaded if
+                 *                     this is nullptr
                  */
                 WS2COMMON_EXPORT void processNode(
                         const aiNode *node,
@@ -95,7 +187,8 @@ namespace WS2Common {
                         const QDir *parentDir,
                         QVector<WS2Common::Resource::ResourceMesh*> &meshVector,
                         QVector<Resource::AbstractResource*> *resources = nullptr,
-                        QMutex *resourcesMutex = nullptr
+                        QMutex *resourcesMutex = nullptr,
+                        const MeshRequirements *requirements = nullptr
                         );
 
                 /**
@@ -103,11 +196,13 @@ namespace WS2Common {
                  *
                  * @param mesh The aiMesh to convert
                  * @param scene The scene that the aiMesh belongs to
-                 * @param globalTransform A matrix transformation to apply to all vertices
+                 * @param globalTransform A matrix transformation to apply to all vertices (And normals)
                  * @param parentDir The parent directory of the file
                  * @param resources A vector of resources (Optional) - Used to prevent creating duplicate resources, and
                  *                  is appended to when loading models and textures
                  * @param resourcesMutex A mutex to prevent multiple threads from writing to resources simultaneously (optional)
+                 * @param attributes Which vertex attributes to load (Optional) - Everything is loaded if this is
+                 *                   nullptr
                  *
                  * @return The converted mesh
                  */
@@ -117,7 +212,8 @@ namespace WS2Common {
                         const glm::mat4 globalTransform,
                         const QDir *parentDir,
                         QVector<Resource::AbstractResource*> *resources = nullptr,
-                        QMutex *resourcesMutex = nullptr
+                        QMutex *resourcesMutex = nullptr,
+                        const MeshRequirements::Attributes *attributes = nullptr
                         );
 
                 /**
@@ -141,6 +237,26 @@ namespace WS2Common {
                         QMutex *resourcesMutex = nullptr
                         );
 
+                /**
+                 * @brief Finds a texture resource for an image file, or creates one if there isn't one yet
+                 *
+                 * If the file doesn't exist, the UV template texture is used instead
+                 *
+                 * If a texture manager is set for resources (See setTextureManager), the texture is found through it
+                 *
+                 * @param filePath The absolute path to the image file
+                 * @param resources A vector of resources (Optional) - Used to prevent creating duplicate resources, and
+                 *                  is appended to if a texture is created
+                 * @param resourcesMutex A mutex to prevent multiple threads from writing to resources simultaneously (optional)
+                 *
+                 * @return The texture
+                 */
+                WS2COMMON_EXPORT WS2Common::Resource::ResourceTexture* getOrCreateTexture(
+                        QString filePath,
+                        QVector<Resource::AbstractResource*> *resources = nullptr,
+                        QMutex *resourcesMutex = nullptr
+                        );
+
                 /**
                  * @brief Gets a resource originating from the given file path
                  *
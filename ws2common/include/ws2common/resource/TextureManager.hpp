@@ -0,0 +1,118 @@
+/**
+ * @file
+ * @brief Header for the TextureManager class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2COMMON_RESOURCE_TEXTUREMANAGER_HPP
+#define SMBLEVELWORKSHOP2_WS2COMMON_RESOURCE_TEXTUREMANAGER_HPP
+
+#include "ws2common_export.h"
+#include "ws2common/resource/ResourceTexture.hpp"
+#include <QVector>
+#include <QHash>
+#include <QString>
+#include <QMutex>
+#include <QImage>
+
+namespace WS2Common {
+    namespace Resource {
+
+        /**
+         * @brief Finds texture resources by file path in constant time, and decodes texture images
+         *
+         * Textures are indexed by their canonical file path, so the same image referred to with different paths (Such
+         * as through a symlink or with "..") only gets one texture resource. Created textures are added to the
+         * resources vector given to the constructor, which owns them as it always has.
+         *
+         * Decoded images can optionally be cached on disk as raw RGBA, so that reopening a scene doesn't have to
+         * decode every PNG/JPEG again.
+         *
+         * This is thread safe.
+         */
+        class WS2COMMON_EXPORT TextureManager {
+            protected:
+                /**
+                 * @brief Bumped whenever the on disk format changes, to invalidate old cache files
+                 */
+                static const quint32 FORMAT_VERSION = 1;
+
+                QVector<AbstractResource*> *resources;
+                QMutex *resourcesMutex;
+
+                /**
+                 * @brief Canonical file path, texture
+                 */
+                QHash<QString, ResourceTexture*> textures;
+                QMutex texturesMutex;
+
+                QString cacheDirectory;
+                mutable QMutex cacheDirectoryMutex;
+
+                QString getCacheFilePath(const QString &filePath, int maxSize) const;
+                bool readCache(const QString &cacheFile, QImage &image) const;
+                void writeCache(const QString &cacheFile, const QImage &image) const;
+
+            public:
+                /**
+                 * @brief Creates a texture manager
+                 *
+                 * @param resources The resources vector to add created textures to, and that owns them (Optional)
+                 * @param resourcesMutex A mutex to prevent multiple threads from writing to resources simultaneously (optional)
+                 */
+                TextureManager(QVector<AbstractResource*> *resources = nullptr, QMutex *resourcesMutex = nullptr);
+
+                /**
+                 * @return The resources vector created textures are added to, or nullptr
+                 */
+                const QVector<AbstractResource*>* getResources() const;
+
+                /**
+                 * @brief Finds the texture for an image file, or creates one if there isn't one yet
+                 *
+                 * @param filePath The path to the image file
+                 *
+                 * @return The texture
+                 */
+                ResourceTexture* getTexture(const QString &filePath);
+
+                /**
+                 * @brief Sets a directory to cache decoded images in
+                 *
+                 * @param cacheDirectory The directory to use (It will be created if it doesn't exist), or an empty
+                 *                       string to disable the cache (The default)
+                 */
+                void setCacheDirectory(const QString &cacheDirectory);
+
+                /**
+                 * @return The decoded image cache directory, or an empty string if the cache is disabled
+                 */
+                QString getCacheDirectory() const;
+
+                /**
+                 * @brief Decodes an image file to RGBA, reading it from and writing it to the cache if one is set
+                 *
+                 * Downscaled previews are decoded straight at the smaller size where the image format supports it
+                 * (Such as JPEG), which is much quicker than decoding the full image and scaling it down afterwards.
+                 *
+                 * @param filePath The path to the image file
+                 * @param maxSize If this is above 0, images bigger than this on either side are scaled down to fit
+                 *                within maxSize x maxSize, keeping their aspect ratio
+                 *
+                 * @return The image in QImage::Format_RGBA8888, or a null image if decoding failed
+                 */
+                QImage decode(const QString &filePath, int maxSize = 0) const;
+
+                /**
+                 * @brief Gets the path a texture is indexed under
+                 *
+                 * @param filePath The path to the image file
+                 *
+                 * @return The canonical path if the file exists, the path as is otherwise (Such as for Qt resources)
+                 */
+                static QString getCanonicalPath(const QString &filePath);
+        };
+    }
+}
+
+#endif
+
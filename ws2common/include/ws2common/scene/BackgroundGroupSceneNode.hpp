@@ -14,6 +14,7 @@ namespace WS2Common {
         class WS2COMMON_EXPORT BackgroundGroupSceneNode : public SceneNode {
             public:
                 BackgroundGroupSceneNode(const QString name);
+                virtual SceneNode* clone() const;
         };
     }
 }
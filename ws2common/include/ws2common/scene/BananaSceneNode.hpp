@@ -26,6 +26,7 @@ namespace WS2Common {
             public:
                 BananaSceneNode() = default;
                 BananaSceneNode(const QString name);
+                virtual SceneNode* clone() const;
 
                 /**
                  * @brief Getter for type
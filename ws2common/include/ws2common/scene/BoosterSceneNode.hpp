@@ -18,6 +18,7 @@ namespace WS2Common {
             public:
                 BoosterSceneNode() = default;
                 BoosterSceneNode(const QString name);
+                virtual SceneNode* clone() const;
         };
     }
 }
@@ -18,6 +18,7 @@ namespace WS2Common {
             public:
                 BumperSceneNode() = default;
                 BumperSceneNode(const QString name);
+                virtual SceneNode* clone() const;
         };
     }
 }
@@ -23,6 +23,7 @@ namespace WS2Common {
             public:
                 CollisionSceneNode() = default;
                 CollisionSceneNode(const QString name);
+                virtual SceneNode* clone() const;
         };
     }
 }
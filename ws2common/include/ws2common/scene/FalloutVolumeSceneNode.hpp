@@ -14,6 +14,7 @@ namespace WS2Common {
         class WS2COMMON_EXPORT FalloutVolumeSceneNode : public SceneNode {
             public:
                 FalloutVolumeSceneNode(const QString name);
+                virtual SceneNode* clone() const;
         };
     }
 }
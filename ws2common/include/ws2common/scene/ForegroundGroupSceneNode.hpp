@@ -14,6 +14,7 @@ namespace WS2Common {
         class WS2COMMON_EXPORT ForegroundGroupSceneNode : public SceneNode {
             public:
                 ForegroundGroupSceneNode(const QString name);
+                virtual SceneNode* clone() const;
         };
     }
 }
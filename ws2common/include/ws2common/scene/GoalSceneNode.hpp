@@ -27,6 +27,7 @@ namespace WS2Common {
             public:
                 GoalSceneNode() = default;
                 GoalSceneNode(const QString name);
+                virtual SceneNode* clone() const;
 
                 /**
                  * @brief Getter for type
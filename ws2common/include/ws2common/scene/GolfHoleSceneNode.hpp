@@ -18,6 +18,7 @@ namespace WS2Common {
             public:
                 GolfHoleSceneNode() = default;
                 GolfHoleSceneNode(const QString name);
+                virtual SceneNode* clone() const;
         };
     }
 }
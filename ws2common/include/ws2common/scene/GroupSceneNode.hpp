@@ -23,6 +23,7 @@ namespace WS2Common {
             public:
                 GroupSceneNode() = default;
                 GroupSceneNode(const QString name);
+                virtual SceneNode* clone() const;
 
                 /**
                  * @brief Setter for collisionGrid
@@ -41,6 +42,8 @@ namespace WS2Common {
                 /**
                  * @brief Getter for collisionGrid
                  *
+                 * As the grid may be changed through the reference returned, this marks the node dirty
+                 *
                  * @return collisionGrid The collision grid this GroupSceneNode has
                  */
                 CollisionGrid& getCollisionGrid();
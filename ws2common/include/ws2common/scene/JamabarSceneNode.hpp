@@ -17,6 +17,7 @@ namespace WS2Common {
             public:
                 JamabarSceneNode() = default;
                 JamabarSceneNode(const QString name);
+                virtual SceneNode* clone() const;
         };
     }
 }
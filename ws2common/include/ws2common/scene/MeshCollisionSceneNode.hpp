@@ -33,6 +33,7 @@ namespace WS2Common {
             public:
                 MeshCollisionSceneNode() = default;
                 MeshCollisionSceneNode(const QString name);
+                virtual SceneNode* clone() const;
 
                 /**
                  * @brief Setter for meshName
@@ -43,6 +43,7 @@ namespace WS2Common {
             public:
                 MeshSceneNode() = default;
                 MeshSceneNode(const QString name);
+                virtual SceneNode* clone() const;
 
                 /**
                  * @brief Setter for meshName
@@ -16,6 +16,7 @@ namespace WS2Common {
             public:
                 RaceTrackPathSceneNode() = default;
                 RaceTrackPathSceneNode(const QString name);
+                virtual SceneNode* clone() const;
 				Animation::RaceTrackPath *getTrackPath() const;
 				void setTrackPath(Animation::RaceTrackPath *value);
 		};
@@ -11,6 +11,7 @@
 #include "ws2common/animation/EffectAnimation.hpp"
 #include "ws2common/EnumAnimationSeesawType.hpp"
 #include "ws2common/Transform.hpp"
+#include "ws2common/UuidGenerator.hpp"
 #include <glm/glm.hpp>
 #include <QVector>
 #include <QXmlStreamWriter>
@@ -32,12 +33,14 @@ namespace WS2Common {
                  *
                  * Guaranteed to be 99.99% unique!
                  *
+                 * Taken from the UuidGenerator current on this thread, if there is one (Such as while parsing a config).
+                 *
                  * @todo Check for collisions... maybe... It would likely be a waste of time tbh
                  */
-                QUuid uuid = QUuid::createUuid();
+                QUuid uuid = UuidGenerator::createUuid();
 
                 QVector<SceneNode*> children;
-                SceneNode *parent;
+                SceneNode *parent = nullptr;
 
                 glm::vec3 originPosition = glm::vec3(0.0f, 0.0f, 0.0f);
                 glm::vec3 originRotation = glm::vec3(0.0f, 0.0f, 0.0f);
@@ -57,7 +60,44 @@ namespace WS2Common {
                 glm::vec2 textureScroll = glm::vec2(0.0f, 0.0f);
                 Animation::EffectAnimation *effectAnimation = nullptr;
 
+                /**
+                 * @brief The revision at which anything serialized for this node last changed
+                 *
+                 * Revisions come from a counter shared by every node, so a node never goes back to a revision it had
+                 * before, and a new node never has the revision of an old one.
+                 */
+                quint64 dataRevision = takeRevision();
+
+                /**
+                 * @brief The revision at which anything serialized for this node or any of its descendants last changed
+                 */
+                quint64 subtreeRevision = dataRevision;
+
+                /**
+                 * @brief The XML written for this node before its children, as of cachedHeadRevision
+                 */
+                mutable QByteArray cachedHeadXml;
+                mutable quint64 cachedHeadRevision = 0;
+
+                /**
+                 * @brief The XML written for this node and its children, as of cachedXmlRevision
+                 */
+                mutable QByteArray cachedXml;
+                mutable quint64 cachedXmlRevision = 0;
+
             protected:
+                /**
+                 * @return A new revision, greater than any handed out before
+                 */
+                static quint64 takeRevision();
+
+                /**
+                 * @brief Marks this node's subtree, and that of every ancestor, as changed
+                 *
+                 * Called when children are added or removed, where this node's own data stays the same.
+                 */
+                void markSubtreeDirty();
+
                 /**
                  * @brief Serializes the data stored in this node to an XML format
                  *
@@ -76,6 +116,17 @@ namespace WS2Common {
                  */
                 virtual const QString getSerializableName() const;
 
+                /**
+                 * @brief Copies everything from other, and deep copies its children, transform animation and effect
+                 *        animation
+                 *
+                 * Use clone() instead of this - this is only used by subclasses' implicit copy constructors.
+                 * Keyframes and track paths are shared with other as nodes don't own them.
+                 *
+                 * @param other The node to copy
+                 */
+                SceneNode(const SceneNode &other);
+
             public:
                 SceneNode() = default;
 
@@ -87,10 +138,22 @@ namespace WS2Common {
                 SceneNode(const QString name);
 
                 /**
-                 * @brief Deletes all children
+                 * @brief Deletes all children, and the transform and effect animations
                  */
                 virtual ~SceneNode();
 
+                /**
+                 * @brief Deep copies this node and all of its children
+                 *
+                 * UUIDs are kept as is, so anything referencing nodes by UUID (Such as wormhole destinations) still
+                 * works in the copy
+                 *
+                 * @note When subclassing SceneNode, you must override this to return a copy of your subclass
+                 *
+                 * @return A new copy of this node with no parent
+                 */
+                virtual SceneNode* clone() const;
+
                 /**
                  * @brief Serializes the data stored in this node to an XML format
                  *
@@ -98,6 +161,45 @@ namespace WS2Common {
                  */
                 void serializeXml(QXmlStreamWriter &stream) const;
 
+                /**
+                 * @brief Serializes this node and its children to XML, reusing the XML of anything that hasn't changed
+                 *        since the last call
+                 *
+                 * Only nodes marked dirty since the last call are serialized again - the XML of every clean subtree is
+                 * spliced in as is, so saving after a small edit takes time in proportion to the edit rather than the
+                 * scene. The result is byte for byte what serializeXml writes to a writer without auto formatting.
+                 *
+                 * Each node keeps the XML of its subtree around, so a scene cached this way takes a few times the size of
+                 * its XML in memory.
+                 *
+                 * @return The XML for this node and its children, valid until this node or any descendant changes
+                 */
+                const QByteArray& serializeXmlCached() const;
+
+                /**
+                 * @brief Marks this node as changed, so that serializeXmlCached serializes it again
+                 *
+                 * The setters call this themselves, as do the non-const getters that hand out something which can be
+                 * changed in place (The transform and animations). Call it after changing a node through anything else
+                 * it handed out, such as the children from getChildren(). Code that only reads a node should use it
+                 * through a const pointer, so it doesn't mark the node dirty.
+                 */
+                void markDirty();
+
+                /**
+                 * @brief Getter for dataRevision
+                 *
+                 * @return The revision at which anything serialized for this node last changed
+                 */
+                quint64 getDataRevision() const;
+
+                /**
+                 * @brief Getter for subtreeRevision
+                 *
+                 * @return The revision at which anything serialized for this node or any of its descendants last changed
+                 */
+                quint64 getSubtreeRevision() const;
+
                 /**
                  * @brief Getter for WS2::Scene::SceneNode::name
                  *
@@ -253,7 +355,9 @@ namespace WS2Common {
                 const Transform& getTransform() const;
 
                 /**
-                 * @brief Const getter for transform
+                 * @brief Non-const getter for transform
+                 *
+                 * As the transform may be changed through the reference returned, this marks the node dirty
                  *
                  * @return The transform of the node relative to its parent
                  */
@@ -326,7 +430,9 @@ namespace WS2Common {
                 void removeTransformAnimation();
 
                 /**
-                 * @brief Getter for animation
+                 * @brief Non-const getter for animation
+                 *
+                 * As the animation may be changed through the pointer returned, this marks the node dirty
                  *
                  * @return A pointer to the animation data if it exists, nullptr otherwise
                  */
@@ -425,7 +531,27 @@ namespace WS2Common {
                  */
                 void setTextureScroll(glm::vec2 textureScroll);
 
-                Animation::EffectAnimation *getEffectAnimation() const;
+                /**
+                 * @brief Non-const getter for effectAnimation
+                 *
+                 * As the animation may be changed through the pointer returned, this marks the node dirty
+                 *
+                 * @return A pointer to the effect animation data if it exists, nullptr otherwise
+                 */
+                Animation::EffectAnimation* getEffectAnimation();
+
+                /**
+                 * @brief Const getter for effectAnimation
+                 *
+                 * @return A pointer to the effect animation data if it exists, nullptr otherwise
+                 */
+                const Animation::EffectAnimation* getEffectAnimation() const;
+
+                /**
+                 * @brief Setter for effectAnimation
+                 *
+                 * @param value The effect animation data - the node takes ownership of it
+                 */
                 void setEffectAnimation(Animation::EffectAnimation *value);
         };
     }
@@ -19,6 +19,7 @@ namespace WS2Common {
             public:
                 SphereCollisionObjectSceneNode() = default;
                 SphereCollisionObjectSceneNode(const QString name);
+                virtual SceneNode* clone() const;
                 float getRadius() const;
                 void setRadius(float radius);
         };
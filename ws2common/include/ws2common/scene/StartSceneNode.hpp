@@ -19,6 +19,7 @@ namespace WS2Common {
             public:
                 StartSceneNode() = default;
                 StartSceneNode(const QString name);
+                virtual SceneNode* clone() const;
                 unsigned int getPlayerID() const;
                 void setPlayerID(unsigned int value);
         };
@@ -25,6 +25,7 @@ namespace WS2Common {
             public:
                 WormholeSceneNode() = default;
                 WormholeSceneNode(const QString name);
+                virtual SceneNode* clone() const;
 
                 /**
                  * @brief Const getter for destinationUuid
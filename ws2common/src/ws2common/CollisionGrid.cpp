@@ -1,5 +1,6 @@
 #include "ws2common/CollisionGrid.hpp"
 #include "ws2common/SerializeUtils.hpp"
+#include "ws2common/EnumXMLTag.hpp"
 #include <QDebug>
 
 namespace WS2Common {
@@ -36,16 +37,17 @@ namespace WS2Common {
     CollisionGrid CollisionGrid::deserializeDataXml(QXmlStreamReader &xml){
         CollisionGrid grid;
 
-        while (!(xml.isEndElement() && xml.name() == "collisionGrid")) {
+        while (!(xml.isEndElement() && xml.name() == QLatin1String("collisionGrid"))) {
             xml.readNext();
             if (!xml.isStartElement()) continue; //Ignore all end elements
 
-            if (xml.name() == "start") {
-                grid.setGridStart(SerializeUtils::getVec2Attributes(xml.attributes(), "x", "z"));
-            } else if (xml.name() == "step") {
-                grid.setGridStep(SerializeUtils::getVec2Attributes(xml.attributes(), "x", "z"));
-            } else if (xml.name() == "count") {
-                grid.setGridStepCount(SerializeUtils::getUVec2Attributes(xml.attributes(), "x", "z"));
+            EnumXMLTag tag = XMLTag::fromName(xml.name());
+            if (tag == EnumXMLTag::START) {
+                grid.setGridStart(SerializeUtils::getVec2Attributes(xml.attributes(), QLatin1String("x"), QLatin1String("z")));
+            } else if (tag == EnumXMLTag::STEP) {
+                grid.setGridStep(SerializeUtils::getVec2Attributes(xml.attributes(), QLatin1String("x"), QLatin1String("z")));
+            } else if (tag == EnumXMLTag::COUNT) {
+                grid.setGridStepCount(SerializeUtils::getUVec2Attributes(xml.attributes(), QLatin1String("x"), QLatin1String("z")));
             } else {
                 qWarning().noquote() << "Unrecognised tag: collisionGrid >" << xml.name();
             }
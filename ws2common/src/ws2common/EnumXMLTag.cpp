@@ -0,0 +1,199 @@
+#include "ws2common/EnumXMLTag.hpp"
+#include <QLatin1String>
+
+namespace WS2Common {
+    namespace XMLTag {
+        namespace {
+            struct TagName {
+                const char *name;
+                EnumXMLTag tag;
+            };
+
+            const TagName TAG_NAMES[] = {
+                {"animationGroupId", EnumXMLTag::ANIMATION_GROUP_ID},
+                {"animationSeesawType", EnumXMLTag::ANIMATION_SEESAW_TYPE},
+                {"animGroupId", EnumXMLTag::ANIM_GROUP_ID},
+                {"animInitialState", EnumXMLTag::ANIM_INITIAL_STATE},
+                {"animKeyframes", EnumXMLTag::ANIM_KEYFRAMES},
+                {"animLoopTime", EnumXMLTag::ANIM_LOOP_TIME},
+                {"animSeesawType", EnumXMLTag::ANIM_SEESAW_TYPE},
+                {"backgroundModel", EnumXMLTag::BACKGROUND_MODEL},
+                {"banana", EnumXMLTag::BANANA},
+                {"bitflag", EnumXMLTag::BITFLAG},
+                {"blue", EnumXMLTag::BLUE},
+                {"booster", EnumXMLTag::BOOSTER},
+                {"bumper", EnumXMLTag::BUMPER},
+                {"castShadow", EnumXMLTag::CAST_SHADOW},
+                {"collision", EnumXMLTag::COLLISION},
+                {"collisionFlag", EnumXMLTag::COLLISION_FLAG},
+                {"collisionGrid", EnumXMLTag::COLLISION_GRID},
+                {"cone", EnumXMLTag::CONE},
+                {"conveyorSpeed", EnumXMLTag::CONVEYOR_SPEED},
+                {"count", EnumXMLTag::COUNT},
+                {"cylinder", EnumXMLTag::CYLINDER},
+                {"destinationName", EnumXMLTag::DESTINATION_NAME},
+                {"destinationUuid", EnumXMLTag::DESTINATION_UUID},
+                {"easing", EnumXMLTag::EASING},
+                {"effectKeyframes", EnumXMLTag::EFFECT_KEYFRAMES},
+                {"effectType1", EnumXMLTag::EFFECT_TYPE1},
+                {"effectType2", EnumXMLTag::EFFECT_TYPE2},
+                {"end", EnumXMLTag::END},
+                {"falloutPlane", EnumXMLTag::FALLOUT_PLANE},
+                {"falloutVolume", EnumXMLTag::FALLOUT_VOLUME},
+                {"fog", EnumXMLTag::FOG},
+                {"fogAnimationKeyframes", EnumXMLTag::FOG_ANIMATION_KEYFRAMES},
+                {"foregroundModel", EnumXMLTag::FOREGROUND_MODEL},
+                {"goal", EnumXMLTag::GOAL},
+                {"golfHole", EnumXMLTag::GOLF_HOLE},
+                {"green", EnumXMLTag::GREEN},
+                {"handleA", EnumXMLTag::HANDLE_A},
+                {"handleB", EnumXMLTag::HANDLE_B},
+                {"height", EnumXMLTag::HEIGHT},
+                {"initialRotation", EnumXMLTag::INITIAL_ROTATION},
+                {"itemGroup", EnumXMLTag::ITEM_GROUP},
+                {"jamabar", EnumXMLTag::JAMABAR},
+                {"keyframe", EnumXMLTag::KEYFRAME},
+                {"levelModel", EnumXMLTag::LEVEL_MODEL},
+                {"meshCollision", EnumXMLTag::MESH_COLLISION},
+                {"meshName", EnumXMLTag::MESH_NAME},
+                {"meshType", EnumXMLTag::MESH_TYPE},
+                {"modelImport", EnumXMLTag::MODEL_IMPORT},
+                {"name", EnumXMLTag::NAME},
+                {"originPosition", EnumXMLTag::ORIGIN_POSITION},
+                {"originRotation", EnumXMLTag::ORIGIN_ROTATION},
+                {"playerID", EnumXMLTag::PLAYER_ID},
+                {"position", EnumXMLTag::POSITION},
+                {"posX", EnumXMLTag::POS_X},
+                {"posY", EnumXMLTag::POS_Y},
+                {"posZ", EnumXMLTag::POS_Z},
+                {"radius", EnumXMLTag::RADIUS},
+                {"red", EnumXMLTag::RED},
+                {"rotation", EnumXMLTag::ROTATION},
+                {"rotationCenter", EnumXMLTag::ROTATION_CENTER},
+                {"rotX", EnumXMLTag::ROT_X},
+                {"rotY", EnumXMLTag::ROT_Y},
+                {"rotZ", EnumXMLTag::ROT_Z},
+                {"runtimeReflective", EnumXMLTag::RUNTIME_REFLECTIVE},
+                {"scale", EnumXMLTag::SCALE},
+                {"scaleX", EnumXMLTag::SCALE_X},
+                {"scaleY", EnumXMLTag::SCALE_Y},
+                {"scaleZ", EnumXMLTag::SCALE_Z},
+                {"seesawFriction", EnumXMLTag::SEESAW_FRICTION},
+                {"seesawResetStiffness", EnumXMLTag::SEESAW_RESET_STIFFNESS},
+                {"seesawRotationBounds", EnumXMLTag::SEESAW_ROTATION_BOUNDS},
+                {"seesawSensitivity", EnumXMLTag::SEESAW_SENSITIVITY},
+                {"seesawSpring", EnumXMLTag::SEESAW_SPRING},
+                {"sphere", EnumXMLTag::SPHERE},
+                {"stageModel", EnumXMLTag::STAGE_MODEL},
+                {"stageType", EnumXMLTag::STAGE_TYPE},
+                {"start", EnumXMLTag::START},
+                {"step", EnumXMLTag::STEP},
+                {"superMonkeyBallStage", EnumXMLTag::SUPER_MONKEY_BALL_STAGE},
+                {"switch", EnumXMLTag::SWITCH},
+                {"textureScroll", EnumXMLTag::TEXTURE_SCROLL},
+                {"time", EnumXMLTag::TIME},
+                {"trackPath", EnumXMLTag::TRACK_PATH},
+                {"transformAnimation", EnumXMLTag::TRANSFORM_ANIMATION},
+                {"type", EnumXMLTag::TYPE},
+                {"unknown", EnumXMLTag::UNKNOWN},
+                {"unknown1", EnumXMLTag::UNKNOWN1},
+                {"unknown2", EnumXMLTag::UNKNOWN2},
+                {"unknownByte1", EnumXMLTag::UNKNOWN_BYTE1},
+                {"unknownByte2", EnumXMLTag::UNKNOWN_BYTE2},
+                {"unknownByte3", EnumXMLTag::UNKNOWN_BYTE3},
+                {"unknownByte4", EnumXMLTag::UNKNOWN_BYTE4},
+                {"uuid", EnumXMLTag::UUID},
+                {"value", EnumXMLTag::VALUE},
+                {"wormhole", EnumXMLTag::WORMHOLE},
+                {"node-bananaSceneNode", EnumXMLTag::NODE_BANANA_SCENE_NODE},
+                {"node-bumperSceneNode", EnumXMLTag::NODE_BUMPER_SCENE_NODE},
+                {"node-goalSceneNode", EnumXMLTag::NODE_GOAL_SCENE_NODE},
+                {"node-groupSceneNode", EnumXMLTag::NODE_GROUP_SCENE_NODE},
+                {"node-jamabarSceneNode", EnumXMLTag::NODE_JAMABAR_SCENE_NODE},
+                {"node-meshCollisionSceneNode", EnumXMLTag::NODE_MESH_COLLISION_SCENE_NODE},
+                {"node-meshSceneNode", EnumXMLTag::NODE_MESH_SCENE_NODE},
+                {"node-sceneNode", EnumXMLTag::NODE_SCENE_NODE},
+                {"node-startSceneNode", EnumXMLTag::NODE_START_SCENE_NODE},
+                {"node-wormholeSceneNode", EnumXMLTag::NODE_WORMHOLE_SCENE_NODE},
+                {"data-bananaSceneNode", EnumXMLTag::DATA_BANANA_SCENE_NODE},
+                {"data-collisionSceneNode", EnumXMLTag::DATA_COLLISION_SCENE_NODE},
+                {"data-goalSceneNode", EnumXMLTag::DATA_GOAL_SCENE_NODE},
+                {"data-groupSceneNode", EnumXMLTag::DATA_GROUP_SCENE_NODE},
+                {"data-meshCollisionSceneNode", EnumXMLTag::DATA_MESH_COLLISION_SCENE_NODE},
+                {"data-meshSceneNode", EnumXMLTag::DATA_MESH_SCENE_NODE},
+                {"data-sceneNode", EnumXMLTag::DATA_SCENE_NODE},
+                {"data-wormholeSceneNode", EnumXMLTag::DATA_WORMHOLE_SCENE_NODE},
+                {"children", EnumXMLTag::CHILDREN},
+                {"data", EnumXMLTag::DATA},
+            };
+
+            const int TAG_COUNT = sizeof(TAG_NAMES) / sizeof(TagName);
+
+            /**
+             * @brief FNV-1a over UTF-16 code units, so names hash the same whatever Qt version or CPU is in use
+             */
+            quint32 hashName(const QChar *data, int length) {
+                quint32 hash = 2166136261u;
+                for (int i = 0; i < length; i++) {
+                    hash ^= data[i].unicode();
+                    hash *= 16777619u;
+                }
+
+                return hash;
+            }
+
+            /**
+             * @brief An open addressing hash table from element names to tags, built once on first use
+             */
+            class TagTable {
+                protected:
+                    //Over 4 times the number of tags, so most lookups land on the right slot first time
+                    static const int SLOT_COUNT = 1024;
+                    static const int EMPTY_SLOT = -1;
+
+                    struct Slot {
+                        quint32 hash;
+                        int index;
+                    };
+
+                    Slot slots[SLOT_COUNT];
+
+                public:
+                    TagTable() {
+                        static_assert(SLOT_COUNT > TAG_COUNT * 4, "Too many XML tags for the tag table");
+
+                        for (int i = 0; i < SLOT_COUNT; i++) slots[i].index = EMPTY_SLOT;
+
+                        for (int i = 0; i < TAG_COUNT; i++) {
+                            QString name = QLatin1String(TAG_NAMES[i].name);
+                            quint32 hash = hashName(name.constData(), name.size());
+
+                            int slot = hash & (SLOT_COUNT - 1);
+                            while (slots[slot].index != EMPTY_SLOT) slot = (slot + 1) & (SLOT_COUNT - 1);
+
+                            slots[slot].hash = hash;
+                            slots[slot].index = i;
+                        }
+                    }
+
+                    EnumXMLTag find(const QStringRef &name) const {
+                        quint32 hash = hashName(name.constData(), name.size());
+
+                        for (int slot = hash & (SLOT_COUNT - 1); slots[slot].index != EMPTY_SLOT; slot = (slot + 1) & (SLOT_COUNT - 1)) {
+                            const TagName &tagName = TAG_NAMES[slots[slot].index];
+                            if (slots[slot].hash == hash && name == QLatin1String(tagName.name)) return tagName.tag;
+                        }
+
+                        return EnumXMLTag::UNRECOGNISED;
+                    }
+            };
+        }
+
+        EnumXMLTag fromName(const QStringRef &name) {
+            //Function local statics are initialized exactly once, even with multiple threads parsing at once
+            static const TagTable table;
+            return table.find(name);
+        }
+    }
+}
+
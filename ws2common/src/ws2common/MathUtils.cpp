@@ -18,11 +18,12 @@ namespace WS2Common {
         }
 
         glm::mat4 toGlmMat4(const aiMatrix4x4 &mat) {
+            //Assimp matrices are row major (a1..a4 is the first row), while glm takes one column at a time
             return glm::mat4(
-                    mat.a1, mat.a2, mat.a3, mat.a4,
-                    mat.b1, mat.b2, mat.b3, mat.b4,
-                    mat.c1, mat.c2, mat.c3, mat.c4,
-                    mat.d1, mat.d2, mat.d3, mat.d4
+                    mat.a1, mat.b1, mat.c1, mat.d1,
+                    mat.a2, mat.b2, mat.c2, mat.d2,
+                    mat.a3, mat.b3, mat.c3, mat.d3,
+                    mat.a4, mat.b4, mat.c4, mat.d4
                     );
         }
 
@@ -0,0 +1,41 @@
+#include "ws2common/MemoryArena.hpp"
+#include <QtGlobal>
+
+namespace WS2Common {
+    MemoryArena::MemoryArena(size_t blockSize) :
+        blockSize(blockSize) {}
+
+    MemoryArena::~MemoryArena() {
+        foreach(char *block, blocks) delete[] block;
+    }
+
+    void* MemoryArena::allocate(size_t size, size_t alignment) {
+        size_t padding = (alignment - (reinterpret_cast<quintptr>(current) & (alignment - 1))) & (alignment - 1);
+
+        if (current == nullptr || padding + size > remaining) {
+            //Start a new block - whatever is left of the old one goes unused
+            size_t newBlockSize = qMax(blockSize, size + alignment);
+            current = new char[newBlockSize];
+            remaining = newBlockSize;
+            blocks.append(current);
+
+            padding = (alignment - (reinterpret_cast<quintptr>(current) & (alignment - 1))) & (alignment - 1);
+        }
+
+        void *ptr = current + padding;
+        current += padding + size;
+        remaining -= padding + size;
+        bytesAllocated += size;
+
+        return ptr;
+    }
+
+    size_t MemoryArena::getBytesAllocated() const {
+        return bytesAllocated;
+    }
+
+    int MemoryArena::getBlockCount() const {
+        return blocks.size();
+    }
+}
+
@@ -5,6 +5,11 @@ namespace WS2Common {
     //Namespace variable defines
     bool enableDebugLogging = false;
 
+    /**
+     * @brief The prefix made current on this thread by a MessagePrefixScope, if any
+     */
+    static thread_local QString currentPrefix;
+
     /**
      * @brief Custom message handler for logging - Install it with qInstallMessageHandler(messageHandler)
      *
@@ -15,7 +20,7 @@ namespace WS2Common {
     void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
         Q_UNUSED(context);
 
-        QByteArray localMsg = msg.toLocal8Bit();
+        QByteArray localMsg = currentPrefix.isEmpty() ? msg.toLocal8Bit() : (currentPrefix + msg).toLocal8Bit();
 
         //Only print with ANSI escape codes on UNIX systems - not the best solution, but it should suffice for most of the time
 
@@ -53,6 +58,19 @@ namespace WS2Common {
     void setDebugLoggingEnabled(bool enable) {
         enableDebugLogging = enable;
     }
+
+    MessagePrefixScope::MessagePrefixScope(const QString &prefix) :
+        previous(currentPrefix) {
+        currentPrefix = prefix;
+    }
+
+    MessagePrefixScope::~MessagePrefixScope() {
+        currentPrefix = previous;
+    }
+
+    QString MessagePrefixScope::getCurrentPrefix() {
+        return currentPrefix;
+    }
 }
 
 QDebug operator<<(QDebug debug, const glm::vec3 &vec) {
@@ -0,0 +1,180 @@
+#include "ws2common/Profiler.hpp"
+#include <QThread>
+#include <QMutexLocker>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+namespace WS2Common {
+    Profiler::Scope::Scope(Profiler *profiler, const QString &name, const QString &category) :
+        profiler(profiler) {
+        if (profiler == nullptr) return;
+
+        this->name = name;
+        this->category = category;
+        startThreadCpuNs = getThreadCpuTimeNs();
+        startProcessCpuNs = getProcessCpuTimeNs();
+        startNs = profiler->getElapsedNs();
+    }
+
+    Profiler::Scope::~Scope() {
+        if (profiler == nullptr) return;
+
+        Entry entry;
+        entry.name = name;
+        entry.category = category;
+        entry.startNs = startNs;
+        entry.wallNs = profiler->getElapsedNs() - startNs;
+        entry.threadCpuNs = getThreadCpuTimeNs() - startThreadCpuNs;
+        entry.processCpuNs = getProcessCpuTimeNs() - startProcessCpuNs;
+        entry.peakMemoryBytes = getPeakMemoryBytes();
+
+        profiler->addEntry(entry);
+    }
+
+    Profiler::Profiler() {
+        timer.start();
+        threadIndices[QThread::currentThreadId()] = 0;
+    }
+
+    void Profiler::addEntry(Entry entry) {
+        QMutexLocker locker(&mutex);
+
+        Qt::HANDLE threadId = QThread::currentThreadId();
+        if (!threadIndices.contains(threadId)) threadIndices[threadId] = threadIndices.size();
+        entry.threadIndex = threadIndices.value(threadId);
+
+        entries.append(entry);
+    }
+
+    QVector<Profiler::Entry> Profiler::getEntries() {
+        QMutexLocker locker(&mutex);
+        return entries;
+    }
+
+    void Profiler::clear() {
+        QMutexLocker locker(&mutex);
+        entries.clear();
+    }
+
+    qint64 Profiler::getElapsedNs() const {
+        return timer.nsecsElapsed();
+    }
+
+    QByteArray Profiler::toJson(EnumOutputFormat format) {
+        QVector<Entry> entries = getEntries();
+        QJsonObject root;
+
+        if (format == EnumOutputFormat::TRACE_EVENT) {
+            //Chrome trace event format - complete events ("ph": "X") with timestamps in microseconds
+            QJsonArray events;
+
+            foreach(const Entry &entry, entries) {
+                QJsonObject args;
+                args["threadCpuMs"] = entry.threadCpuNs / 1000000.0;
+                args["processCpuMs"] = entry.processCpuNs / 1000000.0;
+                args["peakMemoryBytes"] = entry.peakMemoryBytes;
+
+                QJsonObject event;
+                event["name"] = entry.name;
+                event["cat"] = entry.category;
+                event["ph"] = "X";
+                event["ts"] = entry.startNs / 1000.0;
+                event["dur"] = entry.wallNs / 1000.0;
+                event["pid"] = 0;
+                event["tid"] = entry.threadIndex;
+                event["args"] = args;
+
+                events.append(event);
+            }
+
+            root["traceEvents"] = events;
+            root["displayTimeUnit"] = "ms";
+        } else {
+            QJsonArray stages;
+
+            foreach(const Entry &entry, entries) {
+                QJsonObject stage;
+                stage["name"] = entry.name;
+                stage["category"] = entry.category;
+                stage["thread"] = entry.threadIndex;
+                stage["startMs"] = entry.startNs / 1000000.0;
+                stage["wallMs"] = entry.wallNs / 1000000.0;
+                stage["threadCpuMs"] = entry.threadCpuNs / 1000000.0;
+                stage["processCpuMs"] = entry.processCpuNs / 1000000.0;
+                stage["peakMemoryBytes"] = entry.peakMemoryBytes;
+
+                stages.append(stage);
+            }
+
+            root["stages"] = stages;
+            root["totalWallMs"] = getElapsedNs() / 1000000.0;
+            root["peakMemoryBytes"] = getPeakMemoryBytes();
+        }
+
+        return QJsonDocument(root).toJson(QJsonDocument::Indented);
+    }
+
+    qint64 Profiler::getThreadCpuTimeNs() {
+#if defined(Q_OS_WIN)
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) return 0;
+
+        //FILETIMEs are in 100ns units
+        quint64 kernel = (quint64(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime;
+        quint64 user = (quint64(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime;
+        return qint64(kernel + user) * 100;
+#elif defined(Q_OS_UNIX) && defined(CLOCK_THREAD_CPUTIME_ID)
+        struct timespec ts;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0;
+        return qint64(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#else
+        return 0;
+#endif
+    }
+
+    qint64 Profiler::getProcessCpuTimeNs() {
+#if defined(Q_OS_WIN)
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) return 0;
+
+        quint64 kernel = (quint64(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime;
+        quint64 user = (quint64(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime;
+        return qint64(kernel + user) * 100;
+#elif defined(Q_OS_UNIX)
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+        return (qint64(usage.ru_utime.tv_sec) + usage.ru_stime.tv_sec) * 1000000000 +
+            (qint64(usage.ru_utime.tv_usec) + usage.ru_stime.tv_usec) * 1000;
+#else
+        return 0;
+#endif
+    }
+
+    qint64 Profiler::getPeakMemoryBytes() {
+#if defined(Q_OS_WIN)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+        return qint64(counters.PeakWorkingSetSize);
+#elif defined(Q_OS_UNIX)
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef Q_OS_MACOS
+        return qint64(usage.ru_maxrss); //Bytes on macOS
+#else
+        return qint64(usage.ru_maxrss) * 1024; //Kilobytes on Linux
+#endif
+#else
+        return 0;
+#endif
+    }
+}
+
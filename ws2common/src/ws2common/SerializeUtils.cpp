@@ -1,4 +1,5 @@
 #include "ws2common/SerializeUtils.hpp"
+#include "ws2common/EnumXMLTag.hpp"
 #include <QDebug>
 
 namespace WS2Common {
@@ -6,52 +7,53 @@ namespace WS2Common {
         using namespace WS2Common::Scene;
 
         SceneNode* deserializeNodeFromXml(QXmlStreamReader &xml, SceneNode *parent) {
-            if (xml.name() == "node-sceneNode") {
+            EnumXMLTag tag = XMLTag::fromName(xml.name());
+            if (tag == EnumXMLTag::NODE_SCENE_NODE) {
                 SceneNode *node = new SceneNode();
                 parseSceneNode(xml, node);
                 if (parent != nullptr) parent->addChild(node);
                 return node;
-            } else if (xml.name() == "node-startSceneNode") {
+            } else if (tag == EnumXMLTag::NODE_START_SCENE_NODE) {
                 StartSceneNode *node = new StartSceneNode();
                 parseStartSceneNode(xml, node);
                 if (parent != nullptr) parent->addChild(node);
                 return node;
-            } else if (xml.name() == "node-meshSceneNode") {
+            } else if (tag == EnumXMLTag::NODE_MESH_SCENE_NODE) {
                 MeshSceneNode *node = new MeshSceneNode();
                 parseMeshSceneNode(xml, node);
                 if (parent != nullptr) parent->addChild(node);
                 return node;
-            } else if (xml.name() == "node-meshCollisionSceneNode") {
+            } else if (tag == EnumXMLTag::NODE_MESH_COLLISION_SCENE_NODE) {
                 MeshCollisionSceneNode *node = new MeshCollisionSceneNode();
                 parseMeshCollisionSceneNode(xml, node);
                 if (parent != nullptr) parent->addChild(node);
                 return node;
-            } else if (xml.name() == "node-groupSceneNode") {
+            } else if (tag == EnumXMLTag::NODE_GROUP_SCENE_NODE) {
                 GroupSceneNode *node = new GroupSceneNode();
                 parseGroupSceneNode(xml, node);
                 if (parent != nullptr) parent->addChild(node);
                 return node;
-            } else if (xml.name() == "node-goalSceneNode") {
+            } else if (tag == EnumXMLTag::NODE_GOAL_SCENE_NODE) {
                 GoalSceneNode *node = new GoalSceneNode();
                 parseGoalSceneNode(xml, node);
                 if (parent != nullptr) parent->addChild(node);
                 return node;
-            } else if (xml.name() == "node-bumperSceneNode") {
+            } else if (tag == EnumXMLTag::NODE_BUMPER_SCENE_NODE) {
                 BumperSceneNode *node = new BumperSceneNode();
                 parseBumperSceneNode(xml, node);
                 if (parent != nullptr) parent->addChild(node);
                 return node;
-            } else if (xml.name() == "node-bananaSceneNode") {
+            } else if (tag == EnumXMLTag::NODE_BANANA_SCENE_NODE) {
                 BananaSceneNode *node = new BananaSceneNode();
                 parseBananaSceneNode(xml, node);
                 if (parent != nullptr) parent->addChild(node);
                 return node;
-            } else if (xml.name() == "node-jamabarSceneNode") {
+            } else if (tag == EnumXMLTag::NODE_JAMABAR_SCENE_NODE) {
                 JamabarSceneNode *node = new JamabarSceneNode();
                 parseJamabarSceneNode(xml, node);
                 if (parent != nullptr) parent->addChild(node);
                 return node;
-            } else if (xml.name() == "node-wormholeSceneNode") {
+            } else if (tag == EnumXMLTag::NODE_WORMHOLE_SCENE_NODE) {
                 WormholeSceneNode *node = new WormholeSceneNode();
                 parseWormholeSceneNode(xml, node);
                 if (parent != nullptr) parent->addChild(node);
@@ -62,23 +64,25 @@ namespace WS2Common {
         }
 
         void parseSceneNode(QXmlStreamReader &xml, SceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "node-sceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("node-sceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "data") {
-                    while (!(xml.isEndElement() && xml.name() == "data")) {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::DATA) {
+                    while (!(xml.isEndElement() && xml.name() == QLatin1String("data"))) {
                         xml.readNext();
                         if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                        if (xml.name() == "data-sceneNode") {
+                        EnumXMLTag dataTag = XMLTag::fromName(xml.name());
+                        if (dataTag == EnumXMLTag::DATA_SCENE_NODE) {
                             parseSceneNodeData(xml, node);
                         } else {
                             qWarning().noquote() << "Unrecognised tag: data > " + xml.name();
                         }
                     }
 
-                } else if (xml.name() == "children") {
+                } else if (tag == EnumXMLTag::CHILDREN) {
                     parseChildren(xml, node);
                 } else {
                     qWarning().noquote() << "Unrecognised tag: node-sceneNode > " + xml.name();
@@ -87,38 +91,39 @@ namespace WS2Common {
         }
 
         void parseSceneNodeData(QXmlStreamReader &xml, SceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "data-sceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("data-sceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     node->setName(xml.readElementText());
-                } else if (xml.name() == "uuid") {
+                } else if (tag == EnumXMLTag::UUID) {
                     node->setUuid(QUuid(xml.readElementText()));
-                } else if (xml.name() == "originPosition") {
+                } else if (tag == EnumXMLTag::ORIGIN_POSITION) {
                     node->setOriginPosition(getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "originRotation") {
+                } else if (tag == EnumXMLTag::ORIGIN_ROTATION) {
                     node->setOriginRotation(getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     node->setPosition(getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     node->setRotation(getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "scale") {
+                } else if (tag == EnumXMLTag::SCALE) {
                     node->setScale(getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "conveyorSpeed") {
+                } else if (tag == EnumXMLTag::CONVEYOR_SPEED) {
                     node->setConveyorSpeed(getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "transformAnimation") {
+                } else if (tag == EnumXMLTag::TRANSFORM_ANIMATION) {
                     qWarning() << "data-sceneNode > transformAnimation not yet implemented!"; //TODO
-                } else if (xml.name() == "animationGroupId") {
+                } else if (tag == EnumXMLTag::ANIMATION_GROUP_ID) {
                     node->setAnimationGroupId(xml.readElementText().toUInt());
-                } else if (xml.name() == "animationSeesawType") {
+                } else if (tag == EnumXMLTag::ANIMATION_SEESAW_TYPE) {
                     node->setAnimationSeesawType(AnimationSeesawType::fromString(xml.readElementText()));
-                } else if (xml.name() == "seesawSensitivity") {
-                    node->setSeesawSensitivity(xml.readElementText().toFloat());
-                } else if (xml.name() == "seesawResetStiffness") {
-                    node->setSeesawFriction(xml.readElementText().toFloat());
-                } else if (xml.name() == "seesawRotationBounds") {
-                    node->setSeesawSpring(xml.readElementText().toFloat());
+                } else if (tag == EnumXMLTag::SEESAW_SENSITIVITY) {
+                    node->setSeesawSensitivity(parseFloat(xml.readElementText()));
+                } else if (tag == EnumXMLTag::SEESAW_RESET_STIFFNESS) {
+                    node->setSeesawFriction(parseFloat(xml.readElementText()));
+                } else if (tag == EnumXMLTag::SEESAW_ROTATION_BOUNDS) {
+                    node->setSeesawSpring(parseFloat(xml.readElementText()));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: data-sceneNode > " + xml.name();
                 }
@@ -126,23 +131,25 @@ namespace WS2Common {
         }
 
         void parseStartSceneNode(QXmlStreamReader &xml, StartSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "node-startSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("node-startSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "data") {
-                    while (!(xml.isEndElement() && xml.name() == "data")) {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::DATA) {
+                    while (!(xml.isEndElement() && xml.name() == QLatin1String("data"))) {
                         xml.readNext();
                         if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                        if (xml.name() == "data-sceneNode") {
+                        EnumXMLTag dataTag = XMLTag::fromName(xml.name());
+                        if (dataTag == EnumXMLTag::DATA_SCENE_NODE) {
                             parseSceneNodeData(xml, node);
                         } else {
                             qWarning().noquote() << "Unrecognised tag: data > " + xml.name();
                         }
                     }
 
-                } else if (xml.name() == "children") {
+                } else if (tag == EnumXMLTag::CHILDREN) {
                     parseChildren(xml, node);
                 } else {
                     qWarning().noquote() << "Unrecognised tag: node-startSceneNode > " + xml.name();
@@ -151,25 +158,27 @@ namespace WS2Common {
         }
 
         void parseMeshSceneNode(QXmlStreamReader &xml, MeshSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "node-meshSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("node-meshSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "data") {
-                    while (!(xml.isEndElement() && xml.name() == "data")) {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::DATA) {
+                    while (!(xml.isEndElement() && xml.name() == QLatin1String("data"))) {
                         xml.readNext();
                         if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                        if (xml.name() == "data-sceneNode") {
+                        EnumXMLTag dataTag = XMLTag::fromName(xml.name());
+                        if (dataTag == EnumXMLTag::DATA_SCENE_NODE) {
                             parseSceneNodeData(xml, node);
-                        } else if (xml.name() == "data-meshSceneNode") {
+                        } else if (dataTag == EnumXMLTag::DATA_MESH_SCENE_NODE) {
                             parseMeshSceneNodeData(xml, node);
                         } else {
                             qWarning().noquote() << "Unrecognised tag: data > " + xml.name();
                         }
                     }
 
-                } else if (xml.name() == "children") {
+                } else if (tag == EnumXMLTag::CHILDREN) {
                     parseChildren(xml, node);
                 } else {
                     qWarning().noquote() << "Unrecognised tag: node-meshSceneNode > " + xml.name();
@@ -178,13 +187,14 @@ namespace WS2Common {
         }
 
         void parseMeshSceneNodeData(QXmlStreamReader &xml, MeshSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "data-meshSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("data-meshSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "meshName") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::MESH_NAME) {
                     node->setMeshName(xml.readElementText());
-                } else if (xml.name() == "runtimeReflective") {
+                } else if (tag == EnumXMLTag::RUNTIME_REFLECTIVE) {
                     node->setRuntimeReflective(xml.readElementText() == "true");
                 } else {
                     qWarning().noquote() << "Unrecognised tag: data-meshSceneNode > " + xml.name();
@@ -193,27 +203,29 @@ namespace WS2Common {
         }
 
         void parseMeshCollisionSceneNode(QXmlStreamReader &xml, MeshCollisionSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "node-meshCollisionSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("node-meshCollisionSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "data") {
-                    while (!(xml.isEndElement() && xml.name() == "data")) {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::DATA) {
+                    while (!(xml.isEndElement() && xml.name() == QLatin1String("data"))) {
                         xml.readNext();
                         if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                        if (xml.name() == "data-sceneNode") {
+                        EnumXMLTag dataTag = XMLTag::fromName(xml.name());
+                        if (dataTag == EnumXMLTag::DATA_SCENE_NODE) {
                             parseSceneNodeData(xml, node);
-                        } else if (xml.name() == "data-collisionSceneNode") {
+                        } else if (dataTag == EnumXMLTag::DATA_COLLISION_SCENE_NODE) {
                             parseCollisionSceneNodeData(xml, node);
-                        } else if (xml.name() == "data-meshCollisionSceneNode") {
+                        } else if (dataTag == EnumXMLTag::DATA_MESH_COLLISION_SCENE_NODE) {
                             parseMeshCollisionSceneNodeData(xml, node);
                         } else {
                             qWarning().noquote() << "Unrecognised tag: data > " + xml.name();
                         }
                     }
 
-                } else if (xml.name() == "children") {
+                } else if (tag == EnumXMLTag::CHILDREN) {
                     parseChildren(xml, node);
                 } else {
                     qWarning().noquote() << "Unrecognised tag: node-meshCollisionSceneNode > " + xml.name();
@@ -222,11 +234,12 @@ namespace WS2Common {
         }
 
         void parseMeshCollisionSceneNodeData(QXmlStreamReader &xml, MeshCollisionSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "data-meshCollisionSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("data-meshCollisionSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "meshName") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::MESH_NAME) {
                     node->setMeshName(xml.readElementText());
                 } else {
                     qWarning().noquote() << "Unrecognised tag: data-meshCollisionSceneNode > " + xml.name();
@@ -238,7 +251,7 @@ namespace WS2Common {
             //There's nothing to parse! (yet?)
             Q_UNUSED(node);
 
-            while (!(xml.isEndElement() && xml.name() == "data-collisionSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("data-collisionSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
@@ -251,25 +264,27 @@ namespace WS2Common {
         }
 
         void parseGroupSceneNode(QXmlStreamReader &xml, GroupSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "node-groupSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("node-groupSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "data") {
-                    while (!(xml.isEndElement() && xml.name() == "data")) {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::DATA) {
+                    while (!(xml.isEndElement() && xml.name() == QLatin1String("data"))) {
                         xml.readNext();
                         if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                        if (xml.name() == "data-sceneNode") {
+                        EnumXMLTag dataTag = XMLTag::fromName(xml.name());
+                        if (dataTag == EnumXMLTag::DATA_SCENE_NODE) {
                             parseSceneNodeData(xml, node);
-                        } else if (xml.name() == "data-groupSceneNode") {
+                        } else if (dataTag == EnumXMLTag::DATA_GROUP_SCENE_NODE) {
                             parseGroupSceneNodeData(xml, node);
                         } else {
                             qWarning().noquote() << "Unrecognised tag: data > " + xml.name();
                         }
                     }
 
-                } else if (xml.name() == "children") {
+                } else if (tag == EnumXMLTag::CHILDREN) {
                     parseChildren(xml, node);
                 } else {
                     qWarning().noquote() << "Unrecognised tag: node-groupSceneNode > " + xml.name();
@@ -278,11 +293,12 @@ namespace WS2Common {
         }
 
         void parseGroupSceneNodeData(QXmlStreamReader &xml, GroupSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "data-groupSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("data-groupSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "collisionGrid") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::COLLISION_GRID) {
                     node->setCollisionGrid(CollisionGrid::deserializeDataXml(xml));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: data-groupSceneNode > " + xml.name();
@@ -291,25 +307,27 @@ namespace WS2Common {
         }
 
         void parseGoalSceneNode(QXmlStreamReader &xml, GoalSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "node-goalSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("node-goalSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "data") {
-                    while (!(xml.isEndElement() && xml.name() == "data")) {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::DATA) {
+                    while (!(xml.isEndElement() && xml.name() == QLatin1String("data"))) {
                         xml.readNext();
                         if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                        if (xml.name() == "data-sceneNode") {
+                        EnumXMLTag dataTag = XMLTag::fromName(xml.name());
+                        if (dataTag == EnumXMLTag::DATA_SCENE_NODE) {
                             parseSceneNodeData(xml, node);
-                        } else if (xml.name() == "data-goalSceneNode") {
+                        } else if (dataTag == EnumXMLTag::DATA_GOAL_SCENE_NODE) {
                             parseGoalSceneNodeData(xml, node);
                         } else {
                             qWarning().noquote() << "Unrecognised tag: data > " + xml.name();
                         }
                     }
 
-                } else if (xml.name() == "children") {
+                } else if (tag == EnumXMLTag::CHILDREN) {
                     parseChildren(xml, node);
                 } else {
                     qWarning().noquote() << "Unrecognised tag: node-goalSceneNode > " + xml.name();
@@ -318,11 +336,12 @@ namespace WS2Common {
         }
 
         void parseGoalSceneNodeData(QXmlStreamReader &xml, GoalSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "data-goalSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("data-goalSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "type") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::TYPE) {
                     node->setType(GoalType::fromString(xml.readElementText()));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: data-goalSceneNode > " + xml.name();
@@ -331,23 +350,25 @@ namespace WS2Common {
         }
 
         void parseBumperSceneNode(QXmlStreamReader &xml, BumperSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "node-bumperSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("node-bumperSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "data") {
-                    while (!(xml.isEndElement() && xml.name() == "data")) {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::DATA) {
+                    while (!(xml.isEndElement() && xml.name() == QLatin1String("data"))) {
                         xml.readNext();
                         if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                        if (xml.name() == "data-sceneNode") {
+                        EnumXMLTag dataTag = XMLTag::fromName(xml.name());
+                        if (dataTag == EnumXMLTag::DATA_SCENE_NODE) {
                             parseSceneNodeData(xml, node);
                         } else {
                             qWarning().noquote() << "Unrecognised tag: data > " + xml.name();
                         }
                     }
 
-                } else if (xml.name() == "children") {
+                } else if (tag == EnumXMLTag::CHILDREN) {
                     parseChildren(xml, node);
                 } else {
                     qWarning().noquote() << "Unrecognised tag: node-bumperSceneNode > " + xml.name();
@@ -356,25 +377,27 @@ namespace WS2Common {
         }
 
         void parseBananaSceneNode(QXmlStreamReader &xml, BananaSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "node-bananaSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("node-bananaSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "data") {
-                    while (!(xml.isEndElement() && xml.name() == "data")) {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::DATA) {
+                    while (!(xml.isEndElement() && xml.name() == QLatin1String("data"))) {
                         xml.readNext();
                         if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                        if (xml.name() == "data-sceneNode") {
+                        EnumXMLTag dataTag = XMLTag::fromName(xml.name());
+                        if (dataTag == EnumXMLTag::DATA_SCENE_NODE) {
                             parseSceneNodeData(xml, node);
-                        } else if (xml.name() == "data-bananaSceneNode") {
+                        } else if (dataTag == EnumXMLTag::DATA_BANANA_SCENE_NODE) {
                             parseBananaSceneNodeData(xml, node);
                         } else {
                             qWarning().noquote() << "Unrecognised tag: data > " + xml.name();
                         }
                     }
 
-                } else if (xml.name() == "children") {
+                } else if (tag == EnumXMLTag::CHILDREN) {
                     parseChildren(xml, node);
                 } else {
                     qWarning().noquote() << "Unrecognised tag: node-bananaSceneNode > " + xml.name();
@@ -383,11 +406,12 @@ namespace WS2Common {
         }
 
         void parseBananaSceneNodeData(QXmlStreamReader &xml, BananaSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "data-bananaSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("data-bananaSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "type") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::TYPE) {
                     node->setType(BananaType::fromString(xml.readElementText()));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: data-bananaSceneNode > " + xml.name();
@@ -396,23 +420,25 @@ namespace WS2Common {
         }
 
         void parseJamabarSceneNode(QXmlStreamReader &xml, JamabarSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "node-jamabarSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("node-jamabarSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "data") {
-                    while (!(xml.isEndElement() && xml.name() == "data")) {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::DATA) {
+                    while (!(xml.isEndElement() && xml.name() == QLatin1String("data"))) {
                         xml.readNext();
                         if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                        if (xml.name() == "data-sceneNode") {
+                        EnumXMLTag dataTag = XMLTag::fromName(xml.name());
+                        if (dataTag == EnumXMLTag::DATA_SCENE_NODE) {
                             parseSceneNodeData(xml, node);
                         } else {
                             qWarning().noquote() << "Unrecognised tag: data > " + xml.name();
                         }
                     }
 
-                } else if (xml.name() == "children") {
+                } else if (tag == EnumXMLTag::CHILDREN) {
                     parseChildren(xml, node);
                 } else {
                     qWarning().noquote() << "Unrecognised tag: node-jamabarSceneNode > " + xml.name();
@@ -421,25 +447,27 @@ namespace WS2Common {
         }
 
         void parseWormholeSceneNode(QXmlStreamReader &xml, WormholeSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "node-wormholeSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("node-wormholeSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "data") {
-                    while (!(xml.isEndElement() && xml.name() == "data")) {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::DATA) {
+                    while (!(xml.isEndElement() && xml.name() == QLatin1String("data"))) {
                         xml.readNext();
                         if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                        if (xml.name() == "data-sceneNode") {
+                        EnumXMLTag dataTag = XMLTag::fromName(xml.name());
+                        if (dataTag == EnumXMLTag::DATA_SCENE_NODE) {
                             parseSceneNodeData(xml, node);
-                        } else if (xml.name() == "data-wormholeSceneNode") {
+                        } else if (dataTag == EnumXMLTag::DATA_WORMHOLE_SCENE_NODE) {
                             parseWormholeSceneNodeData(xml, node);
                         } else {
                             qWarning().noquote() << "Unrecognised tag: data > " + xml.name();
                         }
                     }
 
-                } else if (xml.name() == "children") {
+                } else if (tag == EnumXMLTag::CHILDREN) {
                     parseChildren(xml, node);
                 } else {
                     qWarning().noquote() << "Unrecognised tag: node-wormholeSceneNode > " + xml.name();
@@ -448,11 +476,12 @@ namespace WS2Common {
         }
 
         void parseWormholeSceneNodeData(QXmlStreamReader &xml, WormholeSceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "data-wormholeSceneNode")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("data-wormholeSceneNode"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "destinationUuid") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::DESTINATION_UUID) {
                     node->setDestinationUuid(QUuid::fromString(xml.readElementText()));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: data-wormholeSceneNode > " + xml.name();
@@ -461,7 +490,7 @@ namespace WS2Common {
         }
 
         void parseChildren(QXmlStreamReader &xml, SceneNode *node) {
-            while (!(xml.isEndElement() && xml.name() == "children")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("children"))) {
                 xml.readNext();
                 deserializeNodeFromXml(xml, node);
             }
@@ -508,7 +537,92 @@ namespace WS2Common {
             xml.writeEndElement();
         }
 
-        QStringRef getAttribute(const QXmlStreamAttributes &attrs, const QString attrName) {
+        float parseFloat(const QStringRef &str, bool *ok) {
+            //Powers of 10 that a double can represent exactly
+            static const double EXACT_POWERS_OF_10[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+            static const quint64 MAX_EXACT_MANTISSA = Q_UINT64_C(1) << 53;
+
+            const QChar *c = str.constData();
+            const QChar *end = c + str.size();
+
+            bool negative = false;
+            if (c != end && (*c == '-' || *c == '+')) {
+                negative = *c == '-';
+                c++;
+            }
+
+            //Read the digits as one integer mantissa, with the decimal point moving the exponent
+            quint64 mantissa = 0;
+            int significantDigits = 0;
+            int exponent = 0;
+            int integerDigits = 0;
+            const QChar *integerStart = c;
+            for (; c != end && c->unicode() >= '0' && c->unicode() <= '9'; c++, integerDigits++) {
+                if (mantissa != 0 || *c != '0') significantDigits++;
+                mantissa = mantissa * 10 + (c->unicode() - '0');
+            }
+
+            int fractionDigits = 0;
+            if (c != end && *c == '.') {
+                c++;
+                for (; c != end && c->unicode() >= '0' && c->unicode() <= '9'; c++, fractionDigits++) {
+                    if (mantissa != 0 || *c != '0') significantDigits++;
+                    mantissa = mantissa * 10 + (c->unicode() - '0');
+                    exponent--;
+                }
+
+                //Leave "1." and ".5" to Qt, so they're accepted or rejected exactly as before
+                if (integerDigits == 0 || fractionDigits == 0) return str.toFloat(ok);
+            }
+
+            //Also leave leading zeros (Such as "007") to Qt
+            if (integerDigits == 0 || (integerDigits > 1 && *integerStart == '0')) return str.toFloat(ok);
+
+            if (c != end && (*c == 'e' || *c == 'E')) {
+                c++;
+                bool negativeExponent = false;
+                if (c != end && (*c == '-' || *c == '+')) {
+                    negativeExponent = *c == '-';
+                    c++;
+                }
+
+                int exponentValue = 0;
+                int exponentDigits = 0;
+                for (; c != end && c->unicode() >= '0' && c->unicode() <= '9' && exponentDigits < 4; c++, exponentDigits++) {
+                    exponentValue = exponentValue * 10 + (c->unicode() - '0');
+                }
+
+                if (exponentDigits == 0) return str.toFloat(ok);
+                exponent += negativeExponent ? -exponentValue : exponentValue;
+            }
+
+            //Anything left over (Such as whitespace or a 5th exponent digit), or a mantissa or exponent too big to be
+            //exact, goes the slow way
+            if (c != end || significantDigits > 19 || mantissa > MAX_EXACT_MANTISSA || exponent < -22 || exponent > 22) {
+                return str.toFloat(ok);
+            }
+
+            //The mantissa and power of 10 are both exact doubles, so one multiply or divide rounds correctly - the same
+            //double Qt gets. Qt then converts that double to a float, so do the same to round identically.
+            double value = (double) mantissa;
+            if (exponent < 0) {
+                value /= EXACT_POWERS_OF_10[-exponent];
+            } else {
+                value *= EXACT_POWERS_OF_10[exponent];
+            }
+
+            if (ok != nullptr) *ok = true;
+            return (float) (negative ? -value : value);
+        }
+
+        float parseFloat(const QString &str, bool *ok) {
+            return parseFloat(QStringRef(&str), ok);
+        }
+
+        QStringRef getAttribute(const QXmlStreamAttributes &attrs, QLatin1String attrName) {
             foreach(const QXmlStreamAttribute &attr, attrs) {
                 if (attr.name() == attrName) return attr.value();
             }
@@ -518,34 +632,34 @@ namespace WS2Common {
         }
 
         glm::vec3 getVec3Attributes(const QXmlStreamAttributes &attrs,
-                const QString x, const QString y, const QString z) {
+                QLatin1String x, QLatin1String y, QLatin1String z) {
             glm::vec3 vec;
             foreach(const QXmlStreamAttribute &attr, attrs) {
-                if (attr.name() == x) vec.x = attr.value().toFloat();
-                else if (attr.name() == y) vec.y = attr.value().toFloat();
-                else if (attr.name() == z) vec.z = attr.value().toFloat();
+                if (attr.name() == x) vec.x = parseFloat(attr.value());
+                else if (attr.name() == y) vec.y = parseFloat(attr.value());
+                else if (attr.name() == z) vec.z = parseFloat(attr.value());
             }
 
             return vec;
         }
 
         glm::vec2 getVec2Attributes(const QXmlStreamAttributes &attrs,
-                const QString x, const QString y) {
+                QLatin1String x, QLatin1String y) {
             glm::vec2 vec;
             foreach(const QXmlStreamAttribute &attr, attrs) {
-                if (attr.name() == x) vec.x = attr.value().toFloat();
-                else if (attr.name() == y) vec.y = attr.value().toFloat();
+                if (attr.name() == x) vec.x = parseFloat(attr.value());
+                else if (attr.name() == y) vec.y = parseFloat(attr.value());
             }
 
             return vec;
         }
 
         glm::uvec2 getUVec2Attributes(const QXmlStreamAttributes &attrs,
-                const QString x, const QString y) {
+                QLatin1String x, QLatin1String y) {
             glm::uvec2 vec;
             foreach(const QXmlStreamAttribute &attr, attrs) {
-                if (attr.name() == x) vec.x = attr.value().toFloat();
-                else if (attr.name() == y) vec.y = attr.value().toFloat();
+                if (attr.name() == x) vec.x = parseFloat(attr.value());
+                else if (attr.name() == y) vec.y = parseFloat(attr.value());
             }
 
             return vec;
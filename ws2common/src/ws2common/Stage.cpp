@@ -11,6 +11,25 @@ namespace WS2Common {
 
     Stage::~Stage() {
         delete rootNode;
+        delete fog;
+        delete fogAnimation;
+    }
+
+    Stage* Stage::clone() const {
+        Stage *copy = new Stage();
+        delete copy->rootNode;
+        copy->rootNode = rootNode->clone();
+
+        copy->stageType = stageType;
+        copy->falloutY = falloutY;
+
+        //Fog and its animation are deleted along with the stage, so the copy needs its own
+        if (fog != nullptr) copy->fog = new Fog(*fog);
+        if (fogAnimation != nullptr) copy->fogAnimation = new Animation::FogAnimation(*fogAnimation);
+
+        copy->models = models;
+
+        return copy;
     }
 
     void Stage::setRootNode(Scene::SceneNode *rootNode) {
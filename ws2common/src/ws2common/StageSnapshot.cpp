@@ -0,0 +1,722 @@
+#include "ws2common/StageSnapshot.hpp"
+#include "ws2common/scene/StartSceneNode.hpp"
+#include "ws2common/scene/MeshSceneNode.hpp"
+#include "ws2common/scene/MeshCollisionSceneNode.hpp"
+#include "ws2common/scene/GroupSceneNode.hpp"
+#include "ws2common/scene/BackgroundGroupSceneNode.hpp"
+#include "ws2common/scene/ForegroundGroupSceneNode.hpp"
+#include "ws2common/scene/GoalSceneNode.hpp"
+#include "ws2common/scene/BumperSceneNode.hpp"
+#include "ws2common/scene/JamabarSceneNode.hpp"
+#include "ws2common/scene/BananaSceneNode.hpp"
+#include "ws2common/scene/ConeCollisionObjectSceneNode.hpp"
+#include "ws2common/scene/SphereCollisionObjectSceneNode.hpp"
+#include "ws2common/scene/CylinderCollisionObjectSceneNode.hpp"
+#include "ws2common/scene/FalloutVolumeSceneNode.hpp"
+#include "ws2common/scene/SwitchSceneNode.hpp"
+#include "ws2common/scene/WormholeSceneNode.hpp"
+#include "ws2common/scene/RaceTrackPathSceneNode.hpp"
+#include "ws2common/scene/BoosterSceneNode.hpp"
+#include "ws2common/scene/GolfHoleSceneNode.hpp"
+#include <QFile>
+#include <QSaveFile>
+#include <QBuffer>
+#include <QDataStream>
+#include <QDebug>
+#include <cstring>
+
+namespace WS2Common {
+    namespace StageSnapshot {
+        using namespace Scene;
+        using namespace Animation;
+
+        /**
+         * @brief Bumped whenever the snapshot format changes, to reject snapshots that can't be read any more
+         */
+        static const quint32 FORMAT_VERSION = 1;
+
+        /**
+         * @brief Written before each node to say what class it is
+         *
+         * These values are part of the file format - only ever add to the end of this
+         */
+        enum EnumNodeType : quint8 {
+            SCENE_NODE = 0,
+            START = 1,
+            MESH = 2,
+            MESH_COLLISION = 3,
+            COLLISION = 4,
+            GROUP = 5,
+            BACKGROUND_GROUP = 6,
+            FOREGROUND_GROUP = 7,
+            GOAL = 8,
+            BUMPER = 9,
+            JAMABAR = 10,
+            BANANA = 11,
+            CONE_COLLISION_OBJECT = 12,
+            SPHERE_COLLISION_OBJECT = 13,
+            CYLINDER_COLLISION_OBJECT = 14,
+            FALLOUT_VOLUME = 15,
+            SWITCH = 16,
+            WORMHOLE = 17,
+            RACE_TRACK_PATH = 18,
+            BOOSTER = 19,
+            GOLF_HOLE = 20
+        };
+
+        static EnumNodeType getNodeType(const SceneNode *node) {
+            //Subclasses before their base classes
+            if (dynamic_cast<const MeshCollisionSceneNode*>(node)) return MESH_COLLISION;
+            if (dynamic_cast<const CollisionSceneNode*>(node)) return COLLISION;
+            if (dynamic_cast<const StartSceneNode*>(node)) return START;
+            if (dynamic_cast<const MeshSceneNode*>(node)) return MESH;
+            if (dynamic_cast<const GroupSceneNode*>(node)) return GROUP;
+            if (dynamic_cast<const BackgroundGroupSceneNode*>(node)) return BACKGROUND_GROUP;
+            if (dynamic_cast<const ForegroundGroupSceneNode*>(node)) return FOREGROUND_GROUP;
+            if (dynamic_cast<const GoalSceneNode*>(node)) return GOAL;
+            if (dynamic_cast<const BumperSceneNode*>(node)) return BUMPER;
+            if (dynamic_cast<const JamabarSceneNode*>(node)) return JAMABAR;
+            if (dynamic_cast<const BananaSceneNode*>(node)) return BANANA;
+            if (dynamic_cast<const ConeCollisionObjectSceneNode*>(node)) return CONE_COLLISION_OBJECT;
+            if (dynamic_cast<const SphereCollisionObjectSceneNode*>(node)) return SPHERE_COLLISION_OBJECT;
+            if (dynamic_cast<const CylinderCollisionObjectSceneNode*>(node)) return CYLINDER_COLLISION_OBJECT;
+            if (dynamic_cast<const FalloutVolumeSceneNode*>(node)) return FALLOUT_VOLUME;
+            if (dynamic_cast<const SwitchSceneNode*>(node)) return SWITCH;
+            if (dynamic_cast<const WormholeSceneNode*>(node)) return WORMHOLE;
+            if (dynamic_cast<const RaceTrackPathSceneNode*>(node)) return RACE_TRACK_PATH;
+            if (dynamic_cast<const BoosterSceneNode*>(node)) return BOOSTER;
+            if (dynamic_cast<const GolfHoleSceneNode*>(node)) return GOLF_HOLE;
+            return SCENE_NODE;
+        }
+
+        /**
+         * @return A new node of the type given, or nullptr if the type is unknown
+         *
+         * Some node types have no default constructor - they're given an empty name here, as the real one is read
+         * right after
+         */
+        static SceneNode* createNode(quint8 type) {
+            switch (type) {
+                case SCENE_NODE: return new SceneNode();
+                case START: return new StartSceneNode();
+                case MESH: return new MeshSceneNode();
+                case MESH_COLLISION: return new MeshCollisionSceneNode();
+                case COLLISION: return new CollisionSceneNode();
+                case GROUP: return new GroupSceneNode();
+                case BACKGROUND_GROUP: return new BackgroundGroupSceneNode(QString());
+                case FOREGROUND_GROUP: return new ForegroundGroupSceneNode(QString());
+                case GOAL: return new GoalSceneNode();
+                case BUMPER: return new BumperSceneNode();
+                case JAMABAR: return new JamabarSceneNode();
+                case BANANA: return new BananaSceneNode();
+                case CONE_COLLISION_OBJECT: return new ConeCollisionObjectSceneNode();
+                case SPHERE_COLLISION_OBJECT: return new SphereCollisionObjectSceneNode();
+                case CYLINDER_COLLISION_OBJECT: return new CylinderCollisionObjectSceneNode();
+                case FALLOUT_VOLUME: return new FalloutVolumeSceneNode(QString());
+                case SWITCH: return new SwitchSceneNode(QString());
+                case WORMHOLE: return new WormholeSceneNode();
+                case RACE_TRACK_PATH: return new RaceTrackPathSceneNode();
+                case BOOSTER: return new BoosterSceneNode();
+                case GOLF_HOLE: return new GolfHoleSceneNode();
+                default: return nullptr;
+            }
+        }
+
+        static void writeVec2(QDataStream &out, const glm::vec2 &vec) {
+            out << vec.x << vec.y;
+        }
+
+        static void writeVec3(QDataStream &out, const glm::vec3 &vec) {
+            out << vec.x << vec.y << vec.z;
+        }
+
+        static glm::vec2 readVec2(QDataStream &in) {
+            glm::vec2 vec;
+            in >> vec.x >> vec.y;
+            return vec;
+        }
+
+        static glm::vec3 readVec3(QDataStream &in) {
+            glm::vec3 vec;
+            in >> vec.x >> vec.y >> vec.z;
+            return vec;
+        }
+
+        /**
+         * @brief Checks that a count read from the stream could fit in what's left of it
+         *
+         * This stops a corrupt count from making the reader allocate gigabytes before it notices the data ran out.
+         *
+         * @param in The stream
+         * @param count The count read
+         * @param minBytesEach The smallest number of bytes each counted item could take up
+         *
+         * @return Whether the stream is still okay, and has room for the count given
+         */
+        static bool isCountValid(QDataStream &in, quint32 count, qint64 minBytesEach) {
+            return in.status() == QDataStream::Ok && (qint64) count * minBytesEach <= in.device()->bytesAvailable();
+        }
+
+        //Time, value, handle A, handle B, easing
+        static const qint64 KEYFRAME_SIZE = 4 * sizeof(float) + sizeof(quint32);
+
+        static void writeKeyframes(QDataStream &out, const std::set<KeyframeF*, KeyframeCompare> &keyframes) {
+            out << (quint32) keyframes.size();
+            for (const KeyframeF *k : keyframes) {
+                out << k->getValue().first << k->getValue().second << k->getHandleAValue() << k->getHandleBValue() <<
+                    (quint32) k->getEasing();
+            }
+        }
+
+        static bool readKeyframes(QDataStream &in, std::set<KeyframeF*, KeyframeCompare> &keyframes) {
+            quint32 count;
+            in >> count;
+            if (!isCountValid(in, count, KEYFRAME_SIZE)) return false;
+
+            for (quint32 i = 0; i < count; i++) {
+                float time, value, handleA, handleB;
+                quint32 easing;
+                in >> time >> value >> handleA >> handleB >> easing;
+
+                KeyframeF *k = new KeyframeF(time, value, (EnumEasing) easing);
+                k->setHandleAValue(handleA);
+                k->setHandleBValue(handleB);
+                if (!keyframes.insert(k).second) delete k; //Two keyframes at the same time - same as XML parsing
+            }
+
+            return in.status() == QDataStream::Ok;
+        }
+
+        static void writeTransformAnimation(QDataStream &out, const TransformAnimation &anim) {
+            out << (quint32) anim.getInitialState() << (quint32) anim.getLoopType() << anim.getLoopTime();
+            writeKeyframes(out, anim.getPosXKeyframes());
+            writeKeyframes(out, anim.getPosYKeyframes());
+            writeKeyframes(out, anim.getPosZKeyframes());
+            writeKeyframes(out, anim.getRotXKeyframes());
+            writeKeyframes(out, anim.getRotYKeyframes());
+            writeKeyframes(out, anim.getRotZKeyframes());
+            writeKeyframes(out, anim.getScaleXKeyframes());
+            writeKeyframes(out, anim.getScaleYKeyframes());
+            writeKeyframes(out, anim.getScaleZKeyframes());
+            writeKeyframes(out, anim.getUnknown1Keyframes());
+            writeKeyframes(out, anim.getUnknown2Keyframes());
+        }
+
+        static bool readTransformAnimation(QDataStream &in, TransformAnimation &anim) {
+            quint32 initialState, loopType;
+            float loopTime;
+            in >> initialState >> loopType >> loopTime;
+            anim.setInitialState((EnumPlaybackState) initialState);
+            anim.setLoopType((EnumLoopType) loopType);
+            anim.setLoopTime(loopTime);
+
+            return readKeyframes(in, anim.getPosXKeyframes()) &&
+                readKeyframes(in, anim.getPosYKeyframes()) &&
+                readKeyframes(in, anim.getPosZKeyframes()) &&
+                readKeyframes(in, anim.getRotXKeyframes()) &&
+                readKeyframes(in, anim.getRotYKeyframes()) &&
+                readKeyframes(in, anim.getRotZKeyframes()) &&
+                readKeyframes(in, anim.getScaleXKeyframes()) &&
+                readKeyframes(in, anim.getScaleYKeyframes()) &&
+                readKeyframes(in, anim.getScaleZKeyframes()) &&
+                readKeyframes(in, anim.getUnknown1Keyframes()) &&
+                readKeyframes(in, anim.getUnknown2Keyframes());
+        }
+
+        static void writeEffectAnimation(QDataStream &out, const EffectAnimation &anim) {
+            out << (quint32) anim.getEffect1Keyframes().size();
+            foreach(const KeyframeEffect1 *k, anim.getEffect1Keyframes()) {
+                out << k->getFrame();
+                writeVec3(out, k->getPosition());
+                writeVec3(out, k->getRotation());
+                out << (qint8) k->getUnknownByte1() << (qint8) k->getUnknownByte2();
+            }
+
+            out << (quint32) anim.getEffect2Keyframes().size();
+            foreach(const KeyframeEffect2 *k, anim.getEffect2Keyframes()) {
+                out << k->getFrame();
+                writeVec3(out, k->getPosition());
+                out << (qint8) k->getUnknownByte1() << (qint8) k->getUnknownByte2() <<
+                    (qint8) k->getUnknownByte3() << (qint8) k->getUnknownByte4();
+            }
+        }
+
+        static bool readEffectAnimation(QDataStream &in, EffectAnimation &anim) {
+            quint32 count;
+            in >> count;
+            if (!isCountValid(in, count, sizeof(quint32) + 6 * sizeof(float) + 2)) return false;
+
+            for (quint32 i = 0; i < count; i++) {
+                quint32 frame;
+                qint8 unknownByte1, unknownByte2;
+                in >> frame;
+                glm::vec3 position = readVec3(in);
+                glm::vec3 rotation = readVec3(in);
+                in >> unknownByte1 >> unknownByte2;
+
+                KeyframeEffect1 *k = new KeyframeEffect1(position, rotation, unknownByte1, unknownByte2);
+                k->setFrame(frame);
+                anim.getEffect1Keyframes().append(k);
+            }
+
+            in >> count;
+            if (!isCountValid(in, count, sizeof(quint32) + 3 * sizeof(float) + 4)) return false;
+
+            for (quint32 i = 0; i < count; i++) {
+                quint32 frame;
+                qint8 unknownByte1, unknownByte2, unknownByte3, unknownByte4;
+                in >> frame;
+                glm::vec3 position = readVec3(in);
+                in >> unknownByte1 >> unknownByte2 >> unknownByte3 >> unknownByte4;
+
+                KeyframeEffect2 *k = new KeyframeEffect2(position, unknownByte1, unknownByte2, unknownByte3, unknownByte4);
+                k->setFrame(frame);
+                anim.getEffect2Keyframes().append(k);
+            }
+
+            return in.status() == QDataStream::Ok;
+        }
+
+        static void writeNode(QDataStream &out, const SceneNode *node) {
+            EnumNodeType type = getNodeType(node);
+            out << (quint8) type;
+
+            //Data every node has
+            out << node->getName() << node->getUuid();
+            writeVec3(out, node->getOriginPosition());
+            writeVec3(out, node->getOriginRotation());
+            writeVec3(out, node->getPosition());
+            writeVec3(out, node->getRotation());
+            writeVec3(out, node->getScale());
+            writeVec3(out, node->getConveyorSpeed());
+            out << (quint32) node->getAnimationGroupId() << (quint32) node->getAnimationSeesawType();
+            out << node->getSeesawSensitivity() << node->getSeesawFriction() << node->getSeesawSpring();
+            writeVec2(out, node->getTextureScroll());
+
+            out << (bool) (node->getTransformAnimation() != nullptr);
+            if (node->getTransformAnimation() != nullptr) writeTransformAnimation(out, *node->getTransformAnimation());
+
+            out << (bool) (node->getEffectAnimation() != nullptr);
+            if (node->getEffectAnimation() != nullptr) writeEffectAnimation(out, *node->getEffectAnimation());
+
+            //Data for this type of node
+            switch (type) {
+                case START:
+                    out << (quint32) static_cast<const StartSceneNode*>(node)->getPlayerID();
+                    break;
+                case MESH: {
+                    const MeshSceneNode *mesh = static_cast<const MeshSceneNode*>(node);
+                    out << mesh->getMeshName() << mesh->isRuntimeReflective() << (quint32) mesh->getBitflag() <<
+                        (quint32) mesh->getMeshType();
+                    break;
+                }
+                case MESH_COLLISION: {
+                    const MeshCollisionSceneNode *coli = static_cast<const MeshCollisionSceneNode*>(node);
+                    out << coli->getMeshName() << coli->getCollisionTriangleFlag();
+                    break;
+                }
+                case GROUP: {
+                    const CollisionGrid &grid = static_cast<const GroupSceneNode*>(node)->getCollisionGrid();
+                    writeVec2(out, grid.getGridStart());
+                    writeVec2(out, grid.getGridStep());
+                    out << (quint32) grid.getGridStepCount().x << (quint32) grid.getGridStepCount().y;
+                    break;
+                }
+                case GOAL: {
+                    const GoalSceneNode *goal = static_cast<const GoalSceneNode*>(node);
+                    out << (quint32) goal->getType() << goal->getCastShadow();
+                    break;
+                }
+                case BANANA:
+                    out << (quint32) static_cast<const BananaSceneNode*>(node)->getType();
+                    break;
+                case CONE_COLLISION_OBJECT: {
+                    const ConeCollisionObjectSceneNode *cone = static_cast<const ConeCollisionObjectSceneNode*>(node);
+                    out << cone->getRadius() << cone->getHeight();
+                    break;
+                }
+                case SPHERE_COLLISION_OBJECT:
+                    out << static_cast<const SphereCollisionObjectSceneNode*>(node)->getRadius();
+                    break;
+                case CYLINDER_COLLISION_OBJECT: {
+                    const CylinderCollisionObjectSceneNode *cylinder = static_cast<const CylinderCollisionObjectSceneNode*>(node);
+                    out << cylinder->getRadius() << cylinder->getHeight();
+                    break;
+                }
+                case SWITCH: {
+                    const SwitchSceneNode *sw = static_cast<const SwitchSceneNode*>(node);
+                    out << (quint32) sw->getType() << (quint16) sw->getLinkedAnimGroupId();
+                    break;
+                }
+                case WORMHOLE:
+                    out << static_cast<const WormholeSceneNode*>(node)->getDestinationUuid();
+                    break;
+                case RACE_TRACK_PATH: {
+                    const RaceTrackPath *path = static_cast<const RaceTrackPathSceneNode*>(node)->getTrackPath();
+                    out << (bool) (path != nullptr);
+                    if (path != nullptr) {
+                        out << (quint32) path->getPlayerID();
+                        writeTransformAnimation(out, *path);
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+
+            out << (quint32) node->getChildCount();
+            foreach(const SceneNode *child, node->getChildren()) writeNode(out, child);
+        }
+
+        /**
+         * @return The node read, or nullptr if the snapshot was invalid or truncated
+         */
+        static SceneNode* readNode(QDataStream &in) {
+            quint8 type;
+            in >> type;
+            if (in.status() != QDataStream::Ok) return nullptr;
+
+            SceneNode *node = createNode(type);
+            if (node == nullptr) {
+                qWarning().noquote() << "Unknown node type in stage snapshot:" << type;
+                return nullptr;
+            }
+
+            //Data every node has
+            QString name;
+            QUuid uuid;
+            quint32 animationGroupId, animationSeesawType;
+            float seesawSensitivity, seesawFriction, seesawSpring;
+
+            in >> name >> uuid;
+            node->setName(name);
+            node->setUuid(uuid);
+            node->setOriginPosition(readVec3(in));
+            node->setOriginRotation(readVec3(in));
+            node->setPosition(readVec3(in));
+            node->setRotation(readVec3(in));
+            node->setScale(readVec3(in));
+            node->setConveyorSpeed(readVec3(in));
+            in >> animationGroupId >> animationSeesawType >> seesawSensitivity >> seesawFriction >> seesawSpring;
+            node->setAnimationGroupId(animationGroupId);
+            node->setAnimationSeesawType((EnumAnimationSeesawType) animationSeesawType);
+            node->setSeesawSensitivity(seesawSensitivity);
+            node->setSeesawFriction(seesawFriction);
+            node->setSeesawSpring(seesawSpring);
+            node->setTextureScroll(readVec2(in));
+
+            bool hasAnimation;
+            in >> hasAnimation;
+            if (hasAnimation) {
+                TransformAnimation *anim = new TransformAnimation();
+                node->setTransformAnimation(anim); //The node owns this, so it's freed with the node on failure
+                if (!readTransformAnimation(in, *anim)) {
+                    delete node;
+                    return nullptr;
+                }
+            }
+
+            bool hasEffectAnimation;
+            in >> hasEffectAnimation;
+            if (hasEffectAnimation) {
+                EffectAnimation *anim = new EffectAnimation();
+                node->setEffectAnimation(anim);
+                if (!readEffectAnimation(in, *anim)) {
+                    delete node;
+                    return nullptr;
+                }
+            }
+
+            //Data for this type of node
+            switch (type) {
+                case START: {
+                    quint32 playerID;
+                    in >> playerID;
+                    static_cast<StartSceneNode*>(node)->setPlayerID(playerID);
+                    break;
+                }
+                case MESH: {
+                    MeshSceneNode *mesh = static_cast<MeshSceneNode*>(node);
+                    QString meshName;
+                    bool runtimeReflective;
+                    quint32 bitflag, meshType;
+                    in >> meshName >> runtimeReflective >> bitflag >> meshType;
+                    mesh->setMeshName(meshName);
+                    mesh->setRuntimeReflective(runtimeReflective);
+                    mesh->setBitflag(bitflag);
+                    mesh->setMeshType(meshType);
+                    break;
+                }
+                case MESH_COLLISION: {
+                    MeshCollisionSceneNode *coli = static_cast<MeshCollisionSceneNode*>(node);
+                    QString meshName;
+                    quint16 flag;
+                    in >> meshName >> flag;
+                    coli->setMeshName(meshName);
+                    coli->setCollisionTriangleFlag(flag);
+                    break;
+                }
+                case GROUP: {
+                    CollisionGrid &grid = static_cast<GroupSceneNode*>(node)->getCollisionGrid();
+                    grid.setGridStart(readVec2(in));
+                    grid.setGridStep(readVec2(in));
+                    quint32 stepCountX, stepCountY;
+                    in >> stepCountX >> stepCountY;
+                    grid.setGridStepCount(glm::uvec2(stepCountX, stepCountY));
+                    break;
+                }
+                case GOAL: {
+                    GoalSceneNode *goal = static_cast<GoalSceneNode*>(node);
+                    quint32 goalType;
+                    bool castShadow;
+                    in >> goalType >> castShadow;
+                    goal->setType((EnumGoalType) goalType);
+                    goal->setCastShadow(castShadow);
+                    break;
+                }
+                case BANANA: {
+                    quint32 bananaType;
+                    in >> bananaType;
+                    static_cast<BananaSceneNode*>(node)->setType((EnumBananaType) bananaType);
+                    break;
+                }
+                case CONE_COLLISION_OBJECT: {
+                    ConeCollisionObjectSceneNode *cone = static_cast<ConeCollisionObjectSceneNode*>(node);
+                    float radius, height;
+                    in >> radius >> height;
+                    cone->setRadius(radius);
+                    cone->setHeight(height);
+                    break;
+                }
+                case SPHERE_COLLISION_OBJECT: {
+                    float radius;
+                    in >> radius;
+                    static_cast<SphereCollisionObjectSceneNode*>(node)->setRadius(radius);
+                    break;
+                }
+                case CYLINDER_COLLISION_OBJECT: {
+                    CylinderCollisionObjectSceneNode *cylinder = static_cast<CylinderCollisionObjectSceneNode*>(node);
+                    float radius, height;
+                    in >> radius >> height;
+                    cylinder->setRadius(radius);
+                    cylinder->setHeight(height);
+                    break;
+                }
+                case SWITCH: {
+                    SwitchSceneNode *sw = static_cast<SwitchSceneNode*>(node);
+                    quint32 switchType;
+                    quint16 linkedAnimGroupId;
+                    in >> switchType >> linkedAnimGroupId;
+                    sw->setType((EnumPlaybackState) switchType);
+                    sw->setLinkedAnimGroupId(linkedAnimGroupId);
+                    break;
+                }
+                case WORMHOLE: {
+                    QUuid destinationUuid;
+                    in >> destinationUuid;
+                    static_cast<WormholeSceneNode*>(node)->setDestinationUuid(destinationUuid);
+                    break;
+                }
+                case RACE_TRACK_PATH: {
+                    bool hasPath;
+                    in >> hasPath;
+                    if (hasPath) {
+                        RaceTrackPath *path = new RaceTrackPath();
+                        quint32 playerID;
+                        in >> playerID;
+                        path->setPlayerID(playerID);
+                        static_cast<RaceTrackPathSceneNode*>(node)->setTrackPath(path);
+                        if (!readTransformAnimation(in, *path)) {
+                            delete node;
+                            return nullptr;
+                        }
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+
+            //Type, and a child count for each child
+            quint32 childCount;
+            in >> childCount;
+            if (!isCountValid(in, childCount, 1 + sizeof(quint32))) {
+                delete node;
+                return nullptr;
+            }
+
+            for (quint32 i = 0; i < childCount; i++) {
+                SceneNode *child = readNode(in);
+                if (child == nullptr) {
+                    delete node;
+                    return nullptr;
+                }
+
+                node->addChild(child);
+            }
+
+            return node;
+        }
+
+        bool write(QIODevice &device, const Stage &stage) {
+            QDataStream out(&device);
+            out.setByteOrder(QDataStream::BigEndian);
+            out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+            out.writeRawData("WS2S", 4);
+            out << FORMAT_VERSION;
+
+            out << (quint32) stage.getStageType() << stage.getFalloutY() << stage.getModels();
+
+            const Fog *fog = stage.getFog();
+            out << (bool) (fog != nullptr);
+            if (fog != nullptr) {
+                out << (quint32) fog->getFogType() << fog->getRedValue() << fog->getGreenValue() << fog->getBlueValue() <<
+                    fog->getStartDistance() << fog->getEndDistance();
+            }
+
+            const FogAnimation *fogAnim = stage.getFogAnimation();
+            out << (bool) (fogAnim != nullptr);
+            if (fogAnim != nullptr) {
+                writeKeyframes(out, fogAnim->getRedKeyframes());
+                writeKeyframes(out, fogAnim->getGreenKeyframes());
+                writeKeyframes(out, fogAnim->getBlueKeyframes());
+                writeKeyframes(out, fogAnim->getStartDistanceKeyframes());
+                writeKeyframes(out, fogAnim->getEndDistanceKeyframes());
+                writeKeyframes(out, fogAnim->getUnknownKeyframes());
+            }
+
+            writeNode(out, stage.getRootNode());
+
+            if (out.status() != QDataStream::Ok) {
+                qWarning().noquote() << "Failed to write stage snapshot -" << device.errorString();
+                return false;
+            }
+
+            return true;
+        }
+
+        bool writeFile(const QString &filePath, const Stage &stage) {
+            //QSaveFile only replaces the old file once everything is written, so a crash can't leave half a snapshot
+            QSaveFile file(filePath);
+            if (!file.open(QIODevice::WriteOnly)) {
+                qWarning().noquote() << "Failed to write stage snapshot" << filePath << "-" << file.errorString();
+                return false;
+            }
+
+            if (!write(file, stage)) {
+                file.cancelWriting();
+                return false;
+            }
+
+            if (!file.commit()) {
+                qWarning().noquote() << "Failed to write stage snapshot" << filePath << "-" << file.errorString();
+                return false;
+            }
+
+            return true;
+        }
+
+        Stage* read(QIODevice &device) {
+            QDataStream in(&device);
+            in.setByteOrder(QDataStream::BigEndian);
+            in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+            char magic[4];
+            quint32 version = 0;
+            if (in.readRawData(magic, 4) != 4 || std::memcmp(magic, "WS2S", 4) != 0) {
+                qWarning().noquote() << "Not a stage snapshot";
+                return nullptr;
+            }
+
+            in >> version;
+            if (in.status() != QDataStream::Ok || version != FORMAT_VERSION) {
+                qWarning().noquote() << "Unsupported stage snapshot version" << version << "- expected" << FORMAT_VERSION;
+                return nullptr;
+            }
+
+            quint32 stageType;
+            float falloutY;
+            QVector<QUrl> models;
+            in >> stageType >> falloutY >> models;
+
+            Stage *stage = new Stage();
+            stage->setStageType((EnumStageType) stageType);
+            stage->setFalloutY(falloutY);
+            foreach(const QUrl &url, models) stage->addModel(url);
+
+            bool hasFog;
+            in >> hasFog;
+            if (hasFog) {
+                quint32 fogType;
+                float red, green, blue, startDistance, endDistance;
+                in >> fogType >> red >> green >> blue >> startDistance >> endDistance;
+
+                Fog *fog = new Fog();
+                fog->setFogType((EnumFogType) fogType);
+                fog->setRedValue(red);
+                fog->setGreenValue(green);
+                fog->setBlueValue(blue);
+                fog->setStartDistance(startDistance);
+                fog->setEndDistance(endDistance);
+                stage->setFog(fog);
+            }
+
+            bool hasFogAnimation;
+            in >> hasFogAnimation;
+            if (hasFogAnimation) {
+                FogAnimation *fogAnim = new FogAnimation();
+                stage->setFogAnimation(fogAnim);
+
+                bool ok = readKeyframes(in, fogAnim->getRedKeyframes()) &&
+                    readKeyframes(in, fogAnim->getGreenKeyframes()) &&
+                    readKeyframes(in, fogAnim->getBlueKeyframes()) &&
+                    readKeyframes(in, fogAnim->getStartDistanceKeyframes()) &&
+                    readKeyframes(in, fogAnim->getEndDistanceKeyframes()) &&
+                    readKeyframes(in, fogAnim->getUnknownKeyframes());
+
+                if (!ok) {
+                    qWarning().noquote() << "Stage snapshot is truncated or corrupt";
+                    delete stage;
+                    return nullptr;
+                }
+            }
+
+            SceneNode *rootNode = readNode(in);
+            if (rootNode == nullptr) {
+                qWarning().noquote() << "Stage snapshot is truncated or corrupt";
+                delete stage;
+                return nullptr;
+            }
+
+            //Replace the default root node the stage was created with
+            delete stage->getRootNode();
+            stage->setRootNode(rootNode);
+
+            return stage;
+        }
+
+        Stage* readFile(const QString &filePath) {
+            QFile file(filePath);
+            if (!file.open(QIODevice::ReadOnly)) {
+                qWarning().noquote() << "Failed to read stage snapshot" << filePath << "-" << file.errorString();
+                return nullptr;
+            }
+
+            qint64 mappedSize = file.size();
+            const uchar *mapped = file.map(0, mappedSize);
+            if (mapped == nullptr) {
+                //Can't be mapped (Such as an empty file) - fall back to reading it normally
+                return read(file);
+            }
+
+            //Read straight out of the mapped file without copying it
+            QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), mappedSize);
+            QBuffer buf(&data);
+            buf.open(QIODevice::ReadOnly);
+
+            return read(buf);
+        }
+    }
+}
+
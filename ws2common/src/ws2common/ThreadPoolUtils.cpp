@@ -0,0 +1,55 @@
+#include "ws2common/ThreadPoolUtils.hpp"
+#include <QThreadPool>
+
+namespace WS2Common {
+    namespace ThreadPoolUtils {
+        /**
+         * @brief Whether this thread is running a task started with startGlobal
+         */
+        static thread_local bool globalPoolThread = false;
+
+        namespace {
+            /**
+             * @brief Marks the thread as a global pool thread while running the task it wraps
+             */
+            class MarkedTask : public QRunnable {
+                protected:
+                    QRunnable *task;
+                    bool deleteTask;
+
+                public:
+                    MarkedTask(QRunnable *task) :
+                        task(task),
+                        //Read this now - A task that isn't auto deleted may be deleted by its owner once it's run
+                        deleteTask(task->autoDelete()) {}
+
+                    virtual void run() override {
+                        bool wasGlobalPoolThread = globalPoolThread;
+                        globalPoolThread = true;
+                        task->run();
+                        globalPoolThread = wasGlobalPoolThread;
+
+                        if (deleteTask) delete task;
+                    }
+            };
+        }
+
+        void startGlobal(QRunnable *task) {
+            QThreadPool::globalInstance()->start(new MarkedTask(task));
+        }
+
+        bool isGlobalPoolThread() {
+            return globalPoolThread;
+        }
+
+        WaitScope::WaitScope() :
+            released(globalPoolThread) {
+            if (released) QThreadPool::globalInstance()->releaseThread();
+        }
+
+        WaitScope::~WaitScope() {
+            if (released) QThreadPool::globalInstance()->reserveThread();
+        }
+    }
+}
+
@@ -0,0 +1,53 @@
+#include "ws2common/UuidGenerator.hpp"
+
+namespace WS2Common {
+    /**
+     * @brief The generator made current on this thread by a UuidGenerator::Scope, if any
+     */
+    static thread_local UuidGenerator *currentGenerator = nullptr;
+
+    UuidGenerator::UuidGenerator() {
+        //One UUID from the system is 122 random bits - plenty to seed from
+        QUuid seed = QUuid::createUuid();
+        std::seed_seq seq {
+            (quint32) seed.data1,
+            ((quint32) seed.data2 << 16) | seed.data3,
+            ((quint32) seed.data4[0] << 24) | ((quint32) seed.data4[1] << 16) | ((quint32) seed.data4[2] << 8) | seed.data4[3],
+            ((quint32) seed.data4[4] << 24) | ((quint32) seed.data4[5] << 16) | ((quint32) seed.data4[6] << 8) | seed.data4[7]
+        };
+        randGen.seed(seq);
+    }
+
+    UuidGenerator::UuidGenerator(quint64 seed) :
+        randGen(seed) {}
+
+    QUuid UuidGenerator::generate() {
+        quint64 high = randGen();
+        quint64 low = randGen();
+
+        //Set the version (4 - random) and variant (RFC 4122) bits, just like QUuid::createUuid
+        high = (high & ~Q_UINT64_C(0xF000)) | Q_UINT64_C(0x4000);
+        low = (low & Q_UINT64_C(0x3FFFFFFFFFFFFFFF)) | Q_UINT64_C(0x8000000000000000);
+
+        return QUuid(
+                (uint) (high >> 32), (ushort) (high >> 16), (ushort) high,
+                (uchar) (low >> 56), (uchar) (low >> 48), (uchar) (low >> 40), (uchar) (low >> 32),
+                (uchar) (low >> 24), (uchar) (low >> 16), (uchar) (low >> 8), (uchar) low
+                );
+    }
+
+    QUuid UuidGenerator::createUuid() {
+        if (currentGenerator != nullptr) return currentGenerator->generate();
+        return QUuid::createUuid();
+    }
+
+    UuidGenerator::Scope::Scope(UuidGenerator *generator) :
+        previous(currentGenerator) {
+        currentGenerator = generator;
+    }
+
+    UuidGenerator::Scope::~Scope() {
+        currentGenerator = previous;
+    }
+}
+
@@ -31,5 +31,15 @@ namespace WS2Common {
         {
             effect1Keyframes = value;
         }
+
+        QSharedPointer<MemoryArena> EffectAnimation::getKeyframeArena() const
+        {
+            return keyframeArena;
+        }
+
+        void EffectAnimation::setKeyframeArena(QSharedPointer<MemoryArena> keyframeArena)
+        {
+            this->keyframeArena = keyframeArena;
+        }
     }
 }
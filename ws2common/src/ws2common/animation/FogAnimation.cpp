@@ -61,5 +61,15 @@ namespace WS2Common {
             return unknownKeyframes;
         }
 
+        QSharedPointer<MemoryArena> FogAnimation::getKeyframeArena() const
+        {
+            return keyframeArena;
+        }
+
+        void FogAnimation::setKeyframeArena(QSharedPointer<MemoryArena> keyframeArena)
+        {
+            this->keyframeArena = keyframeArena;
+        }
+
     }
 }
@@ -117,6 +117,14 @@ namespace WS2Common {
         const std::set<KeyframeF*, KeyframeCompare>& TransformAnimation::getUnknown2Keyframes() const {
             return unknown2Keyframes;
         }
+
+        QSharedPointer<MemoryArena> TransformAnimation::getKeyframeArena() const {
+            return keyframeArena;
+        }
+
+        void TransformAnimation::setKeyframeArena(QSharedPointer<MemoryArena> keyframeArena) {
+            this->keyframeArena = keyframeArena;
+        }
     }
 }
 
@@ -1,57 +1,379 @@
 #include "ws2common/config/XMLConfigParser.hpp"
+#include "ws2common/config/XMLConfigSchema.hpp"
 #include "ws2common/scene/MeshCollisionSceneNode.hpp"
 #include "ws2common/SerializeUtils.hpp"
+#include "ws2common/EnumXMLTag.hpp"
 #include "ws2common/MathUtils.hpp"
+#include "ws2common/MessageHandler.hpp"
+#include "ws2common/UuidGenerator.hpp"
+#include "ws2common/ThreadPoolUtils.hpp"
 #include <QXmlStreamReader>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QAtomicInt>
+#include <QSet>
 #include <QDebug>
 #include <QCoreApplication>
 #include <QtMath>
+#include <cstring>
+#include <utility>
 
 namespace WS2Common {
     namespace Config {
+        static QAtomicInt parallelParsingEnabled(0);
+        static QAtomicInt pooledAllocationEnabled(0);
+
+        namespace {
+            /**
+             * @brief Creates a keyframe in the arena given, or with new if there isn't one
+             */
+            template<typename T, typename... Args>
+            T* createKeyframe(MemoryArena *arena, Args&&... args) {
+                if (arena != nullptr) return arena->create<T>(std::forward<Args>(args)...);
+                return new T(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Where an itemGroup element is in a config, found by scanItemGroups
+             */
+            struct ItemGroupRange {
+                int begin;
+                int end;
+
+                /**
+                 * @brief Element name, how many elements with that name are directly within the item group
+                 */
+                QHash<QString, unsigned int> childCounts;
+            };
+
+            /**
+             * @brief Finds the end of a markup construct, such as the "-->" of a comment
+             *
+             * @return The index just past the terminator, or -1 if the config ends first
+             */
+            int findPast(const QByteArray &config, int from, const char *terminator) {
+                int index = config.indexOf(terminator, from);
+                return index == -1 ? -1 : index + (int) qstrlen(terminator);
+            }
+
+            /**
+             * @brief Checks that the encoding in an XML declaration is one the byte scan can handle
+             *
+             * @param declaration The whole <?xml ... ?> declaration
+             *
+             * @return Whether the config is UTF-8 (Or ASCII, which is a subset of it)
+             */
+            bool isScannableEncoding(const QByteArray &declaration) {
+                int encodingIndex = declaration.indexOf("encoding");
+                if (encodingIndex == -1) return true; //UTF-8 is the default
+
+                int quoteIndex = encodingIndex + 8;
+                while (quoteIndex < declaration.size() && declaration.at(quoteIndex) != '"' && declaration.at(quoteIndex) != '\'') quoteIndex++;
+                if (quoteIndex >= declaration.size()) return false;
+
+                int endQuoteIndex = declaration.indexOf(declaration.at(quoteIndex), quoteIndex + 1);
+                if (endQuoteIndex == -1) return false;
+
+                QByteArray encoding = declaration.mid(quoteIndex + 1, endQuoteIndex - quoteIndex - 1).toLower();
+                return encoding == "utf-8" || encoding == "us-ascii";
+            }
+
+            /**
+             * @brief Quickly finds every itemGroup element directly within the root element of a config, without
+             *        parsing it
+             *
+             * Only tags, comments, CDATA sections and processing instructions are picked out - attributes and text
+             * aren't looked at, apart from skipping over quoted attribute values so a ">" in one isn't mistaken for
+             * the end of a tag.
+             *
+             * @param config The whole XML config
+             * @param groups The item groups found are appended to this, in config order
+             *
+             * @return false if the config can't be safely split up into item groups (Such as if it declares entities
+             *         in a DOCTYPE, isn't UTF-8, or its tags aren't balanced), in which case it should be parsed serially
+             */
+            bool scanItemGroups(const QByteArray &config, QVector<ItemGroupRange> &groups) {
+                const char *data = config.constData();
+                int size = config.size();
+
+                //UTF-16 and UTF-32 configs have NUL bytes within the first few characters
+                if (size >= 2 && (data[0] == '\0' || data[1] == '\0')) return false;
+
+                int depth = 0;
+                int pos = 0;
+                int openGroup = -1; //Index of the item group being scanned through, if any
+
+                while (pos < size) {
+                    const char *tagStart = static_cast<const char*>(memchr(data + pos, '<', size - pos));
+                    if (tagStart == nullptr) break;
+                    pos = tagStart - data;
+
+                    if (qstrncmp(data + pos, "<!--", 4) == 0) {
+                        pos = findPast(config, pos + 4, "-->");
+                    } else if (qstrncmp(data + pos, "<![CDATA[", 9) == 0) {
+                        pos = findPast(config, pos + 9, "]]>");
+                    } else if (pos + 1 < size && data[pos + 1] == '!') {
+                        //A DOCTYPE could declare entities, which wouldn't be known to a reader of just one item group
+                        return false;
+                    } else if (pos + 1 < size && data[pos + 1] == '?') {
+                        int end = findPast(config, pos + 2, "?>");
+                        if (end == -1) return false;
+                        if (qstrncmp(data + pos, "<?xml ", 6) == 0 && !isScannableEncoding(config.mid(pos, end - pos))) return false;
+                        pos = end;
+                    } else if (pos + 1 < size && data[pos + 1] == '/') {
+                        int end = config.indexOf('>', pos + 2);
+                        if (end == -1) return false;
+                        pos = end + 1;
+
+                        depth--;
+                        if (depth < 0) return false;
+                        if (openGroup != -1 && depth == 1) {
+                            groups[openGroup].end = pos;
+                            openGroup = -1;
+                        }
+                    } else {
+                        //Start tag - read the name, then skip to the end of the tag, past any quoted attribute values
+                        int nameStart = pos + 1;
+                        int nameEnd = nameStart;
+                        while (nameEnd < size && !strchr(" \t\r\n/>", data[nameEnd])) nameEnd++;
+
+                        int end = nameEnd;
+                        char quote = '\0';
+                        while (end < size && (quote != '\0' || data[end] != '>')) {
+                            if (quote != '\0') {
+                                if (data[end] == quote) quote = '\0';
+                            } else if (data[end] == '"' || data[end] == '\'') {
+                                quote = data[end];
+                            }
+                            end++;
+                        }
+                        if (end >= size) return false;
+
+                        bool selfClosing = data[end - 1] == '/';
+                        QLatin1String name(data + nameStart, nameEnd - nameStart);
+
+                        if (depth == 1 && name == QLatin1String("itemGroup")) {
+                            ItemGroupRange range;
+                            range.begin = pos;
+                            range.end = end + 1;
+                            groups.append(range);
+                            if (!selfClosing) openGroup = groups.size() - 1;
+                        } else if (openGroup != -1 && depth == 2) {
+                            groups[openGroup].childCounts[QString(name)]++;
+                        }
+
+                        pos = end + 1;
+                        if (!selfClosing) depth++;
+                    }
+
+                    if (pos == -1) return false;
+                }
+
+                return depth == 0 && openGroup == -1;
+            }
+        }
+
+        void XMLConfigParser::setParallelParsingEnabled(bool enabled) {
+            parallelParsingEnabled.store(enabled ? 1 : 0);
+        }
+
+        bool XMLConfigParser::isParallelParsingEnabled() {
+            return parallelParsingEnabled.load() != 0;
+        }
+
+        void XMLConfigParser::setPooledAllocationEnabled(bool enabled) {
+            pooledAllocationEnabled.store(enabled ? 1 : 0);
+        }
+
+        bool XMLConfigParser::isPooledAllocationEnabled() {
+            return pooledAllocationEnabled.load() != 0;
+        }
+
         Stage* XMLConfigParser::parseStage(QString config, QDir relativeRoot) {
+            if (isParallelParsingEnabled()) {
+                Stage *stage = parseStageParallel(config.toUtf8(), relativeRoot);
+                if (stage != nullptr) return stage;
+            }
+
+            QXmlStreamReader xml(config);
+            return parseStage(xml, relativeRoot);
+        }
+
+        Stage* XMLConfigParser::parseStage(QIODevice &device, QDir relativeRoot) {
+            //Item groups can only be found and parsed in parallel with the whole config in memory
+            if (isParallelParsingEnabled()) {
+                QByteArray config = device.readAll();
+                Stage *stage = parseStageParallel(config, relativeRoot);
+                if (stage != nullptr) return stage;
+
+                QXmlStreamReader xml(config);
+                return parseStage(xml, relativeRoot);
+            }
+
+            //The reader pulls from the device a chunk at a time, so the whole file is never held in memory at once
+            QXmlStreamReader xml(&device);
+            return parseStage(xml, relativeRoot);
+        }
+
+        Stage* XMLConfigParser::parseStageParallel(const QByteArray &config, QDir relativeRoot) {
+            QVector<ItemGroupRange> groups;
+            if (!scanItemGroups(config, groups) || groups.size() < 2) return nullptr;
+
+            //Each item group gets its own parser, so wormholes and default names are tracked per thread
+            QVector<XMLConfigParser> groupParsers(groups.size());
+            QVector<Scene::GroupSceneNode*> groupNodes(groups.size());
+
+            //Nodes without a name are numbered in config order - carry on from where the item groups before left off
+            //Item groups don't share any element names with the rest of the config that are numbered, so only other
+            //item groups need counting
+            QHash<QString, unsigned int> firstIds;
+            bool pooled = isPooledAllocationEnabled();
+            for (int i = 0; i < groups.size(); i++) {
+                groupParsers[i].defaultNameIds = firstIds;
+                if (pooled) groupParsers[i].keyframeArena = QSharedPointer<MemoryArena>::create();
+
+                QHash<QString, unsigned int>::const_iterator j;
+                for (j = groups.at(i).childCounts.constBegin(); j != groups.at(i).childCounts.constEnd(); ++j) {
+                    firstIds[j.key()] += j.value();
+                }
+            }
+
+            class ParseItemGroupTask : public QRunnable {
+                public:
+                    XMLConfigParser *parser;
+                    QByteArray groupXml;
+                    Scene::GroupSceneNode **group;
+                    QSemaphore *finished;
+                    bool pooled;
+
+                    /**
+                     * @brief The message prefix of the thread that started this task, so warnings are tagged the same
+                     */
+                    QString messagePrefix;
+
+                    virtual void run() override {
+                        MessagePrefixScope prefixScope(messagePrefix);
+                        UuidGenerator uuidGenerator;
+                        UuidGenerator::Scope uuidScope(pooled ? &uuidGenerator : nullptr);
+
+                        QXmlStreamReader xml(groupXml);
+                        while (!xml.atEnd() && !xml.isStartElement()) xml.readNext(); //Read up to <itemGroup>
+
+                        *group = parser->parseItemGroup(xml);
+
+                        if (xml.hasError()) {
+                            qWarning().noquote() << "XML parsing error:" << xml.errorString();
+                        }
+
+                        finished->release();
+                    }
+            };
+
+            QSemaphore finished;
+            for (int i = 0; i < groups.size(); i++) {
+                ParseItemGroupTask *task = new ParseItemGroupTask();
+                task->parser = &groupParsers[i];
+                //Points into config rather than copying it
+                task->groupXml = QByteArray::fromRawData(config.constData() + groups.at(i).begin, groups.at(i).end - groups.at(i).begin);
+                task->group = &groupNodes[i];
+                task->finished = &finished;
+                task->pooled = pooled;
+                task->messagePrefix = MessagePrefixScope::getCurrentPrefix();
+                ThreadPoolUtils::startGlobal(task);
+            }
+
+            //Build the rest of the config with a placeholder for each item group, to parse once they're done
+            QByteArray skeleton;
+            int pos = 0;
+            foreach(const ItemGroupRange &range, groups) {
+                skeleton.append(config.constData() + pos, range.begin - pos);
+                skeleton.append("<itemGroup/>");
+                pos = range.end;
+            }
+            skeleton.append(config.constData() + pos, config.size() - pos);
+
+            {
+                //If this is running on the global thread pool, don't hold up the item groups by taking one of its threads
+                ThreadPoolUtils::WaitScope waitScope;
+                finished.acquire(groups.size());
+            }
+
+            //Merge in config order, so wormholes link just like they would parsing one item group after another
+            for (int i = 0; i < groupParsers.size(); i++) {
+                wormholes += groupParsers.at(i).wormholes;
+                wormholeDests += groupParsers.at(i).wormholeDests;
+            }
+
+            parsedItemGroups = groupNodes;
+            nextParsedItemGroup = 0;
+
+            QXmlStreamReader xml(skeleton);
+            Stage *stage = parseStage(xml, relativeRoot);
+
+            //Any not used means the skeleton didn't parse the same as the scan - they're not in the stage, so free them
+            for (int i = nextParsedItemGroup; i < parsedItemGroups.size(); i++) delete parsedItemGroups.at(i);
+            parsedItemGroups.clear();
+
+            return stage;
+        }
+
+        Stage* XMLConfigParser::parseStage(QXmlStreamReader &xml, QDir relativeRoot) {
+            //With pooled allocation, nodes created on this thread take their UUIDs from a seeded generator, and every
+            //keyframe goes in one arena
+            bool pooled = isPooledAllocationEnabled();
+            UuidGenerator uuidGenerator;
+            UuidGenerator::Scope uuidScope(pooled ? &uuidGenerator : nullptr);
+            if (pooled) keyframeArena = QSharedPointer<MemoryArena>::create();
+
             Stage *stage = new Stage();
+            wormholeLinkReport = WormholeLinkReport();
+            defaultNameIds.clear();
 
             //Read and parse the XML
-            QXmlStreamReader xml(config);
             while (!xml.atEnd()) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                if (xml.name() == "superMonkeyBallStage") { //TODO: Check superMonkeyBallStage version attribute
+                if (xml.name() == QLatin1String("superMonkeyBallStage")) { //TODO: Check superMonkeyBallStage version attribute
                     //Parse the stages
-                    while (!(xml.isEndElement() && xml.name() == "superMonkeyBallStage")) {
+                    while (!(xml.isEndElement() && xml.name() == QLatin1String("superMonkeyBallStage"))) {
                         //Keep reading until the </superMonkeyBallStage> tag
                         xml.readNext();
                         if (!xml.isStartElement()) continue; //Ignore all end elements, again
 
-                        qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                        ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                             "superMonkeyBallStage > " << xml.name();
 
-                        if (xml.name() == "modelImport") {
+                        EnumXMLTag tag = XMLTag::fromName(xml.name());
+                        if (tag == EnumXMLTag::MODEL_IMPORT) {
                             QUrl url = parseModelImport(xml, relativeRoot);
                             if (!url.isEmpty()) stage->addModel(url);
-                        } else if (xml.name() == "start") {
+                        } else if (tag == EnumXMLTag::START) {
                             stage->getRootNode()->addChild(parseStart(xml));
-                        } else if (xml.name() == "backgroundModel") {
+                        } else if (tag == EnumXMLTag::BACKGROUND_MODEL) {
                             stage->getFirstBackgroundGroup(true)->addChild(parseBackgroundModel(xml));
-                        } else if (xml.name() == "foregroundModel") {
+                        } else if (tag == EnumXMLTag::FOREGROUND_MODEL) {
                             stage->getFirstForegroundGroup(true)->addChild(parseForegroundModel(xml));
-                        } else if (xml.name() == "falloutPlane") {
-                            stage->setFalloutY(SerializeUtils::getAttribute(xml.attributes(), "y").toFloat());
-                        } else if (xml.name() == "stageType") {
+                        } else if (tag == EnumXMLTag::FALLOUT_PLANE) {
+                            stage->setFalloutY(SerializeUtils::parseFloat(SerializeUtils::getAttribute(xml.attributes(), QLatin1String("y"))));
+                        } else if (tag == EnumXMLTag::STAGE_TYPE) {
                             stage->setStageType(StageType::fromString(xml.readElementText()));
-                        } else if (xml.name() == "fog") {
+                        } else if (tag == EnumXMLTag::FOG) {
                             stage->setFog(parseFog(xml));
-                        } else if (xml.name() == "fogAnimationKeyframes") {
+                        } else if (tag == EnumXMLTag::FOG_ANIMATION_KEYFRAMES) {
                             stage->setFogAnimation(parseFogAnimation(xml));
-                        } else if (xml.name() == "itemGroup") {
-                            stage->getRootNode()->addChild(parseItemGroup(xml));
-                        } else if (xml.name() == "trackPath") {
+                        } else if (tag == EnumXMLTag::ITEM_GROUP) {
+                            if (nextParsedItemGroup < parsedItemGroups.size()) {
+                                //Already parsed in parallel - this is just a placeholder
+                                stage->getRootNode()->addChild(parsedItemGroups.at(nextParsedItemGroup++));
+                            } else {
+                                stage->getRootNode()->addChild(parseItemGroup(xml));
+                            }
+                        } else if (tag == EnumXMLTag::TRACK_PATH) {
                             stage->getRootNode()->addChild(parseTrackPath(xml));
-                        } else if (xml.name() == "booster") {
+                        } else if (tag == EnumXMLTag::BOOSTER) {
                             stage->getRootNode()->addChild(parseBooster(xml));
-                        } else if (xml.name() == "golfHole") {
+                        } else if (tag == EnumXMLTag::GOLF_HOLE) {
                             stage->getRootNode()->addChild(parseGolfHole(xml));
                         } else {
                             qWarning().noquote() << "Unrecognised tag:" << xml.name();
@@ -72,32 +394,188 @@ namespace WS2Common {
             }
 
             //Done parsing - now link wormholes
-            if (wormholeDestMap.size() > 0) qInfo().noquote() << QString("Linking %1 wormholes...").arg(wormholeDestMap.size());
+            linkWormholes();
+
+            //The stage's animations keep the arena alive from here on
+            keyframeArena.clear();
 
-            QHashIterator<Scene::WormholeSceneNode*, QString> i(wormholeDestMap);
-            while (i.hasNext()) {
-                i.next();
+            return stage;
+        }
+
+        void XMLConfigParser::linkWormholes() {
+            if (wormholeDests.size() > 0) qInfo().noquote() << QString("Linking %1 wormholes...").arg(wormholeDests.size());
+
+            //Index by name, so linking doesn't need to search every wormhole
+            QHash<QString, Scene::WormholeSceneNode*> wormholesByName;
+            QSet<QString> duplicateNames; //Keeps the report free of repeats when a name is used 3 or more times
+            foreach(Scene::WormholeSceneNode *wh, wormholes) {
+                if (!wormholesByName.contains(wh->getName())) {
+                    wormholesByName.insert(wh->getName(), wh);
+                } else if (!duplicateNames.contains(wh->getName())) {
+                    duplicateNames.insert(wh->getName());
+                    wormholeLinkReport.duplicateNames.append(wh->getName());
+                }
+            }
+
+            foreach(const QString &name, wormholeLinkReport.duplicateNames) {
+                qWarning().noquote() << QString("Multiple wormholes are named \"%1\" - wormholes with it as their destination will link to the first one").arg(name);
+            }
+
+            typedef QPair<Scene::WormholeSceneNode*, QString> WormholeDest;
+            foreach(const WormholeDest &dest, wormholeDests) {
+                Scene::WormholeSceneNode *destination = wormholesByName.value(dest.second);
+
+                if (destination != nullptr) {
+                    dest.first->setDestinationUuid(destination->getUuid());
+                    wormholeLinkReport.linkedCount++;
+                } else {
+                    //If we couldn't find a wormhole to link against, warn the user
+                    wormholeLinkReport.missingDestinations.append(qMakePair(dest.first->getName(), dest.second));
+                    qCritical().noquote() << QString("Failed to link wormhole \"%1\" to \"%2\" - \"%2\" doesn't exist").arg(dest.first->getName()).arg(dest.second);
+                }
+            }
+
+            //The wormholes belong to the stage now - don't hang on to them
+            wormholes.clear();
+            wormholeDests.clear();
+        }
+
+        unsigned int XMLConfigParser::nextDefaultNameId(const QString &elementName) {
+            return defaultNameIds[elementName]++;
+        }
 
-                //Iterate over all wormholes to find the one with the matching destination name
-                QHashIterator<Scene::WormholeSceneNode*, QString> j(wormholeDestMap);
-                bool linkSuccess = false;
-                while (j.hasNext()) {
-                    j.next();
+        const XMLConfigParser::WormholeLinkReport& XMLConfigParser::getWormholeLinkReport() const {
+            return wormholeLinkReport;
+        }
+
+        bool XMLConfigParser::WormholeLinkReport::isOk() const {
+            return duplicateNames.isEmpty() && missingDestinations.isEmpty();
+        }
+
+        QVector<XMLConfigParser::ValidationError> XMLConfigParser::validateStage(QIODevice &device, QDir relativeRoot) {
+            using namespace XMLConfigSchema;
+
+            QVector<ValidationError> errors;
+            QXmlStreamReader xml(&device);
+
+            auto addError = [&errors](qint64 line, qint64 column, const QString &message) {
+                ValidationError error;
+                error.line = line;
+                error.column = column;
+                error.message = message;
+                errors.append(error);
+            };
+
+            //The elements currently open, and their rules
+            QVector<EnumXMLTag> tags;
+            QStringList names;
+            QVector<const ElementRule*> rules;
+
+            //Where the token just read starts - the reader's own position is past the end of it, after any attributes
+            qint64 line = 0;
+            qint64 column = 0;
 
-                    if (i.value() == j.key()->getName()) {
-                        i.key()->setDestinationUuid(j.key()->getUuid());
-                        linkSuccess = true;
+            while (!xml.atEnd()) {
+                line = xml.lineNumber();
+                column = xml.columnNumber();
+                xml.readNext();
+
+                if (xml.isEndElement()) {
+                    tags.removeLast();
+                    names.removeLast();
+                    rules.removeLast();
+                    continue;
+                }
+
+                if (xml.isCharacters() && !xml.isWhitespace() && !rules.isEmpty()) {
+                    addError(line, column, QString("<%1> can't contain text").arg(names.last()));
+                    continue;
+                }
+
+                if (!xml.isStartElement()) continue;
+
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                EnumXMLTag parent = tags.isEmpty() ? EnumXMLTag::UNRECOGNISED : tags.last();
+                EnumXMLTag grandparent = tags.size() < 2 ? EnumXMLTag::UNRECOGNISED : tags.at(tags.size() - 2);
+
+                const ElementRule *rule = tag == EnumXMLTag::UNRECOGNISED ? nullptr : findElementRule(grandparent, parent, tag);
+                if (rule == nullptr) {
+                    if (tags.isEmpty()) {
+                        addError(line, column, QString("XML root tag is %1! It should be superMonkeyBallStage").arg(xml.name().toString()));
+                        return errors;
+                    } else if (rules.last()->content.type == EnumValueType::EMPTY) {
+                        addError(line, column, QString("<%1> can't contain elements").arg(names.last()));
+                    } else {
+                        addError(line, column, QString("Unrecognised tag: %1 > %2").arg(names.last()).arg(xml.name().toString()));
+                    }
+
+                    xml.skipCurrentElement();
+                    continue;
+                }
+
+                foreach(const QXmlStreamAttribute &attr, xml.attributes()) {
+                    const AttributeRule *attrRule = findAttributeRule(*rule, attr.name());
+                    if (attrRule == nullptr) {
+                        addError(line, column, QString("Unrecognised attribute: %1 %2").arg(xml.name().toString()).arg(attr.name().toString()));
+                        continue;
+                    }
+
+                    QString problem = checkValue(attrRule->value, attr.value());
+                    if (!problem.isNull()) {
+                        addError(line, column, QString("%1 %2: %3").arg(xml.name().toString()).arg(attr.name().toString()).arg(problem));
+                    }
+                }
+
+                if (rule->attributes != nullptr) {
+                    for (const AttributeRule *attrRule = rule->attributes; attrRule->name != nullptr; attrRule++) {
+                        if (attrRule->required && !xml.attributes().hasAttribute(QLatin1String(attrRule->name))) {
+                            addError(line, column, QString("%1 is missing the %2 attribute").arg(xml.name().toString()).arg(attrRule->name));
+                        }
+                    }
+                }
+
+                if (rule->content.type == EnumValueType::ELEMENTS || rule->content.type == EnumValueType::EMPTY) {
+                    tags.append(tag);
+                    names.append(xml.name().toString());
+                    rules.append(rule);
+                    continue;
+                }
+
+                //Everything else holds a value as text - read it here, reporting any elements mixed in with it
+                QString name = xml.name().toString();
+                QString text;
+                while (!xml.atEnd()) {
+                    qint64 childLine = xml.lineNumber();
+                    qint64 childColumn = xml.columnNumber();
+                    xml.readNext();
+                    if (xml.isCharacters()) {
+                        text += xml.text();
+                    } else if (xml.isStartElement()) {
+                        addError(childLine, childColumn, QString("<%1> can't contain elements").arg(name));
+                        xml.skipCurrentElement();
+                    } else if (xml.isEndElement()) {
                         break;
                     }
                 }
 
-                //If we couldn't find a wormhole to link against, warn the user
-                if (!linkSuccess) {
-                    qCritical().noquote() << QString("Failed to link wormhole \"%1\" to \"%2\" - \"%2\" doesn't exist").arg(j.key()->getName()).arg(i.value());
+                if (tag == EnumXMLTag::MODEL_IMPORT) {
+                    //Resolved just like parseModelImport does
+                    QFileInfo fileInfo = text.startsWith("//") ?
+                        QFileInfo(relativeRoot, text.mid(2)) :
+                        QFileInfo(QUrl(text).toLocalFile());
+
+                    if (!fileInfo.exists()) addError(line, column, QString("modelImport file missing: %1").arg(fileInfo.absoluteFilePath()));
+                } else {
+                    QString problem = checkValue(rule->content, QStringRef(&text));
+                    if (!problem.isNull()) addError(line, column, QString("%1: %2").arg(name).arg(problem));
                 }
             }
 
-            return stage;
+            if (xml.hasError()) {
+                addError(xml.lineNumber(), xml.columnNumber(), QString("XML parsing error: %1").arg(xml.errorString()));
+            }
+
+            return errors;
         }
 
         QUrl XMLConfigParser::parseModelImport(QXmlStreamReader &xml, QDir relativeRoot) {
@@ -131,20 +609,21 @@ namespace WS2Common {
             //Default name is "Start", translated
             Scene::StartSceneNode *start = new Scene::StartSceneNode(QCoreApplication::translate("XMLConfigParser", "Start"));
 
-            while (!(xml.isEndElement() && xml.name() == "start")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("start"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "start > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     start->setName(xml.readElementText());
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     start->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     start->setRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
-                } else if (xml.name() == "playerID") {
+                } else if (tag == EnumXMLTag::PLAYER_ID) {
                     start->setPlayerID(xml.readElementText().toUInt());
                 } else {
                     qWarning().noquote() << "Unrecognised tag: start >" << xml.name();
@@ -160,35 +639,36 @@ namespace WS2Common {
             Animation::TransformAnimation *anim = nullptr;
             float loopTime = 0.0f;
 
-            while (!(xml.isEndElement() && xml.name() == "backgroundModel")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("backgroundModel"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "backgroundModel > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     QString name = xml.readElementText();
 
                     bg->setName(name);
                     bg->setMeshName(name);
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     bg->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     bg->setRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
-                } else if (xml.name() == "scale") {
+                } else if (tag == EnumXMLTag::SCALE) {
                     bg->setScale(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "meshType") {
+                } else if (tag == EnumXMLTag::MESH_TYPE) {
                     bg->setMeshType(xml.readElementText().toUInt());
-                } else if (xml.name() == "animKeyframes") { 
+                } else if (tag == EnumXMLTag::ANIM_KEYFRAMES) { 
                     Animation::TransformAnimation *transformAnim = parseTransformAnimation(xml, true);
                     bg->setTransformAnimation(transformAnim);
                     anim = transformAnim; //For later linking (So that the loop type is set in the transformAnim)
-                } else if (xml.name() == "animLoopTime") { 
-                    loopTime = (xml.readElementText().toFloat());
-                } else if (xml.name() == "textureScroll") {
+                } else if (tag == EnumXMLTag::ANIM_LOOP_TIME) { 
+                    loopTime = (SerializeUtils::parseFloat(xml.readElementText()));
+                } else if (tag == EnumXMLTag::TEXTURE_SCROLL) {
                    bg->setTextureScroll(SerializeUtils::getVec2Attributes(xml.attributes()));
-                } else if (xml.name() == "effectKeyframes") {
+                } else if (tag == EnumXMLTag::EFFECT_KEYFRAMES) {
                     Animation::EffectAnimation *effectAnim = parseEffectAnimation(xml);
                     bg->setEffectAnimation(effectAnim);
                 } else {
@@ -209,35 +689,36 @@ namespace WS2Common {
             Animation::TransformAnimation *anim = nullptr;
             float loopTime = 0.0f;
 
-            while (!(xml.isEndElement() && xml.name() == "foregroundModel")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("foregroundModel"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "foregroundModel > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     QString name = xml.readElementText();
 
                     fg->setName(name);
                     fg->setMeshName(name);
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     fg->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     fg->setRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
-                } else if (xml.name() == "scale") {
+                } else if (tag == EnumXMLTag::SCALE) {
                     fg->setScale(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "meshType") {
+                } else if (tag == EnumXMLTag::MESH_TYPE) {
                     fg->setMeshType(xml.readElementText().toUInt());
-                } else if (xml.name() == "animKeyframes") { //TODO
+                } else if (tag == EnumXMLTag::ANIM_KEYFRAMES) { //TODO
                     Animation::TransformAnimation *transformAnim = parseTransformAnimation(xml, true);
                     fg->setTransformAnimation(transformAnim);
                     anim = transformAnim; //For later linking (So that the loop type is set in the transformAnim)
-                } else if (xml.name() == "animLoopTime") { 
-                    loopTime = (xml.readElementText().toFloat());
-                } else if (xml.name() == "textureScroll") {
+                } else if (tag == EnumXMLTag::ANIM_LOOP_TIME) { 
+                    loopTime = (SerializeUtils::parseFloat(xml.readElementText()));
+                } else if (tag == EnumXMLTag::TEXTURE_SCROLL) {
                    fg->setTextureScroll(SerializeUtils::getVec2Attributes(xml.attributes()));
-                } else if (xml.name() == "effectKeyframes") {
+                } else if (tag == EnumXMLTag::EFFECT_KEYFRAMES) {
                     Animation::EffectAnimation *effectAnim = parseEffectAnimation(xml);
                     fg->setEffectAnimation(effectAnim);
                 } else {
@@ -263,74 +744,75 @@ namespace WS2Common {
             Animation::EnumLoopType loopType = Animation::EnumLoopType::LOOPING;
             float loopTime = 0.0f;
 
-            while (!(xml.isEndElement() && xml.name() == "itemGroup")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("itemGroup"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "itemGroup > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     group->setName(xml.readElementText());
-                } else if (xml.name() == "rotationCenter") {
+                } else if (tag == EnumXMLTag::ROTATION_CENTER) {
                     group->setOriginPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "initialRotation") {
+                } else if (tag == EnumXMLTag::INITIAL_ROTATION) {
                     group->setOriginRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
-                } else if (xml.name() == "animSeesawType") {
+                } else if (tag == EnumXMLTag::ANIM_SEESAW_TYPE) {
                     QPair<EnumAnimationSeesawType, Animation::EnumLoopType> type = parseAnimLoopType(xml);
                     group->setAnimationSeesawType(type.first);
                     loopType = type.second; //loopType will be linked with an animation later if needed
-                } else if (xml.name() == "conveyorSpeed") {
+                } else if (tag == EnumXMLTag::CONVEYOR_SPEED) {
                     group->setConveyorSpeed(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "seesawSensitivity") {
-                    group->setSeesawSensitivity(xml.readElementText().toFloat()); //TODO: Error checking
-                } else if (xml.name() == "seesawResetStiffness") { //Deprecated
+                } else if (tag == EnumXMLTag::SEESAW_SENSITIVITY) {
+                    group->setSeesawSensitivity(SerializeUtils::parseFloat(xml.readElementText())); //TODO: Error checking
+                } else if (tag == EnumXMLTag::SEESAW_RESET_STIFFNESS) { //Deprecated
                     qWarning() << "seesawResetStiffness is deprecated! Prefer seesawFriction instead";
-                    group->setSeesawFriction(xml.readElementText().toFloat()); //TODO: Error checking
-                } else if (xml.name() == "seesawFriction") {
-                    group->setSeesawFriction(xml.readElementText().toFloat()); //TODO: Error checking
-                } else if (xml.name() == "seesawRotationBounds") { //Deprecated
+                    group->setSeesawFriction(SerializeUtils::parseFloat(xml.readElementText())); //TODO: Error checking
+                } else if (tag == EnumXMLTag::SEESAW_FRICTION) {
+                    group->setSeesawFriction(SerializeUtils::parseFloat(xml.readElementText())); //TODO: Error checking
+                } else if (tag == EnumXMLTag::SEESAW_ROTATION_BOUNDS) { //Deprecated
                     qWarning() << "seesawRotationBounds is deprecated! Prefer seesawSpring instead";
-                    group->setSeesawSpring(xml.readElementText().toFloat()); //TODO: Error checking
-                } else if (xml.name() == "seesawSpring") {
-                    group->setSeesawSpring(xml.readElementText().toFloat()); //TODO: Error checking
-                } else if (xml.name() == "textureScroll") {
+                    group->setSeesawSpring(SerializeUtils::parseFloat(xml.readElementText())); //TODO: Error checking
+                } else if (tag == EnumXMLTag::SEESAW_SPRING) {
+                    group->setSeesawSpring(SerializeUtils::parseFloat(xml.readElementText())); //TODO: Error checking
+                } else if (tag == EnumXMLTag::TEXTURE_SCROLL) {
                     group->setTextureScroll(SerializeUtils::getVec2Attributes(xml.attributes()));
-                } else if (xml.name() == "animKeyframes") {
+                } else if (tag == EnumXMLTag::ANIM_KEYFRAMES) {
                     Animation::TransformAnimation *transformAnim = parseTransformAnimation(xml, false);
                     group->setTransformAnimation(transformAnim);
                     anim = transformAnim; //For later linking (So that the loop type is set in the transformAnim)
-                } else if (xml.name() == "animLoopTime") {
-                    loopTime = xml.readElementText().toFloat(); //For later linking
-                } else if (xml.name() == "animGroupId") {
+                } else if (tag == EnumXMLTag::ANIM_LOOP_TIME) {
+                    loopTime = SerializeUtils::parseFloat(xml.readElementText()); //For later linking
+                } else if (tag == EnumXMLTag::ANIM_GROUP_ID) {
                     group->setAnimationGroupId(xml.readElementText().toUInt());
-                } else if (xml.name() == "animInitialState") {
+                } else if (tag == EnumXMLTag::ANIM_INITIAL_STATE) {
                     initialState = PlaybackState::fromString(xml.readElementText());
-                } else if (xml.name() == "collisionGrid") {
+                } else if (tag == EnumXMLTag::COLLISION_GRID) {
                     group->setCollisionGrid(parseCollisionGrid(xml));
-                } else if (xml.name() == "goal") {
+                } else if (tag == EnumXMLTag::GOAL) {
                     group->addChild(parseGoal(xml));
-                } else if (xml.name() == "bumper") {
+                } else if (tag == EnumXMLTag::BUMPER) {
                     group->addChild(parseBumper(xml));
-                } else if (xml.name() == "jamabar") {
+                } else if (tag == EnumXMLTag::JAMABAR) {
                     group->addChild(parseJamabar(xml));
-                } else if (xml.name() == "banana") {
+                } else if (tag == EnumXMLTag::BANANA) {
                     group->addChild(parseBanana(xml));
-                } else if (xml.name() == "cone") {
+                } else if (tag == EnumXMLTag::CONE) {
                     group->addChild(parseConeCollisionObject(xml));  
-                } else if (xml.name() == "sphere") {
+                } else if (tag == EnumXMLTag::SPHERE) {
                     group->addChild(parseSphereCollisionObject(xml));
-                } else if (xml.name() == "cylinder") {
+                } else if (tag == EnumXMLTag::CYLINDER) {
                     group->addChild(parseCylinderCollisionObject(xml));
-                } else if (xml.name() == "falloutVolume") {
+                } else if (tag == EnumXMLTag::FALLOUT_VOLUME) {
                     group->addChild(parseFalloutVolume(xml));
-                } else if (xml.name() == "wormhole") {
+                } else if (tag == EnumXMLTag::WORMHOLE) {
                     group->addChild(parseWormhole(xml));
-                } else if (xml.name() == "switch") {
+                } else if (tag == EnumXMLTag::SWITCH) {
                     group->addChild(parseSwitch(xml));
-                } else if (xml.name() == "levelModel") { //Deprecated
+                } else if (tag == EnumXMLTag::LEVEL_MODEL) { //Deprecated
                     group->addChild(parseLevelModel(xml));
-                } else if (xml.name() == "stageModel") {
+                } else if (tag == EnumXMLTag::STAGE_MODEL) {
                     group->addChild(parseStageModel(xml));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: itemGroup >" << xml.name();
@@ -348,306 +830,298 @@ namespace WS2Common {
 
         Scene::GoalSceneNode* XMLConfigParser::parseGoal(QXmlStreamReader &xml) {
             //Default name is "Goal x", translated
-            static unsigned int id = 0;
+            unsigned int id = nextDefaultNameId(QStringLiteral("goal"));
             Scene::GoalSceneNode *goal = new Scene::GoalSceneNode(QCoreApplication::translate("XMLConfigParser", "Goal %1").arg(id));
 
-            while (!(xml.isEndElement() && xml.name() == "goal")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("goal"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "goal > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     goal->setName(xml.readElementText());
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     goal->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     goal->setRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
-                } else if (xml.name() == "type") {
+                } else if (tag == EnumXMLTag::TYPE) {
                     goal->setType(GoalType::fromString(xml.readElementText()));
-                } else if (xml.name() == "castShadow") {
+                } else if (tag == EnumXMLTag::CAST_SHADOW) {
                     goal->setCastShadow(xml.readElementText() == "true");    
                 } else {
                     qWarning().noquote() << "Unrecognised tag: goal >" << xml.name();
                 }
             }
 
-            id++;
-
             return goal;
         }
 
         Scene::BumperSceneNode* XMLConfigParser::parseBumper(QXmlStreamReader &xml) {
             //Default name is "Bumper x", translated
-            static unsigned int id = 0;
+            unsigned int id = nextDefaultNameId(QStringLiteral("bumper"));
             Scene::BumperSceneNode *bumper = new Scene::BumperSceneNode(QCoreApplication::translate("XMLConfigParser", "Bumper %1").arg(id));
 
-            while (!(xml.isEndElement() && xml.name() == "bumper")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("bumper"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "bumper > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     bumper->setName(xml.readElementText());
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     bumper->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     bumper->setRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
-                } else if (xml.name() == "scale") {
+                } else if (tag == EnumXMLTag::SCALE) {
                     bumper->setScale(SerializeUtils::getVec3Attributes(xml.attributes()));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: bumper >" << xml.name();
                 }
             }
 
-            id++;
-
             return bumper;
         }
 
         Scene::JamabarSceneNode* XMLConfigParser::parseJamabar(QXmlStreamReader &xml) {
             //Default name is "Jamabar x", translated
-            static unsigned int id = 0;
+            unsigned int id = nextDefaultNameId(QStringLiteral("jamabar"));
             Scene::JamabarSceneNode *jamabar = new Scene::JamabarSceneNode(QCoreApplication::translate("XMLConfigParser", "Jamabar %1").arg(id));
 
-            while (!(xml.isEndElement() && xml.name() == "jamabar")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("jamabar"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "jamabar > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     jamabar->setName(xml.readElementText());
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     jamabar->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     jamabar->setRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
-                } else if (xml.name() == "scale") {
+                } else if (tag == EnumXMLTag::SCALE) {
                     jamabar->setScale(SerializeUtils::getVec3Attributes(xml.attributes()));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: jamabar >" << xml.name();
                 }
             }
 
-            id++;
-
             return jamabar;
         }
 
         Scene::BananaSceneNode* XMLConfigParser::parseBanana(QXmlStreamReader &xml) {
             //Default name is "Banana x", translated
-            static unsigned int id = 0;
+            unsigned int id = nextDefaultNameId(QStringLiteral("banana"));
             Scene::BananaSceneNode *banana = new Scene::BananaSceneNode(QCoreApplication::translate("XMLConfigParser", "Banana %1").arg(id));
 
-            while (!(xml.isEndElement() && xml.name() == "banana")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("banana"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "banana > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     banana->setName(xml.readElementText());
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     banana->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "type") {
+                } else if (tag == EnumXMLTag::TYPE) {
                     banana->setType(BananaType::fromString(xml.readElementText()));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: banana >" << xml.name();
                 }
             }
 
-            id++;
-
             return banana;
         }
 
         Scene::ConeCollisionObjectSceneNode* XMLConfigParser::parseConeCollisionObject(QXmlStreamReader &xml) {
             //Default name is "Cone Collision Object x", translated
-            static unsigned int id = 0;
+            unsigned int id = nextDefaultNameId(QStringLiteral("cone"));
             Scene::ConeCollisionObjectSceneNode *cone = new Scene::ConeCollisionObjectSceneNode(QCoreApplication::translate("XMLConfigParser", "Cone Collision Object %1").arg(id));
 
-            while (!(xml.isEndElement() && xml.name() == "cone")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("cone"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "cone > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     cone->setName(xml.readElementText());
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     cone->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     cone->setRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
-                } else if (xml.name() == "radius") {
-                    cone->setRadius(xml.readElementText().toFloat());
-                } else if (xml.name() == "height") {
-                    cone->setHeight(xml.readElementText().toFloat());
+                } else if (tag == EnumXMLTag::RADIUS) {
+                    cone->setRadius(SerializeUtils::parseFloat(xml.readElementText()));
+                } else if (tag == EnumXMLTag::HEIGHT) {
+                    cone->setHeight(SerializeUtils::parseFloat(xml.readElementText()));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: cone >" << xml.name();
                 }
             }
 
-            id++;
-
             return cone;
         }
 
         Scene::SphereCollisionObjectSceneNode* XMLConfigParser::parseSphereCollisionObject(QXmlStreamReader &xml) {
             //Default name is "Sphere Collision Object x", translated
-            static unsigned int id = 0;
+            unsigned int id = nextDefaultNameId(QStringLiteral("sphere"));
             Scene::SphereCollisionObjectSceneNode *sphere = new Scene::SphereCollisionObjectSceneNode(QCoreApplication::translate("XMLConfigParser", "Sphere Collision Object %1").arg(id));
 
-            while (!(xml.isEndElement() && xml.name() == "sphere")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("sphere"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "sphere > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     sphere->setName(xml.readElementText());
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     sphere->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "radius") {
-                    sphere->setRadius(xml.readElementText().toFloat());
+                } else if (tag == EnumXMLTag::RADIUS) {
+                    sphere->setRadius(SerializeUtils::parseFloat(xml.readElementText()));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: sphere >" << xml.name();
                 }
             }
 
-            id++;
-
             return sphere;
         }
 
         Scene::CylinderCollisionObjectSceneNode* XMLConfigParser::parseCylinderCollisionObject(QXmlStreamReader &xml) {
             //Default name is "Cylinder Collision Object x", translated
-            static unsigned int id = 0;
+            unsigned int id = nextDefaultNameId(QStringLiteral("cylinder"));
             Scene::CylinderCollisionObjectSceneNode *cylinder = new Scene::CylinderCollisionObjectSceneNode(QCoreApplication::translate("XMLConfigParser", "Cylinder Collision Object %1").arg(id));
 
-            while (!(xml.isEndElement() && xml.name() == "cylinder")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("cylinder"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "cylinder > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     cylinder->setName(xml.readElementText());
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     cylinder->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     cylinder->setRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
-                } else if (xml.name() == "radius") {
-                    cylinder->setRadius(xml.readElementText().toFloat());
-                } else if (xml.name() == "height") {
-                    cylinder->setHeight(xml.readElementText().toFloat());
+                } else if (tag == EnumXMLTag::RADIUS) {
+                    cylinder->setRadius(SerializeUtils::parseFloat(xml.readElementText()));
+                } else if (tag == EnumXMLTag::HEIGHT) {
+                    cylinder->setHeight(SerializeUtils::parseFloat(xml.readElementText()));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: cylinder >" << xml.name();
                 }
             }
 
-            id++;
-
             return cylinder;
         }
 
         Scene::FalloutVolumeSceneNode* XMLConfigParser::parseFalloutVolume(QXmlStreamReader &xml) {
             //Default name is "Fallout Volume x", translated
-            static unsigned int id = 0;
+            unsigned int id = nextDefaultNameId(QStringLiteral("falloutVolume"));
             Scene::FalloutVolumeSceneNode *volume = new Scene::FalloutVolumeSceneNode(QCoreApplication::translate("XMLConfigParser", "Fallout Volume %1").arg(id));
 
-            while (!(xml.isEndElement() && xml.name() == "falloutVolume")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("falloutVolume"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "falloutVolume > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     volume->setName(xml.readElementText());
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     volume->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     volume->setRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
-                } else if (xml.name() == "scale") {
+                } else if (tag == EnumXMLTag::SCALE) {
                     volume->setScale(SerializeUtils::getVec3Attributes(xml.attributes()));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: falloutVolume >" << xml.name();
                 }
             }
 
-            id++;
-
             return volume;
         }
 
         Scene::WormholeSceneNode* XMLConfigParser::parseWormhole(QXmlStreamReader &xml) {
             //Default name is "Wormhole x", translated
-            static unsigned int id = 0;
+            unsigned int id = nextDefaultNameId(QStringLiteral("wormhole"));
             Scene::WormholeSceneNode *wh = new Scene::WormholeSceneNode(QCoreApplication::translate("XMLConfigParser", "Wormhole %1").arg(id));
 
-            while (!(xml.isEndElement() && xml.name() == "wormhole")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("wormhole"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "wormhole > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     wh->setName(xml.readElementText());
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     wh->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     wh->setRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
-                } else if (xml.name() == "destinationName") {
-                    wormholeDestMap[wh] = xml.readElementText();
+                } else if (tag == EnumXMLTag::DESTINATION_NAME) {
+                    wormholeDests.append(qMakePair(wh, xml.readElementText()));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: wormhole >" << xml.name();
                 }
             }
 
-            id++;
+            wormholes.append(wh);
 
             return wh;
         }
 
         Scene::SwitchSceneNode* XMLConfigParser::parseSwitch(QXmlStreamReader &xml) {
             //Default name is "Switch x", translated
-            static unsigned int id = 0;
+            unsigned int id = nextDefaultNameId(QStringLiteral("switch"));
             //Woo can't use switch as a variable name!
             Scene::SwitchSceneNode *sw = new Scene::SwitchSceneNode(QCoreApplication::translate("XMLConfigParser", "Switch %1").arg(id));
 
-            while (!(xml.isEndElement() && xml.name() == "switch")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("switch"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "switch > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     sw->setName(xml.readElementText());
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     sw->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     sw->setRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
-                } else if (xml.name() == "type") {
+                } else if (tag == EnumXMLTag::TYPE) {
                     sw->setType(PlaybackState::fromString(xml.readElementText()));
-                } else if (xml.name() == "animGroupId") {
+                } else if (tag == EnumXMLTag::ANIM_GROUP_ID) {
                     sw->setLinkedAnimGroupId(xml.readElementText().toUShort());
                 } else {
                     qWarning().noquote() << "Unrecognised tag: switch >" << xml.name();
                 }
             }
 
-            id++;
-
             return sw;
         }
 
@@ -679,22 +1153,23 @@ namespace WS2Common {
         Scene::MeshSceneNode* XMLConfigParser::parseStageModel(QXmlStreamReader &xml) {
             Scene::MeshSceneNode *mesh = new Scene::MeshSceneNode();
 
-            while (!(xml.isEndElement() && xml.name() == "stageModel")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("stageModel"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "stageModel > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     QString name = xml.readElementText();
                     mesh->setName(name);
                     mesh->setMeshName(name);
-                } else if (xml.name() == "runtimeReflective") {
+                } else if (tag == EnumXMLTag::RUNTIME_REFLECTIVE) {
                     mesh->setRuntimeReflective(xml.readElementText() == "true");
-                } else if (xml.name() == "collision") {
+                } else if (tag == EnumXMLTag::COLLISION) {
                     for (Scene::CollisionSceneNode *collision : parseCollision(xml)) mesh->addChild(collision);
-                } else if (xml.name() == "bitflag") {
+                } else if (tag == EnumXMLTag::BITFLAG) {
                     mesh->setBitflag(xml.readElementText().toUInt()); 
                 } else {
                     qWarning().noquote() << "Unrecognised tag: stageModel >" << xml.name();
@@ -707,14 +1182,15 @@ namespace WS2Common {
         QVector<Scene::CollisionSceneNode*> XMLConfigParser::parseCollision(QXmlStreamReader &xml) {
             QVector<Scene::CollisionSceneNode*> outNodes;
 
-            while (!(xml.isEndElement() && xml.name() == "collision")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("collision"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "collision > " << xml.name();
 
-                if (xml.name() == "meshCollision") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::MESH_COLLISION) {
                     outNodes.append(parseMeshCollision(xml));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: collision >" << xml.name();
@@ -727,18 +1203,19 @@ namespace WS2Common {
         Scene::MeshCollisionSceneNode* XMLConfigParser::parseMeshCollision(QXmlStreamReader &xml) {
             Scene::MeshCollisionSceneNode *node = new Scene::MeshCollisionSceneNode();
 
-            while (!(xml.isEndElement() && xml.name() == "meshCollision")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("meshCollision"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "meshCollision > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     QString name = xml.readElementText();
                     node->setName(QCoreApplication::translate("XMLConfigParser", "Mesh Collision: %1").arg(name));
                     node->setMeshName(name);
-                } else if (xml.name() == "collisionFlag") {
+                } else if (tag == EnumXMLTag::COLLISION_FLAG) {
                     node->setCollisionTriangleFlag(xml.readElementText().toShort());
                 } else {
                     qWarning().noquote() << "Unrecognised tag: meshCollision >" << xml.name();
@@ -751,19 +1228,20 @@ namespace WS2Common {
         CollisionGrid XMLConfigParser::parseCollisionGrid(QXmlStreamReader &xml) {
             CollisionGrid grid;
 
-            while (!(xml.isEndElement() && xml.name() == "collisionGrid")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("collisionGrid"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "collisionGrid > " << xml.name();
 
-                if (xml.name() == "start") {
-                    grid.setGridStart(SerializeUtils::getVec2Attributes(xml.attributes(), "x", "z"));
-                } else if (xml.name() == "step") {
-                    grid.setGridStep(SerializeUtils::getVec2Attributes(xml.attributes(), "x", "z"));
-                } else if (xml.name() == "count") {
-                    grid.setGridStepCount(SerializeUtils::getUVec2Attributes(xml.attributes(), "x", "z"));
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::START) {
+                    grid.setGridStart(SerializeUtils::getVec2Attributes(xml.attributes(), QLatin1String("x"), QLatin1String("z")));
+                } else if (tag == EnumXMLTag::STEP) {
+                    grid.setGridStep(SerializeUtils::getVec2Attributes(xml.attributes(), QLatin1String("x"), QLatin1String("z")));
+                } else if (tag == EnumXMLTag::COUNT) {
+                    grid.setGridStepCount(SerializeUtils::getUVec2Attributes(xml.attributes(), QLatin1String("x"), QLatin1String("z")));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: collisionGrid >" << xml.name();
                 }
@@ -792,35 +1270,37 @@ namespace WS2Common {
 
         Animation::TransformAnimation* XMLConfigParser::parseTransformAnimation(QXmlStreamReader &xml, bool supportsScale) {
             Animation::TransformAnimation *anim = new Animation::TransformAnimation;
+            anim->setKeyframeArena(keyframeArena);
 
-            while (!(xml.isEndElement() && xml.name() == "animKeyframes")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("animKeyframes"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "animKeyframes > " << xml.name();
 
-                if (xml.name() == "posX") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::POS_X) {
                     parseKeyframes(xml, anim->getPosXKeyframes());
-                } else if (xml.name() == "posY") {
+                } else if (tag == EnumXMLTag::POS_Y) {
                     parseKeyframes(xml, anim->getPosYKeyframes());
-                } else if (xml.name() == "posZ") {
+                } else if (tag == EnumXMLTag::POS_Z) {
                     parseKeyframes(xml, anim->getPosZKeyframes());
-                } else if (xml.name() == "rotX") {
+                } else if (tag == EnumXMLTag::ROT_X) {
                     parseKeyframes(xml, anim->getRotXKeyframes(), true);
-                } else if (xml.name() == "rotY") {
+                } else if (tag == EnumXMLTag::ROT_Y) {
                     parseKeyframes(xml, anim->getRotYKeyframes(), true);
-                } else if (xml.name() == "rotZ") {
+                } else if (tag == EnumXMLTag::ROT_Z) {
                     parseKeyframes(xml, anim->getRotZKeyframes(), true);
-                } else if (xml.name() == "scaleX" && supportsScale) {
+                } else if (tag == EnumXMLTag::SCALE_X && supportsScale) {
                     parseKeyframes(xml, anim->getScaleXKeyframes()); 
-                } else if (xml.name() == "scaleY" && supportsScale) {
+                } else if (tag == EnumXMLTag::SCALE_Y && supportsScale) {
                     parseKeyframes(xml, anim->getScaleYKeyframes()); 
-                } else if (xml.name() == "scaleZ" && supportsScale) {
+                } else if (tag == EnumXMLTag::SCALE_Z && supportsScale) {
                     parseKeyframes(xml, anim->getScaleZKeyframes()); 
-                } else if (xml.name() == "unknown1" && supportsScale) {
+                } else if (tag == EnumXMLTag::UNKNOWN1 && supportsScale) {
                     parseKeyframes(xml, anim->getUnknown1Keyframes());
-                } else if (xml.name() == "unknown2" && supportsScale) {
+                } else if (tag == EnumXMLTag::UNKNOWN2 && supportsScale) {
                     parseKeyframes(xml, anim->getUnknown2Keyframes());
                 } else {
                     qWarning().noquote() << "Unrecognised tag: animKeyframes >" << xml.name();
@@ -834,25 +1314,26 @@ namespace WS2Common {
         {
             Fog* fog = new Fog();
 
-            while (!(xml.isEndElement() && xml.name() == "fog")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("fog"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                 "fog > " << xml.name();
 
-                if (xml.name() == "type") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::TYPE) {
                     fog->setFogType(FogType::fromString(xml.readElementText()));
-                } else if (xml.name() == "red") {
-                    fog->setRedValue(xml.readElementText().toFloat());
-                } else if (xml.name() == "green") {
-                    fog->setGreenValue(xml.readElementText().toFloat());
-                } else if (xml.name() == "blue") {
-                    fog->setBlueValue(xml.readElementText().toFloat());
-                } else if (xml.name() == "start") {
-                    fog->setStartDistance(xml.readElementText().toFloat());
-                } else if (xml.name() == "end") {
-                    fog->setEndDistance(xml.readElementText().toFloat());
+                } else if (tag == EnumXMLTag::RED) {
+                    fog->setRedValue(SerializeUtils::parseFloat(xml.readElementText()));
+                } else if (tag == EnumXMLTag::GREEN) {
+                    fog->setGreenValue(SerializeUtils::parseFloat(xml.readElementText()));
+                } else if (tag == EnumXMLTag::BLUE) {
+                    fog->setBlueValue(SerializeUtils::parseFloat(xml.readElementText()));
+                } else if (tag == EnumXMLTag::START) {
+                    fog->setStartDistance(SerializeUtils::parseFloat(xml.readElementText()));
+                } else if (tag == EnumXMLTag::END) {
+                    fog->setEndDistance(SerializeUtils::parseFloat(xml.readElementText()));
                 } else {
                     qWarning().noquote() << "Unrecgonised tag: fog > " << xml.name();
                 }
@@ -865,25 +1346,27 @@ namespace WS2Common {
         Animation::FogAnimation* XMLConfigParser::parseFogAnimation(QXmlStreamReader &xml)
         {
             Animation::FogAnimation* anim = new Animation::FogAnimation;
+            anim->setKeyframeArena(keyframeArena);
 
-            while (!(xml.isEndElement() && xml.name() == "fogAnimationKeyframes")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("fogAnimationKeyframes"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "fogAnimationKeyframes > " << xml.name();
 
-                if (xml.name() == "red") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::RED) {
                     parseKeyframes(xml, anim->getRedKeyframes());
-                } else if (xml.name() == "green") {
+                } else if (tag == EnumXMLTag::GREEN) {
                     parseKeyframes(xml, anim->getGreenKeyframes());
-                } else if (xml.name() == "blue") {
+                } else if (tag == EnumXMLTag::BLUE) {
                     parseKeyframes(xml, anim->getBlueKeyframes());
-                } else if (xml.name() == "start") {
+                } else if (tag == EnumXMLTag::START) {
                     parseKeyframes(xml, anim->getStartDistanceKeyframes());
-                } else if (xml.name() == "end") {
+                } else if (tag == EnumXMLTag::END) {
                     parseKeyframes(xml, anim->getEndDistanceKeyframes());
-                } else if (xml.name() == "unknown") {
+                } else if (tag == EnumXMLTag::UNKNOWN) {
                     parseKeyframes(xml, anim->getUnknownKeyframes());
                 } else {
                     qWarning().noquote() << "Unrecognised tag: fogAnimationKeyframes >" << xml.name();
@@ -897,29 +1380,28 @@ namespace WS2Common {
         Scene::BoosterSceneNode *XMLConfigParser::parseBooster(QXmlStreamReader &xml)
         {
             //Default name is "Booster x", translated
-            static unsigned int id = 0;
+            unsigned int id = nextDefaultNameId(QStringLiteral("booster"));
             Scene::BoosterSceneNode *booster = new Scene::BoosterSceneNode(QCoreApplication::translate("XMLConfigParser", "Booster %1").arg(id));
 
-            while (!(xml.isEndElement() && xml.name() == "booster")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("booster"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "booster > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     booster->setName(xml.readElementText());
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     booster->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     booster->setRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: booster >" << xml.name();
                 }
             }
 
-            id++;
-
             return booster;
         }
 
@@ -927,77 +1409,79 @@ namespace WS2Common {
         {
 
             //Default name is "GolfHole x", translated
-            static unsigned int id = 0;
+            unsigned int id = nextDefaultNameId(QStringLiteral("golfHole"));
             Scene::GolfHoleSceneNode *golfHole = new Scene::GolfHoleSceneNode(QCoreApplication::translate("XMLConfigParser", "GolfHole %1").arg(id));
 
-            while (!(xml.isEndElement() && xml.name() == "golfHole")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("golfHole"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "golfHole > " << xml.name();
 
-                if (xml.name() == "name") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::NAME) {
                     golfHole->setName(xml.readElementText());
-                } else if (xml.name() == "position") {
+                } else if (tag == EnumXMLTag::POSITION) {
                     golfHole->setPosition(SerializeUtils::getVec3Attributes(xml.attributes()));
-                } else if (xml.name() == "rotation") {
+                } else if (tag == EnumXMLTag::ROTATION) {
                     golfHole->setRotation(MathUtils::degreesToRadians(SerializeUtils::getVec3Attributes(xml.attributes())));
                 } else {
                     qWarning().noquote() << "Unrecognised tag: golfHole >" << xml.name();
                 }
             }
 
-            id++;
-
             return golfHole;
         }
 
        Scene::RaceTrackPathSceneNode* XMLConfigParser::parseTrackPath(QXmlStreamReader &xml)
         {
-            static unsigned int id = 0;
+            unsigned int id = nextDefaultNameId(QStringLiteral("trackPath"));
             Scene::RaceTrackPathSceneNode *node = new Scene::RaceTrackPathSceneNode(QCoreApplication::translate("XMLConfigParser", "RaceTrackPath %1").arg(id));
             Animation::RaceTrackPath *trackPath = new Animation::RaceTrackPath();
+            trackPath->setKeyframeArena(keyframeArena);
             node->setTrackPath(trackPath);
 
-            while (!(xml.isEndElement() && xml.name() == "trackPath")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("trackPath"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "trackPath > " << xml.name();
 
-                if (xml.name() == "posX") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::POS_X) {
                     parseKeyframes(xml, node->getTrackPath()->getPosXKeyframes());
-                } else if (xml.name() == "posY") {
+                } else if (tag == EnumXMLTag::POS_Y) {
                     parseKeyframes(xml, node->getTrackPath()->getPosYKeyframes());
-                } else if (xml.name() == "posZ") {
+                } else if (tag == EnumXMLTag::POS_Z) {
                     parseKeyframes(xml, node->getTrackPath()->getPosZKeyframes());
-                } else if (xml.name() == "playerID") {
+                } else if (tag == EnumXMLTag::PLAYER_ID) {
                     node->getTrackPath()->setPlayerID(xml.readElementText().toUInt());
                 } else {
                     qWarning().noquote() << "Unrecognised tag: trackPath >" << xml.name();
                 }
             }
 
-            id++;
             return node;
        }
 
        Animation::EffectAnimation *XMLConfigParser::parseEffectAnimation(QXmlStreamReader &xml)
        {
             Animation::EffectAnimation* anim = new Animation::EffectAnimation;
+            anim->setKeyframeArena(keyframeArena);
 
-            while (!(xml.isEndElement() && xml.name() == "effectKeyframes")) {
+            while (!(xml.isEndElement() && xml.name() == QLatin1String("effectKeyframes"))) {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     "effectKeyframes > " << xml.name();
 
-                if (xml.name() == "effectType1") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::EFFECT_TYPE1) {
                     parseEffectKeyframesType1(xml, anim->getEffect1Keyframes());
-                } else if (xml.name() == "effectType2") {
+                } else if (tag == EnumXMLTag::EFFECT_TYPE2) {
                     parseEffectKeyframesType2(xml, anim->getEffect2Keyframes());
                 } else {
                     qWarning().noquote() << "Unrecognised tag: effectKeyframes >" << xml.name();
@@ -1017,35 +1501,37 @@ namespace WS2Common {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     parentName << " > " << xml.name();
 
-                if (xml.name() == "keyframe") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::KEYFRAME) {
                     glm::vec3 position;
                     glm::vec3 rotation;
                     char unknownByte1;
                     char unknownByte2;
                     foreach(const QXmlStreamAttribute &attr, xml.attributes()) {
-                        if (attr.name() == "posX") {
-                            position.x = attr.value().toFloat();
-                        } else if (attr.name() == "posY") {
-                            position.y = attr.value().toFloat();
-                        } else if (attr.name() == "posZ") {
-                            position.z = attr.value().toFloat();
-                        } else if (attr.name() == "rotX") {
-                            rotation.x = attr.value().toFloat();
-                        } else if (attr.name() == "rotY") {
-                            rotation.y = attr.value().toFloat();
-                        } else if (attr.name() == "rotZ") {
-                            rotation.z = attr.value().toFloat();
-                        } else if (attr.name() == "unknownByte1") {
+                        EnumXMLTag attrTag = XMLTag::fromName(attr.name());
+                        if (attrTag == EnumXMLTag::POS_X) {
+                            position.x = SerializeUtils::parseFloat(attr.value());
+                        } else if (attrTag == EnumXMLTag::POS_Y) {
+                            position.y = SerializeUtils::parseFloat(attr.value());
+                        } else if (attrTag == EnumXMLTag::POS_Z) {
+                            position.z = SerializeUtils::parseFloat(attr.value());
+                        } else if (attrTag == EnumXMLTag::ROT_X) {
+                            rotation.x = SerializeUtils::parseFloat(attr.value());
+                        } else if (attrTag == EnumXMLTag::ROT_Y) {
+                            rotation.y = SerializeUtils::parseFloat(attr.value());
+                        } else if (attrTag == EnumXMLTag::ROT_Z) {
+                            rotation.z = SerializeUtils::parseFloat(attr.value());
+                        } else if (attrTag == EnumXMLTag::UNKNOWN_BYTE1) {
                             unknownByte1 = (char)attr.value().toUShort();
-                        } else if (attr.name() == "unknownByte2") {
+                        } else if (attrTag == EnumXMLTag::UNKNOWN_BYTE2) {
                             unknownByte2 = (char)attr.value().toUShort();
                         }
                     }
                     rotation = MathUtils::degreesToRadians(rotation);
-                    KeyframeEffect1 *k = new KeyframeEffect1(position, rotation, unknownByte1, unknownByte2);
+                    KeyframeEffect1 *k = createKeyframe<KeyframeEffect1>(keyframeArena.data(), position, rotation, unknownByte1, unknownByte2);
                     keyframes.append(k);
 
                 } else {
@@ -1064,33 +1550,35 @@ namespace WS2Common {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     parentName << " > " << xml.name();
 
-                if (xml.name() == "keyframe") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::KEYFRAME) {
                     glm::vec3 position;
                     char unknownByte1;
                     char unknownByte2;
                     char unknownByte3;
                     char unknownByte4;
                     foreach(const QXmlStreamAttribute &attr, xml.attributes()) {
-                        if (attr.name() == "posX") {
-                            position.x = attr.value().toFloat();
-                        } else if (attr.name() == "posY") {
-                            position.y = attr.value().toFloat();
-                        } else if (attr.name() == "posZ") {
-                            position.z = attr.value().toFloat();
-                        } else if (attr.name() == "unknownByte1") {
+                        EnumXMLTag attrTag = XMLTag::fromName(attr.name());
+                        if (attrTag == EnumXMLTag::POS_X) {
+                            position.x = SerializeUtils::parseFloat(attr.value());
+                        } else if (attrTag == EnumXMLTag::POS_Y) {
+                            position.y = SerializeUtils::parseFloat(attr.value());
+                        } else if (attrTag == EnumXMLTag::POS_Z) {
+                            position.z = SerializeUtils::parseFloat(attr.value());
+                        } else if (attrTag == EnumXMLTag::UNKNOWN_BYTE1) {
                             unknownByte1 = (char)attr.value().toUShort();
-                        } else if (attr.name() == "unknownByte2") {
+                        } else if (attrTag == EnumXMLTag::UNKNOWN_BYTE2) {
                             unknownByte2 = (char)attr.value().toUShort();
-                        } else if (attr.name() == "unknownByte3") {
+                        } else if (attrTag == EnumXMLTag::UNKNOWN_BYTE3) {
                             unknownByte3 = (char)attr.value().toUShort();
-                        } else if (attr.name() == "unknownByte4") {
+                        } else if (attrTag == EnumXMLTag::UNKNOWN_BYTE4) {
                             unknownByte4 = (char)attr.value().toUShort();
                         }
                     }
-                    KeyframeEffect2 *k = new KeyframeEffect2(position, unknownByte1, unknownByte2, unknownByte3, unknownByte4);
+                    KeyframeEffect2 *k = createKeyframe<KeyframeEffect2>(keyframeArena.data(), position, unknownByte1, unknownByte2, unknownByte3, unknownByte4);
                     keyframes.append(k);
 
                 } else {
@@ -1112,10 +1600,11 @@ namespace WS2Common {
                 xml.readNext();
                 if (!xml.isStartElement()) continue; //Ignore all end elements
 
-                qDebug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
+                ws2Debug().nospace() << "XML config parsing [Line: " << xml.lineNumber() << ", Col: " << xml.columnNumber() << "]: " <<
                     parentName << " > " << xml.name();
 
-                if (xml.name() == "keyframe") {
+                EnumXMLTag tag = XMLTag::fromName(xml.name());
+                if (tag == EnumXMLTag::KEYFRAME) {
                     float time;
                     float value;
                     float handleA = 0.0;
@@ -1124,23 +1613,24 @@ namespace WS2Common {
 
                     //Search through the attributes for time, value, and easing
                     foreach(const QXmlStreamAttribute &attr, xml.attributes()) {
-                        if (attr.name() == "time") {
-                            time = attr.value().toFloat();
-                        } else if (attr.name() == "value") {
-                            value = attr.value().toFloat();
+                        EnumXMLTag attrTag = XMLTag::fromName(attr.name());
+                        if (attrTag == EnumXMLTag::TIME) {
+                            time = SerializeUtils::parseFloat(attr.value());
+                        } else if (attrTag == EnumXMLTag::VALUE) {
+                            value = SerializeUtils::parseFloat(attr.value());
 
                             if (convertToRadians) value = qDegreesToRadians(value);
-                        } else if (attr.name() == "easing") {
+                        } else if (attrTag == EnumXMLTag::EASING) {
                             easing = Easing::fromString(attr.value().toString());
-                        } else if (attr.name() == "handleA") {
-                            handleA = attr.value().toFloat();
-                        } else if (attr.name() == "handleB") {
-                            handleB = attr.value().toFloat();
+                        } else if (attrTag == EnumXMLTag::HANDLE_A) {
+                            handleA = SerializeUtils::parseFloat(attr.value());
+                        } else if (attrTag == EnumXMLTag::HANDLE_B) {
+                            handleB = SerializeUtils::parseFloat(attr.value());
                         }
                     }
 
                     //Create the keyframe
-                    KeyframeF *k = new KeyframeF(time, value, easing);
+                    KeyframeF *k = createKeyframe<KeyframeF>(keyframeArena.data(), time, value, easing);
                     k->setHandleAValue(handleA);
                     k->setHandleBValue(handleB);
                     keyframes.insert(k);
@@ -0,0 +1,436 @@
+#include "ws2common/config/XMLConfigSchema.hpp"
+#include "ws2common/SerializeUtils.hpp"
+#include <QHash>
+#include <QStringList>
+#include <QtMath>
+#include <limits>
+
+namespace WS2Common {
+    namespace Config {
+        namespace XMLConfigSchema {
+            namespace {
+                const double ANY_MIN = std::numeric_limits<double>::lowest();
+                const double ANY_MAX = std::numeric_limits<double>::max();
+
+                const char * const STAGE_TYPE_NAMES[] = {
+                    "MAIN_GAME", "MONKEY_RACE_2", "MONKEY_FIGHT_2", "MONKEY_TARGET_2", "MONKEY_BILLIARDS_2",
+                    "MONKEY_BOWLING_2", "MONKEY_GOLF_2", "MONKEY_BOAT", "MONKEY_SHOT", "MONKEY_DOGFIGHT", "MONKEY_SOCCER",
+                    "MONKEY_BASEBALL", "CREDITS_GAME", nullptr
+                };
+                const char * const FOG_TYPE_NAMES[] = {
+                    "GX_FOG_NONE", "GX_FOG_LIN", "GX_FOG_EXP", "GX_FOG_EXP2", "GX_FOG_REVEXP", "GX_FOG_REVEXP2", nullptr
+                };
+                const char * const SEESAW_TYPE_NAMES[] = {"LOOPING_ANIMATION", "PLAY_ONCE_ANIMATION", "SEESAW", nullptr};
+                const char * const PLAYBACK_STATE_NAMES[] = {"PLAY", "PAUSE", "PLAY_BACKWARDS", "FAST_FORWARD", "REWIND", nullptr};
+                const char * const GOAL_TYPE_NAMES[] = {"BLUE", "GREEN", "RED", nullptr};
+                const char * const BANANA_TYPE_NAMES[] = {"SINGLE", "BUNCH", nullptr};
+                const char * const EASING_NAMES[] = {
+                    "EASED", "CUBIC", "CONSTANT", "QUADRATIC", "BOUNCE", "ELASTIC", "FREE", "LINEAR", nullptr
+                };
+
+                const ValueRule VALUE_ELEMENTS = {EnumValueType::ELEMENTS, 0.0, 0.0, nullptr};
+                const ValueRule VALUE_EMPTY = {EnumValueType::EMPTY, 0.0, 0.0, nullptr};
+                const ValueRule VALUE_TEXT = {EnumValueType::TEXT, 0.0, 0.0, nullptr};
+                const ValueRule VALUE_FLOAT = {EnumValueType::FLOAT, ANY_MIN, ANY_MAX, nullptr};
+                const ValueRule VALUE_UINT = {EnumValueType::INTEGER, 0.0, 4294967295.0, nullptr};
+                const ValueRule VALUE_POSITIVE_UINT = {EnumValueType::INTEGER, 1.0, 4294967295.0, nullptr};
+                const ValueRule VALUE_USHORT = {EnumValueType::INTEGER, 0.0, 65535.0, nullptr};
+                const ValueRule VALUE_SHORT = {EnumValueType::INTEGER, -32768.0, 32767.0, nullptr};
+                const ValueRule VALUE_UBYTE = {EnumValueType::INTEGER, 0.0, 255.0, nullptr};
+                const ValueRule VALUE_BOOL = {EnumValueType::BOOL, 0.0, 0.0, nullptr};
+                const ValueRule VALUE_STAGE_TYPE = {EnumValueType::ENUM, 0.0, 0.0, STAGE_TYPE_NAMES};
+                const ValueRule VALUE_FOG_TYPE = {EnumValueType::ENUM, 0.0, 0.0, FOG_TYPE_NAMES};
+                const ValueRule VALUE_SEESAW_TYPE = {EnumValueType::ENUM, 0.0, 0.0, SEESAW_TYPE_NAMES};
+                const ValueRule VALUE_PLAYBACK_STATE = {EnumValueType::ENUM, 0.0, 0.0, PLAYBACK_STATE_NAMES};
+                const ValueRule VALUE_GOAL_TYPE = {EnumValueType::ENUM, 0.0, 0.0, GOAL_TYPE_NAMES};
+                const ValueRule VALUE_BANANA_TYPE = {EnumValueType::ENUM, 0.0, 0.0, BANANA_TYPE_NAMES};
+                const ValueRule VALUE_EASING = {EnumValueType::ENUM, 0.0, 0.0, EASING_NAMES};
+                const ValueRule VALUE_VERSION = {EnumValueType::VERSION, 0.0, 0.0, nullptr};
+
+                //Attribute lists end with a nullptr name
+                const AttributeRule STAGE_ATTRS[] = {
+                    {"version", false, VALUE_VERSION},
+                    {nullptr, false, VALUE_EMPTY}
+                };
+                const AttributeRule XYZ_ATTRS[] = {
+                    {"x", true, VALUE_FLOAT},
+                    {"y", true, VALUE_FLOAT},
+                    {"z", true, VALUE_FLOAT},
+                    {nullptr, false, VALUE_EMPTY}
+                };
+                const AttributeRule XY_ATTRS[] = {
+                    {"x", true, VALUE_FLOAT},
+                    {"y", true, VALUE_FLOAT},
+                    {nullptr, false, VALUE_EMPTY}
+                };
+                const AttributeRule Y_ATTRS[] = {
+                    {"y", true, VALUE_FLOAT},
+                    {nullptr, false, VALUE_EMPTY}
+                };
+                const AttributeRule XZ_ATTRS[] = {
+                    {"x", true, VALUE_FLOAT},
+                    {"z", true, VALUE_FLOAT},
+                    {nullptr, false, VALUE_EMPTY}
+                };
+                const AttributeRule GRID_COUNT_ATTRS[] = {
+                    {"x", true, VALUE_POSITIVE_UINT},
+                    {"z", true, VALUE_POSITIVE_UINT},
+                    {nullptr, false, VALUE_EMPTY}
+                };
+                const AttributeRule KEYFRAME_ATTRS[] = {
+                    {"time", true, VALUE_FLOAT},
+                    {"value", true, VALUE_FLOAT},
+                    {"easing", false, VALUE_EASING},
+                    {"handleA", false, VALUE_FLOAT},
+                    {"handleB", false, VALUE_FLOAT},
+                    {nullptr, false, VALUE_EMPTY}
+                };
+                const AttributeRule EFFECT1_KEYFRAME_ATTRS[] = {
+                    {"posX", true, VALUE_FLOAT},
+                    {"posY", true, VALUE_FLOAT},
+                    {"posZ", true, VALUE_FLOAT},
+                    {"rotX", true, VALUE_FLOAT},
+                    {"rotY", true, VALUE_FLOAT},
+                    {"rotZ", true, VALUE_FLOAT},
+                    {"unknownByte1", true, VALUE_UBYTE},
+                    {"unknownByte2", true, VALUE_UBYTE},
+                    {nullptr, false, VALUE_EMPTY}
+                };
+                const AttributeRule EFFECT2_KEYFRAME_ATTRS[] = {
+                    {"posX", true, VALUE_FLOAT},
+                    {"posY", true, VALUE_FLOAT},
+                    {"posZ", true, VALUE_FLOAT},
+                    {"unknownByte1", true, VALUE_UBYTE},
+                    {"unknownByte2", true, VALUE_UBYTE},
+                    {"unknownByte3", true, VALUE_UBYTE},
+                    {"unknownByte4", true, VALUE_UBYTE},
+                    {nullptr, false, VALUE_EMPTY}
+                };
+
+                //Shorthand for the rule table below
+                const EnumXMLTag ANY = EnumXMLTag::UNRECOGNISED;
+                typedef EnumXMLTag T;
+
+                /**
+                 * @brief Every element XMLConfigParser reads, by where it may appear
+                 *
+                 * The root element has UNRECOGNISED as its parent.
+                 */
+                const ElementRule ELEMENT_RULES[] = {
+                    {ANY, ANY, T::SUPER_MONKEY_BALL_STAGE, VALUE_ELEMENTS, STAGE_ATTRS},
+
+                    //superMonkeyBallStage
+                    {T::SUPER_MONKEY_BALL_STAGE, ANY, T::MODEL_IMPORT, VALUE_TEXT, nullptr},
+                    {T::SUPER_MONKEY_BALL_STAGE, ANY, T::START, VALUE_ELEMENTS, nullptr},
+                    {T::SUPER_MONKEY_BALL_STAGE, ANY, T::BACKGROUND_MODEL, VALUE_ELEMENTS, nullptr},
+                    {T::SUPER_MONKEY_BALL_STAGE, ANY, T::FOREGROUND_MODEL, VALUE_ELEMENTS, nullptr},
+                    {T::SUPER_MONKEY_BALL_STAGE, ANY, T::FALLOUT_PLANE, VALUE_EMPTY, Y_ATTRS},
+                    {T::SUPER_MONKEY_BALL_STAGE, ANY, T::STAGE_TYPE, VALUE_STAGE_TYPE, nullptr},
+                    {T::SUPER_MONKEY_BALL_STAGE, ANY, T::FOG, VALUE_ELEMENTS, nullptr},
+                    {T::SUPER_MONKEY_BALL_STAGE, ANY, T::FOG_ANIMATION_KEYFRAMES, VALUE_ELEMENTS, nullptr},
+                    {T::SUPER_MONKEY_BALL_STAGE, ANY, T::ITEM_GROUP, VALUE_ELEMENTS, nullptr},
+                    {T::SUPER_MONKEY_BALL_STAGE, ANY, T::TRACK_PATH, VALUE_ELEMENTS, nullptr},
+                    {T::SUPER_MONKEY_BALL_STAGE, ANY, T::BOOSTER, VALUE_ELEMENTS, nullptr},
+                    {T::SUPER_MONKEY_BALL_STAGE, ANY, T::GOLF_HOLE, VALUE_ELEMENTS, nullptr},
+
+                    //start
+                    {T::START, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::START, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::START, ANY, T::ROTATION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::START, ANY, T::PLAYER_ID, VALUE_UINT, nullptr},
+
+                    //backgroundModel
+                    {T::BACKGROUND_MODEL, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::BACKGROUND_MODEL, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::BACKGROUND_MODEL, ANY, T::ROTATION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::BACKGROUND_MODEL, ANY, T::SCALE, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::BACKGROUND_MODEL, ANY, T::MESH_TYPE, VALUE_UINT, nullptr},
+                    {T::BACKGROUND_MODEL, ANY, T::ANIM_KEYFRAMES, VALUE_ELEMENTS, nullptr},
+                    {T::BACKGROUND_MODEL, ANY, T::ANIM_LOOP_TIME, VALUE_FLOAT, nullptr},
+                    {T::BACKGROUND_MODEL, ANY, T::TEXTURE_SCROLL, VALUE_EMPTY, XY_ATTRS},
+                    {T::BACKGROUND_MODEL, ANY, T::EFFECT_KEYFRAMES, VALUE_ELEMENTS, nullptr},
+
+                    //foregroundModel
+                    {T::FOREGROUND_MODEL, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::FOREGROUND_MODEL, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::FOREGROUND_MODEL, ANY, T::ROTATION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::FOREGROUND_MODEL, ANY, T::SCALE, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::FOREGROUND_MODEL, ANY, T::MESH_TYPE, VALUE_UINT, nullptr},
+                    {T::FOREGROUND_MODEL, ANY, T::ANIM_KEYFRAMES, VALUE_ELEMENTS, nullptr},
+                    {T::FOREGROUND_MODEL, ANY, T::ANIM_LOOP_TIME, VALUE_FLOAT, nullptr},
+                    {T::FOREGROUND_MODEL, ANY, T::TEXTURE_SCROLL, VALUE_EMPTY, XY_ATTRS},
+                    {T::FOREGROUND_MODEL, ANY, T::EFFECT_KEYFRAMES, VALUE_ELEMENTS, nullptr},
+
+                    //animKeyframes - Only background and foreground models can be scaled
+                    {T::ANIM_KEYFRAMES, ANY, T::POS_X, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, ANY, T::POS_Y, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, ANY, T::POS_Z, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, ANY, T::ROT_X, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, ANY, T::ROT_Y, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, ANY, T::ROT_Z, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, T::BACKGROUND_MODEL, T::SCALE_X, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, T::BACKGROUND_MODEL, T::SCALE_Y, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, T::BACKGROUND_MODEL, T::SCALE_Z, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, T::BACKGROUND_MODEL, T::UNKNOWN1, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, T::BACKGROUND_MODEL, T::UNKNOWN2, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, T::FOREGROUND_MODEL, T::SCALE_X, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, T::FOREGROUND_MODEL, T::SCALE_Y, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, T::FOREGROUND_MODEL, T::SCALE_Z, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, T::FOREGROUND_MODEL, T::UNKNOWN1, VALUE_ELEMENTS, nullptr},
+                    {T::ANIM_KEYFRAMES, T::FOREGROUND_MODEL, T::UNKNOWN2, VALUE_ELEMENTS, nullptr},
+
+                    //Keyframe lists
+                    {T::POS_X, T::ANIM_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::POS_Y, T::ANIM_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::POS_Z, T::ANIM_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::ROT_X, T::ANIM_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::ROT_Y, T::ANIM_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::ROT_Z, T::ANIM_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::SCALE_X, T::ANIM_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::SCALE_Y, T::ANIM_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::SCALE_Z, T::ANIM_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::UNKNOWN1, T::ANIM_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::UNKNOWN2, T::ANIM_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::POS_X, T::TRACK_PATH, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::POS_Y, T::TRACK_PATH, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::POS_Z, T::TRACK_PATH, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::RED, T::FOG_ANIMATION_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::GREEN, T::FOG_ANIMATION_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::BLUE, T::FOG_ANIMATION_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::START, T::FOG_ANIMATION_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::END, T::FOG_ANIMATION_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+                    {T::UNKNOWN, T::FOG_ANIMATION_KEYFRAMES, T::KEYFRAME, VALUE_EMPTY, KEYFRAME_ATTRS},
+
+                    //effectKeyframes
+                    {T::EFFECT_KEYFRAMES, ANY, T::EFFECT_TYPE1, VALUE_ELEMENTS, nullptr},
+                    {T::EFFECT_KEYFRAMES, ANY, T::EFFECT_TYPE2, VALUE_ELEMENTS, nullptr},
+                    {T::EFFECT_TYPE1, ANY, T::KEYFRAME, VALUE_EMPTY, EFFECT1_KEYFRAME_ATTRS},
+                    {T::EFFECT_TYPE2, ANY, T::KEYFRAME, VALUE_EMPTY, EFFECT2_KEYFRAME_ATTRS},
+
+                    //itemGroup
+                    {T::ITEM_GROUP, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::ITEM_GROUP, ANY, T::ROTATION_CENTER, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::ITEM_GROUP, ANY, T::INITIAL_ROTATION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::ITEM_GROUP, ANY, T::ANIM_SEESAW_TYPE, VALUE_SEESAW_TYPE, nullptr},
+                    {T::ITEM_GROUP, ANY, T::CONVEYOR_SPEED, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::ITEM_GROUP, ANY, T::SEESAW_SENSITIVITY, VALUE_FLOAT, nullptr},
+                    {T::ITEM_GROUP, ANY, T::SEESAW_RESET_STIFFNESS, VALUE_FLOAT, nullptr},
+                    {T::ITEM_GROUP, ANY, T::SEESAW_FRICTION, VALUE_FLOAT, nullptr},
+                    {T::ITEM_GROUP, ANY, T::SEESAW_ROTATION_BOUNDS, VALUE_FLOAT, nullptr},
+                    {T::ITEM_GROUP, ANY, T::SEESAW_SPRING, VALUE_FLOAT, nullptr},
+                    {T::ITEM_GROUP, ANY, T::TEXTURE_SCROLL, VALUE_EMPTY, XY_ATTRS},
+                    {T::ITEM_GROUP, ANY, T::ANIM_KEYFRAMES, VALUE_ELEMENTS, nullptr},
+                    {T::ITEM_GROUP, ANY, T::ANIM_LOOP_TIME, VALUE_FLOAT, nullptr},
+                    {T::ITEM_GROUP, ANY, T::ANIM_GROUP_ID, VALUE_UINT, nullptr},
+                    {T::ITEM_GROUP, ANY, T::ANIM_INITIAL_STATE, VALUE_PLAYBACK_STATE, nullptr},
+                    {T::ITEM_GROUP, ANY, T::COLLISION_GRID, VALUE_ELEMENTS, nullptr},
+                    {T::ITEM_GROUP, ANY, T::GOAL, VALUE_ELEMENTS, nullptr},
+                    {T::ITEM_GROUP, ANY, T::BUMPER, VALUE_ELEMENTS, nullptr},
+                    {T::ITEM_GROUP, ANY, T::JAMABAR, VALUE_ELEMENTS, nullptr},
+                    {T::ITEM_GROUP, ANY, T::BANANA, VALUE_ELEMENTS, nullptr},
+                    {T::ITEM_GROUP, ANY, T::CONE, VALUE_ELEMENTS, nullptr},
+                    {T::ITEM_GROUP, ANY, T::SPHERE, VALUE_ELEMENTS, nullptr},
+                    {T::ITEM_GROUP, ANY, T::CYLINDER, VALUE_ELEMENTS, nullptr},
+                    {T::ITEM_GROUP, ANY, T::FALLOUT_VOLUME, VALUE_ELEMENTS, nullptr},
+                    {T::ITEM_GROUP, ANY, T::WORMHOLE, VALUE_ELEMENTS, nullptr},
+                    {T::ITEM_GROUP, ANY, T::SWITCH, VALUE_ELEMENTS, nullptr},
+                    {T::ITEM_GROUP, ANY, T::LEVEL_MODEL, VALUE_TEXT, nullptr},
+                    {T::ITEM_GROUP, ANY, T::STAGE_MODEL, VALUE_ELEMENTS, nullptr},
+
+                    //collisionGrid
+                    {T::COLLISION_GRID, ANY, T::START, VALUE_EMPTY, XZ_ATTRS},
+                    {T::COLLISION_GRID, ANY, T::STEP, VALUE_EMPTY, XZ_ATTRS},
+                    {T::COLLISION_GRID, ANY, T::COUNT, VALUE_EMPTY, GRID_COUNT_ATTRS},
+
+                    //goal
+                    {T::GOAL, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::GOAL, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::GOAL, ANY, T::ROTATION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::GOAL, ANY, T::TYPE, VALUE_GOAL_TYPE, nullptr},
+                    {T::GOAL, ANY, T::CAST_SHADOW, VALUE_BOOL, nullptr},
+
+                    //bumper
+                    {T::BUMPER, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::BUMPER, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::BUMPER, ANY, T::ROTATION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::BUMPER, ANY, T::SCALE, VALUE_EMPTY, XYZ_ATTRS},
+
+                    //jamabar
+                    {T::JAMABAR, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::JAMABAR, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::JAMABAR, ANY, T::ROTATION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::JAMABAR, ANY, T::SCALE, VALUE_EMPTY, XYZ_ATTRS},
+
+                    //banana
+                    {T::BANANA, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::BANANA, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::BANANA, ANY, T::TYPE, VALUE_BANANA_TYPE, nullptr},
+
+                    //cone
+                    {T::CONE, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::CONE, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::CONE, ANY, T::ROTATION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::CONE, ANY, T::RADIUS, VALUE_FLOAT, nullptr},
+                    {T::CONE, ANY, T::HEIGHT, VALUE_FLOAT, nullptr},
+
+                    //sphere
+                    {T::SPHERE, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::SPHERE, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::SPHERE, ANY, T::RADIUS, VALUE_FLOAT, nullptr},
+
+                    //cylinder
+                    {T::CYLINDER, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::CYLINDER, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::CYLINDER, ANY, T::ROTATION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::CYLINDER, ANY, T::RADIUS, VALUE_FLOAT, nullptr},
+                    {T::CYLINDER, ANY, T::HEIGHT, VALUE_FLOAT, nullptr},
+
+                    //falloutVolume
+                    {T::FALLOUT_VOLUME, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::FALLOUT_VOLUME, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::FALLOUT_VOLUME, ANY, T::ROTATION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::FALLOUT_VOLUME, ANY, T::SCALE, VALUE_EMPTY, XYZ_ATTRS},
+
+                    //wormhole
+                    {T::WORMHOLE, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::WORMHOLE, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::WORMHOLE, ANY, T::ROTATION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::WORMHOLE, ANY, T::DESTINATION_NAME, VALUE_TEXT, nullptr},
+
+                    //switch
+                    {T::SWITCH, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::SWITCH, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::SWITCH, ANY, T::ROTATION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::SWITCH, ANY, T::TYPE, VALUE_PLAYBACK_STATE, nullptr},
+                    {T::SWITCH, ANY, T::ANIM_GROUP_ID, VALUE_USHORT, nullptr},
+
+                    //stageModel
+                    {T::STAGE_MODEL, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::STAGE_MODEL, ANY, T::RUNTIME_REFLECTIVE, VALUE_BOOL, nullptr},
+                    {T::STAGE_MODEL, ANY, T::COLLISION, VALUE_ELEMENTS, nullptr},
+                    {T::STAGE_MODEL, ANY, T::BITFLAG, VALUE_UINT, nullptr},
+                    {T::COLLISION, T::STAGE_MODEL, T::MESH_COLLISION, VALUE_ELEMENTS, nullptr},
+                    {T::MESH_COLLISION, T::COLLISION, T::NAME, VALUE_TEXT, nullptr},
+                    {T::MESH_COLLISION, T::COLLISION, T::COLLISION_FLAG, VALUE_SHORT, nullptr},
+
+                    //fog
+                    {T::FOG, ANY, T::TYPE, VALUE_FOG_TYPE, nullptr},
+                    {T::FOG, ANY, T::RED, VALUE_FLOAT, nullptr},
+                    {T::FOG, ANY, T::GREEN, VALUE_FLOAT, nullptr},
+                    {T::FOG, ANY, T::BLUE, VALUE_FLOAT, nullptr},
+                    {T::FOG, ANY, T::START, VALUE_FLOAT, nullptr},
+                    {T::FOG, ANY, T::END, VALUE_FLOAT, nullptr},
+
+                    //fogAnimationKeyframes
+                    {T::FOG_ANIMATION_KEYFRAMES, ANY, T::RED, VALUE_ELEMENTS, nullptr},
+                    {T::FOG_ANIMATION_KEYFRAMES, ANY, T::GREEN, VALUE_ELEMENTS, nullptr},
+                    {T::FOG_ANIMATION_KEYFRAMES, ANY, T::BLUE, VALUE_ELEMENTS, nullptr},
+                    {T::FOG_ANIMATION_KEYFRAMES, ANY, T::START, VALUE_ELEMENTS, nullptr},
+                    {T::FOG_ANIMATION_KEYFRAMES, ANY, T::END, VALUE_ELEMENTS, nullptr},
+                    {T::FOG_ANIMATION_KEYFRAMES, ANY, T::UNKNOWN, VALUE_ELEMENTS, nullptr},
+
+                    //trackPath
+                    {T::TRACK_PATH, ANY, T::POS_X, VALUE_ELEMENTS, nullptr},
+                    {T::TRACK_PATH, ANY, T::POS_Y, VALUE_ELEMENTS, nullptr},
+                    {T::TRACK_PATH, ANY, T::POS_Z, VALUE_ELEMENTS, nullptr},
+                    {T::TRACK_PATH, ANY, T::PLAYER_ID, VALUE_UINT, nullptr},
+
+                    //booster
+                    {T::BOOSTER, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::BOOSTER, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::BOOSTER, ANY, T::ROTATION, VALUE_EMPTY, XYZ_ATTRS},
+
+                    //golfHole
+                    {T::GOLF_HOLE, ANY, T::NAME, VALUE_TEXT, nullptr},
+                    {T::GOLF_HOLE, ANY, T::POSITION, VALUE_EMPTY, XYZ_ATTRS},
+                    {T::GOLF_HOLE, ANY, T::ROTATION, VALUE_EMPTY, XYZ_ATTRS}
+                };
+
+                quint32 makeKey(EnumXMLTag grandparent, EnumXMLTag parent, EnumXMLTag name) {
+                    //There are well under 1024 tags, so 10 bits each is plenty
+                    return ((quint32) grandparent << 20) | ((quint32) parent << 10) | (quint32) name;
+                }
+
+                const QHash<quint32, const ElementRule*>& getRuleIndex() {
+                    static const QHash<quint32, const ElementRule*> index = [] {
+                        QHash<quint32, const ElementRule*> rules;
+                        for (const ElementRule &rule : ELEMENT_RULES) {
+                            rules.insert(makeKey(rule.grandparent, rule.parent, rule.name), &rule);
+                        }
+                        return rules;
+                    }();
+
+                    return index;
+                }
+            }
+
+            const ElementRule* findElementRule(EnumXMLTag grandparent, EnumXMLTag parent, EnumXMLTag name) {
+                const QHash<quint32, const ElementRule*> &index = getRuleIndex();
+
+                //Rules for a specific grandparent win over ones for any grandparent
+                const ElementRule *rule = index.value(makeKey(grandparent, parent, name));
+                if (rule == nullptr) rule = index.value(makeKey(EnumXMLTag::UNRECOGNISED, parent, name));
+
+                return rule;
+            }
+
+            const AttributeRule* findAttributeRule(const ElementRule &element, const QStringRef &name) {
+                if (element.attributes == nullptr) return nullptr;
+
+                for (const AttributeRule *attr = element.attributes; attr->name != nullptr; attr++) {
+                    if (name == QLatin1String(attr->name)) return attr;
+                }
+
+                return nullptr;
+            }
+
+            QString checkValue(const ValueRule &rule, const QStringRef &value) {
+                switch (rule.type) {
+                    case EnumValueType::FLOAT: {
+                        bool ok;
+                        float f = SerializeUtils::parseFloat(value, &ok);
+                        if (!ok || !qIsFinite(f)) return QString("\"%1\" isn't a number").arg(value.toString());
+                        if (f < rule.min || f > rule.max) {
+                            return QString("%1 is out of range (%2 to %3)").arg(value.toString()).arg(rule.min).arg(rule.max);
+                        }
+                        return QString();
+                    }
+                    case EnumValueType::INTEGER: {
+                        bool ok;
+                        qlonglong i = value.toLongLong(&ok);
+                        if (!ok) return QString("\"%1\" isn't a whole number").arg(value.toString());
+                        if (i < rule.min || i > rule.max) {
+                            return QString("%1 is out of range (%2 to %3)").arg(i).arg((qlonglong) rule.min).arg((qlonglong) rule.max);
+                        }
+                        return QString();
+                    }
+                    case EnumValueType::BOOL:
+                        if (value == QLatin1String("true") || value == QLatin1String("false")) return QString();
+                        return QString("\"%1\" should be true or false").arg(value.toString());
+                    case EnumValueType::ENUM: {
+                        QStringList names;
+                        for (const char * const *name = rule.enumNames; *name != nullptr; name++) {
+                            if (value == QLatin1String(*name)) return QString();
+                            names.append(*name);
+                        }
+                        return QString("\"%1\" should be one of %2").arg(value.toString()).arg(names.join(", "));
+                    }
+                    case EnumValueType::VERSION:
+                        foreach(const QStringRef &part, value.split('.')) {
+                            bool allDigits = !part.isEmpty();
+                            for (QChar c : part) allDigits = allDigits && c.isDigit();
+                            if (!allDigits) return QString("\"%1\" isn't a version number (Such as 1.3.0)").arg(value.toString());
+                        }
+                        return QString();
+                    case EnumValueType::ELEMENTS:
+                    case EnumValueType::EMPTY:
+                    case EnumValueType::TEXT:
+                        break;
+                }
+
+                return QString();
+            }
+        }
+    }
+}
+
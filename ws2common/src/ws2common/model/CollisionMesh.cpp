@@ -0,0 +1,110 @@
+#include "ws2common/model/CollisionMesh.hpp"
+
+namespace WS2Common {
+    namespace Model {
+        void CollisionMesh::reserve(int vertexCount, int indexCount) {
+            positionsX.reserve(vertexCount);
+            positionsY.reserve(vertexCount);
+            positionsZ.reserve(vertexCount);
+            indices.reserve(indexCount);
+        }
+
+        void CollisionMesh::append(
+                const QVector<Vertex> &vertices,
+                const QVector<unsigned int> &indices,
+                const glm::mat4 &transform
+                ) {
+            int firstVertex = positionsX.size();
+            int vertexCount = vertices.size();
+            int firstIndex = this->indices.size();
+            int indexCount = indices.size();
+
+            positionsX.resize(firstVertex + vertexCount);
+            positionsY.resize(firstVertex + vertexCount);
+            positionsZ.resize(firstVertex + vertexCount);
+            this->indices.resize(firstIndex + indexCount);
+
+            const Vertex *src = vertices.constData();
+            float *dstX = positionsX.data() + firstVertex;
+            float *dstY = positionsY.data() + firstVertex;
+            float *dstZ = positionsZ.data() + firstVertex;
+
+            if (transform == glm::mat4(1.0f)) {
+                //Copy positions exactly as they are
+                for (int i = 0; i < vertexCount; i++) {
+                    dstX[i] = src[i].position.x;
+                    dstY[i] = src[i].position.y;
+                    dstZ[i] = src[i].position.z;
+                }
+            } else {
+                //Hoist the matrix out of the loop - Same as ModelLoader::transformVertices
+                const float m00 = transform[0][0], m01 = transform[0][1], m02 = transform[0][2];
+                const float m10 = transform[1][0], m11 = transform[1][1], m12 = transform[1][2];
+                const float m20 = transform[2][0], m21 = transform[2][1], m22 = transform[2][2];
+                const float m30 = transform[3][0], m31 = transform[3][1], m32 = transform[3][2];
+
+                for (int i = 0; i < vertexCount; i++) {
+                    float x = src[i].position.x;
+                    float y = src[i].position.y;
+                    float z = src[i].position.z;
+                    dstX[i] = m00 * x + m10 * y + m20 * z + m30;
+                    dstY[i] = m01 * x + m11 * y + m21 * z + m31;
+                    dstZ[i] = m02 * x + m12 * y + m22 * z + m32;
+                }
+            }
+
+            //Indices carry on from the vertices already in this mesh
+            const unsigned int *srcIndices = indices.constData();
+            quint32 *dstIndices = this->indices.data() + firstIndex;
+            for (int i = 0; i < indexCount; i++) {
+                dstIndices[i] = srcIndices[i] + firstVertex;
+            }
+        }
+
+        void CollisionMesh::append(const Resource::ResourceMesh &mesh, const glm::mat4 &transform) {
+            int vertexCount = positionsX.size();
+            int indexCount = indices.size();
+            foreach(const MeshSegment *seg, mesh.getMeshSegments()) {
+                vertexCount += seg->getVertices().size();
+                indexCount += seg->getIndices().size();
+            }
+            reserve(vertexCount, indexCount);
+
+            foreach(const MeshSegment *seg, mesh.getMeshSegments()) {
+                append(seg->getVertices(), seg->getIndices(), transform);
+            }
+        }
+
+        void CollisionMesh::clear() {
+            positionsX.clear();
+            positionsY.clear();
+            positionsZ.clear();
+            indices.clear();
+        }
+
+        int CollisionMesh::getVertexCount() const {
+            return positionsX.size();
+        }
+
+        int CollisionMesh::getTriangleCount() const {
+            return indices.size() / 3;
+        }
+
+        const QVector<float>& CollisionMesh::getPositionsX() const {
+            return positionsX;
+        }
+
+        const QVector<float>& CollisionMesh::getPositionsY() const {
+            return positionsY;
+        }
+
+        const QVector<float>& CollisionMesh::getPositionsZ() const {
+            return positionsZ;
+        }
+
+        const QVector<quint32>& CollisionMesh::getIndices() const {
+            return indices;
+        }
+    }
+}
+
@@ -0,0 +1,309 @@
+#include "ws2common/model/MeshCache.hpp"
+#include "ws2common/model/ModelLoader.hpp"
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSaveFile>
+#include <QBuffer>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <cstring>
+#include <utility>
+
+namespace WS2Common {
+    namespace Model {
+        namespace MeshCache {
+            /**
+             * @brief Bumped whenever the cache format or what ModelLoader imports changes, to invalidate old files
+             */
+            static const quint32 FORMAT_VERSION = 4;
+
+            /**
+             * @brief Written in native byte order - Reads back differently on a machine with another byte order
+             */
+            static const quint32 BYTE_ORDER_MARK = 0x01020304;
+
+            /**
+             * @brief Gets a key for everything that affects what is imported, other than the file itself
+             */
+            static QByteArray getRequirementsKey(const MeshRequirements *requirements) {
+                QByteArray key = requirements != nullptr ? requirements->toKey() : MeshRequirements::everything().toKey();
+                if (ModelLoader::isVertexWeldingEnabled()) key += "+weld";
+                return key;
+            }
+
+            /**
+             * @brief Gets a file's modification time and size, or -1 for both if it doesn't exist
+             */
+            static void getFileStamp(const QString &path, qint64 &lastModified, qint64 &size) {
+                QFileInfo info(path);
+                if (info.exists()) {
+                    lastModified = info.lastModified().toMSecsSinceEpoch();
+                    size = info.size();
+                } else {
+                    lastModified = -1;
+                    size = -1;
+                }
+            }
+
+            static QByteArray hashFile(const QString &path) {
+                QFile file(path);
+                if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+
+                QCryptographicHash hash(QCryptographicHash::Sha1);
+                hash.addData(&file);
+                return hash.result();
+            }
+
+            /**
+             * @brief Overwrites the source file modification time stored in a cache file, so the source isn't hashed
+             *        again on every load after it was touched without being changed
+             *
+             * @param cacheFilePath The cache file to update
+             * @param pos Where the modification time is stored in the cache file
+             * @param lastModified The source file's current modification time
+             */
+            static void updateStoredLastModified(const QString &cacheFilePath, qint64 pos, qint64 lastModified) {
+                QFile file(cacheFilePath);
+                if (!file.open(QIODevice::ReadWrite) || !file.seek(pos)) return;
+
+                //Written in place - a reader that catches it half written just hashes the source again
+                QDataStream out(&file);
+                out << lastModified;
+            }
+
+            /**
+             * @brief Copies count elements from the stream's current position in the mapped file, and skips past them
+             *
+             * @return Whether there was enough data left
+             */
+            template <class T>
+            static bool readRawArray(QDataStream &in, const uchar *mapped, qint64 mappedSize, quint32 count, QVector<T> &out) {
+                qint64 pos = in.device()->pos();
+                qint64 byteCount = (qint64) count * sizeof(T);
+                if (pos + byteCount > mappedSize) return false;
+
+                out.resize(count);
+                if (byteCount > 0) std::memcpy(out.data(), mapped + pos, byteCount);
+                return in.skipRawData(byteCount) == byteCount;
+            }
+
+            QString getCacheFilePath(
+                    const QString &cacheDirectory,
+                    const QString &sourcePath,
+                    const MeshRequirements *requirements
+                    ) {
+                QCryptographicHash hash(QCryptographicHash::Sha1);
+                hash.addData(QFileInfo(sourcePath).absoluteFilePath().toUtf8());
+                hash.addData(QByteArray(1, '\0'));
+                hash.addData(getRequirementsKey(requirements));
+
+                return QDir(cacheDirectory).filePath(QString::fromLatin1(hash.result().toHex()) + ".ws2mesh");
+            }
+
+            bool readCache(
+                    const QString &cacheFilePath,
+                    const QString &sourcePath,
+                    QVector<Resource::ResourceMesh*> &meshVector,
+                    const MeshRequirements *requirements,
+                    QVector<Resource::AbstractResource*> *resources,
+                    QMutex *resourcesMutex
+                    ) {
+                QFile file(cacheFilePath);
+                if (!file.open(QIODevice::ReadOnly)) return false;
+
+                qint64 mappedSize = file.size();
+                const uchar *mapped = file.map(0, mappedSize);
+                if (mapped == nullptr) return false;
+
+                //Read straight out of the mapped file without copying it
+                QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), mappedSize);
+                QBuffer buf(&data);
+                buf.open(QIODevice::ReadOnly);
+                QDataStream in(&buf);
+
+                char magic[4];
+                quint32 byteOrderMark = 0;
+                if (in.readRawData(magic, 4) != 4 || std::memcmp(magic, "WS2M", 4) != 0) return false;
+                if (in.readRawData(reinterpret_cast<char*>(&byteOrderMark), sizeof(quint32)) != sizeof(quint32)) return false;
+
+                quint32 version, vertexSize, indexSize;
+                QString storedSourcePath;
+                qint64 lastModified, size;
+                QByteArray contentHash, requirementsKey;
+                in >> version >> vertexSize >> indexSize >> storedSourcePath;
+                qint64 lastModifiedPos = in.device()->pos();
+                in >> lastModified >> size >> contentHash >> requirementsKey;
+
+                if (in.status() != QDataStream::Ok ||
+                        byteOrderMark != BYTE_ORDER_MARK ||
+                        version != FORMAT_VERSION ||
+                        vertexSize != sizeof(Vertex) ||
+                        indexSize != sizeof(unsigned int)) {
+                    return false;
+                }
+
+                QFileInfo sourceInfo(sourcePath);
+                if (storedSourcePath != sourceInfo.absoluteFilePath() || requirementsKey != getRequirementsKey(requirements)) {
+                    return false;
+                }
+
+                qint64 sourceLastModified = sourceInfo.lastModified().toMSecsSinceEpoch();
+                bool touched = sourceLastModified != lastModified;
+                if (touched || sourceInfo.size() != size) {
+                    //The file was touched - it may still have the same contents though (Such as after a checkout)
+                    if (sourceInfo.size() != size || hashFile(sourcePath) != contentHash) return false;
+                }
+
+                //Every other file the import read (Or looked for and didn't find) must be exactly as it was
+                quint32 dependencyCount;
+                in >> dependencyCount;
+                if (in.status() != QDataStream::Ok) return false;
+
+                for (quint32 i = 0; i < dependencyCount; i++) {
+                    QString dependencyPath;
+                    qint64 storedLastModified, storedSize;
+                    in >> dependencyPath >> storedLastModified >> storedSize;
+                    if (in.status() != QDataStream::Ok) return false;
+
+                    qint64 dependencyLastModified, dependencySize;
+                    getFileStamp(dependencyPath, dependencyLastModified, dependencySize);
+                    if (dependencyLastModified != storedLastModified || dependencySize != storedSize) return false;
+                }
+
+                //Read every mesh before creating any resources, so a truncated file doesn't leave half a model behind
+                struct CachedSegment {
+                    QVector<Vertex> vertices;
+                    QVector<unsigned int> indices;
+                    QStringList texturePaths;
+                };
+
+                struct CachedMesh {
+                    QString id;
+                    QVector<CachedSegment> segments;
+                };
+
+                quint32 meshCount;
+                in >> meshCount;
+                if (in.status() != QDataStream::Ok) return false;
+
+                QVector<CachedMesh> cachedMeshes;
+                for (quint32 i = 0; i < meshCount; i++) {
+                    CachedMesh mesh;
+                    quint32 segmentCount;
+                    in >> mesh.id >> segmentCount;
+                    if (in.status() != QDataStream::Ok) return false;
+
+                    for (quint32 j = 0; j < segmentCount; j++) {
+                        CachedSegment segment;
+                        quint32 vertexCount, indexCount;
+                        in >> vertexCount >> indexCount >> segment.texturePaths;
+                        if (in.status() != QDataStream::Ok) return false;
+
+                        if (!readRawArray(in, mapped, mappedSize, vertexCount, segment.vertices)) return false;
+                        if (!readRawArray(in, mapped, mappedSize, indexCount, segment.indices)) return false;
+
+                        mesh.segments.append(std::move(segment));
+                    }
+
+                    cachedMeshes.append(std::move(mesh));
+                }
+
+                //Everything has been copied out of the mapped file by now
+                file.unmap(const_cast<uchar*>(mapped));
+                file.close();
+
+                //The contents still match, so remember the new modification time to skip hashing next time
+                if (touched) updateStoredLastModified(cacheFilePath, lastModifiedPos, sourceLastModified);
+
+                //Now build the meshes, in the same order ModelLoader::processNode would have
+                for (CachedMesh &cachedMesh : cachedMeshes) {
+                    Resource::ResourceMesh *resMesh = new Resource::ResourceMesh();
+                    resMesh->setId(cachedMesh.id);
+                    resMesh->setFilePath(sourcePath);
+
+                    for (CachedSegment &cachedSegment : cachedMesh.segments) {
+                        QVector<Resource::ResourceTexture*> textures;
+                        foreach(const QString &texturePath, cachedSegment.texturePaths) {
+                            Resource::ResourceTexture *texture = ModelLoader::getOrCreateTexture(texturePath, resources, resourcesMutex);
+                            if (!textures.contains(texture)) textures.append(texture);
+                        }
+
+                        resMesh->addMeshSegment(new MeshSegment(std::move(cachedSegment.vertices), std::move(cachedSegment.indices), std::move(textures)));
+                    }
+
+                    if (resources != nullptr) {
+                        if (resourcesMutex != nullptr) resourcesMutex->lock();
+                        resources->append(resMesh);
+                        if (resourcesMutex != nullptr) resourcesMutex->unlock();
+                    }
+
+                    meshVector.append(resMesh);
+                }
+
+                return true;
+            }
+
+            bool writeCache(
+                    const QString &cacheFilePath,
+                    const QString &sourcePath,
+                    const QVector<Resource::ResourceMesh*> &meshVector,
+                    const MeshRequirements *requirements,
+                    const QStringList &dependencies
+                    ) {
+                QFileInfo sourceInfo(sourcePath);
+
+                //QSaveFile only replaces the old file once everything is written, so a crash can't leave half a cache file
+                QSaveFile file(cacheFilePath);
+                if (!file.open(QIODevice::WriteOnly)) {
+                    qWarning().noquote() << "Failed to write mesh cache file" << cacheFilePath << "-" << file.errorString();
+                    return false;
+                }
+
+                QDataStream out(&file);
+
+                out.writeRawData("WS2M", 4);
+                out.writeRawData(reinterpret_cast<const char*>(&BYTE_ORDER_MARK), sizeof(quint32));
+                out << FORMAT_VERSION << (quint32) sizeof(Vertex) << (quint32) sizeof(unsigned int);
+                out << sourceInfo.absoluteFilePath() << (qint64) sourceInfo.lastModified().toMSecsSinceEpoch() <<
+                    (qint64) sourceInfo.size() << hashFile(sourcePath) << getRequirementsKey(requirements);
+
+                out << (quint32) dependencies.size();
+                foreach(const QString &dependencyPath, dependencies) {
+                    qint64 lastModified, size;
+                    getFileStamp(dependencyPath, lastModified, size);
+                    out << dependencyPath << lastModified << size;
+                }
+
+                out << (quint32) meshVector.size();
+                foreach(const Resource::ResourceMesh *mesh, meshVector) {
+                    out << mesh->getId() << (quint32) mesh->getMeshSegments().size();
+
+                    foreach(const MeshSegment *segment, mesh->getMeshSegments()) {
+                        QStringList texturePaths;
+                        foreach(const Resource::ResourceTexture *texture, segment->getTextures()) {
+                            texturePaths.append(texture->getFilePaths().isEmpty() ? texture->getId() : texture->getFilePaths().first());
+                        }
+
+                        const QVector<Vertex> &vertices = segment->getVertices();
+                        const QVector<unsigned int> &indices = segment->getIndices();
+
+                        out << (quint32) vertices.size() << (quint32) indices.size() << texturePaths;
+                        out.writeRawData(reinterpret_cast<const char*>(vertices.constData()), vertices.size() * sizeof(Vertex));
+                        out.writeRawData(reinterpret_cast<const char*>(indices.constData()), indices.size() * sizeof(unsigned int));
+                    }
+                }
+
+                if (!file.commit()) {
+                    qWarning().noquote() << "Failed to write mesh cache file" << cacheFilePath << "-" << file.errorString();
+                    return false;
+                }
+
+                return true;
+            }
+        }
+    }
+}
+
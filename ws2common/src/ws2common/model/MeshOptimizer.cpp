@@ -0,0 +1,241 @@
+#include "ws2common/model/MeshOptimizer.hpp"
+#include <QHash>
+#include <algorithm>
+#include <math.h>
+
+namespace WS2Common {
+    namespace Model {
+        namespace MeshOptimizer {
+                /**
+                 * @brief Quantization steps for welding - Vertices within a step of each other (In each component) may
+                 *        be merged
+                 */
+                static const float POSITION_QUANTIZATION = 1.0f / 65536.0f;
+                static const float NORMAL_QUANTIZATION = 1.0f / 1024.0f;
+                static const float TEX_COORD_QUANTIZATION = 1.0f / 65536.0f;
+
+                /**
+                 * @brief A vertex with each attribute quantized, for hashing
+                 */
+                struct WeldKey {
+                    qint32 values[8];
+
+                    bool operator==(const WeldKey &other) const {
+                        return std::equal(values, values + 8, other.values);
+                    }
+                };
+
+                static uint qHash(const WeldKey &key, uint seed = 0) {
+                    uint hash = seed;
+                    for (int i = 0; i < 8; i++) hash = hash * 31 + (uint) key.values[i];
+                    return hash;
+                }
+
+                static qint32 quantize(float value, float step) {
+                    return (qint32) floorf(value / step + 0.5f);
+                }
+
+                int weldVertices(QVector<Vertex> &vertices, QVector<unsigned int> &indices) {
+                    for (unsigned int index : indices) {
+                        if (index >= (unsigned int) vertices.size()) return 0; //Malformed - leave it alone
+                    }
+
+                    QHash<WeldKey, unsigned int> keyToIndex;
+                    keyToIndex.reserve(vertices.size());
+
+                    QVector<Vertex> weldedVertices;
+                    weldedVertices.reserve(vertices.size());
+                    QVector<unsigned int> remap(vertices.size());
+
+                    for (int i = 0; i < vertices.size(); i++) {
+                        const Vertex &vert = vertices.at(i);
+
+                        WeldKey key;
+                        key.values[0] = quantize(vert.position.x, POSITION_QUANTIZATION);
+                        key.values[1] = quantize(vert.position.y, POSITION_QUANTIZATION);
+                        key.values[2] = quantize(vert.position.z, POSITION_QUANTIZATION);
+                        key.values[3] = quantize(vert.normal.x, NORMAL_QUANTIZATION);
+                        key.values[4] = quantize(vert.normal.y, NORMAL_QUANTIZATION);
+                        key.values[5] = quantize(vert.normal.z, NORMAL_QUANTIZATION);
+                        key.values[6] = quantize(vert.texCoord.x, TEX_COORD_QUANTIZATION);
+                        key.values[7] = quantize(vert.texCoord.y, TEX_COORD_QUANTIZATION);
+
+                        auto it = keyToIndex.constFind(key);
+                        if (it != keyToIndex.constEnd()) {
+                            remap[i] = it.value();
+                        } else {
+                            remap[i] = weldedVertices.size();
+                            keyToIndex.insert(key, weldedVertices.size());
+                            weldedVertices.append(vert);
+                        }
+                    }
+
+                    for (unsigned int &index : indices) index = remap.at(index);
+
+                    int removed = vertices.size() - weldedVertices.size();
+                    vertices = weldedVertices;
+                    return removed;
+                }
+
+                /**
+                 * @brief Tuning values from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+                 */
+                static const int CACHE_SIZE = 32;
+                static const float CACHE_DECAY_POWER = 1.5f;
+                static const float LAST_TRIANGLE_SCORE = 0.75f;
+                static const float VALENCE_BOOST_SCALE = 2.0f;
+                static const float VALENCE_BOOST_POWER = 0.5f;
+
+                struct CacheVertex {
+                    int cachePosition = -1;
+                    float score = 0.0f;
+
+                    /**
+                     * @brief Triangles using this vertex that haven't been output yet
+                     */
+                    QVector<int> triangles;
+                };
+
+                static float scoreVertex(const CacheVertex &vert) {
+                    //Nothing left to draw with this vertex
+                    if (vert.triangles.isEmpty()) return -1.0f;
+
+                    float score = 0.0f;
+                    if (vert.cachePosition >= 0) {
+                        if (vert.cachePosition < 3) {
+                            //Used by the last triangle - fixed score so the next triangle isn't too biased towards it
+                            score = LAST_TRIANGLE_SCORE;
+                        } else {
+                            float scaler = 1.0f / (CACHE_SIZE - 3);
+                            score = powf(1.0f - (vert.cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+                        }
+                    }
+
+                    //Boost vertices with few triangles left, to finish them off and avoid lone triangles later
+                    score += VALENCE_BOOST_SCALE * powf((float) vert.triangles.size(), -VALENCE_BOOST_POWER);
+
+                    return score;
+                }
+
+                void optimizeVertexCache(QVector<unsigned int> &indices, int vertexCount) {
+                    //Not a triangle list (Assimp leaves line and point primitives alone when triangulating)
+                    if (indices.size() % 3 != 0) return;
+
+                    int triangleCount = indices.size() / 3;
+                    if (triangleCount < 2) return;
+
+                    for (unsigned int index : indices) {
+                        if (index >= (unsigned int) vertexCount) return; //Malformed - leave it alone
+                    }
+
+                    QVector<CacheVertex> verts(vertexCount);
+                    for (int t = 0; t < triangleCount; t++) {
+                        for (int i = 0; i < 3; i++) verts[indices.at(t * 3 + i)].triangles.append(t);
+                    }
+
+                    for (CacheVertex &vert : verts) vert.score = scoreVertex(vert);
+
+                    QVector<float> triangleScores(triangleCount);
+                    QVector<bool> triangleAdded(triangleCount, false);
+                    for (int t = 0; t < triangleCount; t++) {
+                        triangleScores[t] = verts.at(indices.at(t * 3)).score +
+                            verts.at(indices.at(t * 3 + 1)).score +
+                            verts.at(indices.at(t * 3 + 2)).score;
+                    }
+
+                    QVector<unsigned int> newIndices;
+                    newIndices.reserve(indices.size());
+
+                    QVector<unsigned int> cache;
+                    cache.reserve(CACHE_SIZE + 3);
+
+                    int bestTriangle = -1;
+                    int scanStart = 0; //Every triangle before this has been added
+
+                    for (int added = 0; added < triangleCount; added++) {
+                        if (bestTriangle < 0) {
+                            //Nothing in the cache is any use - find the best triangle out of everything left
+                            while (triangleAdded.at(scanStart)) scanStart++;
+
+                            float bestScore = -1.0f;
+                            for (int t = scanStart; t < triangleCount; t++) {
+                                if (!triangleAdded.at(t) && triangleScores.at(t) > bestScore) {
+                                    bestScore = triangleScores.at(t);
+                                    bestTriangle = t;
+                                }
+                            }
+                        }
+
+                        //Output the triangle
+                        triangleAdded[bestTriangle] = true;
+                        unsigned int triVerts[3];
+                        for (int i = 0; i < 3; i++) {
+                            triVerts[i] = indices.at(bestTriangle * 3 + i);
+                            newIndices.append(triVerts[i]);
+
+                            QVector<int> &vertTris = verts[triVerts[i]].triangles;
+                            vertTris.erase(std::remove(vertTris.begin(), vertTris.end(), bestTriangle), vertTris.end());
+                        }
+
+                        //Move its vertices to the front of the cache
+                        QVector<unsigned int> newCache;
+                        newCache.reserve(CACHE_SIZE + 3);
+                        for (int i = 0; i < 3; i++) {
+                            if (!newCache.contains(triVerts[i])) newCache.append(triVerts[i]);
+                        }
+                        foreach(unsigned int vert, cache) {
+                            if (!newCache.contains(vert)) newCache.append(vert);
+                        }
+
+                        //Rescore everything that was or is in the cache
+                        for (int i = 0; i < newCache.size(); i++) {
+                            CacheVertex &vert = verts[newCache.at(i)];
+                            vert.cachePosition = i < CACHE_SIZE ? i : -1;
+                            vert.score = scoreVertex(vert);
+                        }
+
+                        if (newCache.size() > CACHE_SIZE) newCache.resize(CACHE_SIZE);
+                        cache = newCache;
+
+                        //Rescore triangles that use cached vertices, and pick the best one to output next
+                        bestTriangle = -1;
+                        float bestScore = -1.0f;
+                        foreach(unsigned int cachedVert, cache) {
+                            foreach(int t, verts.at(cachedVert).triangles) {
+                                float score = verts.at(indices.at(t * 3)).score +
+                                    verts.at(indices.at(t * 3 + 1)).score +
+                                    verts.at(indices.at(t * 3 + 2)).score;
+                                triangleScores[t] = score;
+
+                                if (score > bestScore) {
+                                    bestScore = score;
+                                    bestTriangle = t;
+                                }
+                            }
+                        }
+                    }
+
+                    indices = newIndices;
+                }
+
+                float getAverageCacheMissRatio(const QVector<unsigned int> &indices, int cacheSize) {
+                    int triangleCount = indices.size() / 3;
+                    if (triangleCount == 0) return 0.0f;
+
+                    QVector<unsigned int> cache;
+                    int misses = 0;
+                    for (int i = 0; i < triangleCount * 3; i++) {
+                        unsigned int index = indices.at(i);
+                        if (!cache.contains(index)) {
+                            misses++;
+                            cache.prepend(index);
+                            if (cache.size() > cacheSize) cache.removeLast();
+                        }
+                    }
+
+                    return (float) misses / triangleCount;
+                }
+        }
+    }
+}
+
@@ -0,0 +1,121 @@
+#include "ws2common/model/MeshRequirements.hpp"
+#include <QStringList>
+
+namespace WS2Common {
+    namespace Model {
+        bool MeshRequirements::Attributes::covers(const Attributes &other) const {
+            return (normals || !other.normals) && (texCoords || !other.texCoords) && (textures || !other.textures);
+        }
+
+        void MeshRequirements::Attributes::merge(const Attributes &other) {
+            normals |= other.normals;
+            texCoords |= other.texCoords;
+            textures |= other.textures;
+        }
+
+        MeshRequirements::Attributes MeshRequirements::Attributes::all() {
+            Attributes attributes;
+            attributes.normals = true;
+            attributes.texCoords = true;
+            attributes.textures = true;
+            return attributes;
+        }
+
+        MeshRequirements MeshRequirements::everything() {
+            MeshRequirements requirements;
+            requirements.allMeshes = true;
+            requirements.allMeshAttributes = Attributes::all();
+            return requirements;
+        }
+
+        void MeshRequirements::require(const QString &meshName, const Attributes &attributes) {
+            if (allMeshes) {
+                allMeshAttributes.merge(attributes);
+                return;
+            }
+
+            meshes[meshName].merge(attributes);
+        }
+
+        bool MeshRequirements::isMeshRequired(const QString &meshName) const {
+            return allMeshes || meshes.contains(meshName);
+        }
+
+        MeshRequirements::Attributes MeshRequirements::getAttributes(const QString &meshName) const {
+            if (allMeshes) return allMeshAttributes;
+            return meshes.value(meshName);
+        }
+
+        bool MeshRequirements::needsNormals() const {
+            if (allMeshes) return allMeshAttributes.normals;
+
+            foreach(const Attributes &attributes, meshes) {
+                if (attributes.normals) return true;
+            }
+
+            return false;
+        }
+
+        bool MeshRequirements::covers(const MeshRequirements &other) const {
+            if (allMeshes) {
+                if (other.allMeshes) return allMeshAttributes.covers(other.allMeshAttributes);
+
+                foreach(const Attributes &attributes, other.meshes) {
+                    if (!allMeshAttributes.covers(attributes)) return false;
+                }
+
+                return true;
+            }
+
+            if (other.allMeshes) return false;
+
+            for (auto it = other.meshes.constBegin(); it != other.meshes.constEnd(); ++it) {
+                if (!meshes.contains(it.key()) || !meshes.value(it.key()).covers(it.value())) return false;
+            }
+
+            return true;
+        }
+
+        void MeshRequirements::merge(const MeshRequirements &other) {
+            if (other.allMeshes) {
+                //Everything is needed now - fold the per mesh attributes into one set for all meshes
+                Attributes merged = other.allMeshAttributes;
+                if (allMeshes) {
+                    merged.merge(allMeshAttributes);
+                } else {
+                    foreach(const Attributes &attributes, meshes) merged.merge(attributes);
+                }
+
+                allMeshes = true;
+                allMeshAttributes = merged;
+                meshes.clear();
+                return;
+            }
+
+            for (auto it = other.meshes.constBegin(); it != other.meshes.constEnd(); ++it) {
+                require(it.key(), it.value());
+            }
+        }
+
+        QByteArray MeshRequirements::toKey() const {
+            auto attributesKey = [](const Attributes &attributes) {
+                return QByteArray() + (attributes.normals ? 'n' : '-') + (attributes.texCoords ? 'u' : '-') +
+                    (attributes.textures ? 't' : '-');
+            };
+
+            if (allMeshes) return "*:" + attributesKey(allMeshAttributes);
+
+            //QHash iteration order isn't stable - sort by name
+            QStringList names = meshes.keys();
+            names.sort();
+
+            QByteArray key;
+            foreach(const QString &name, names) {
+                key += name.toUtf8() + ':' + attributesKey(meshes.value(name)) + '\n';
+            }
+
+            return key;
+        }
+    }
+}
+
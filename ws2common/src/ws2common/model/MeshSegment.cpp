@@ -1,4 +1,5 @@
 #include "ws2common/model/MeshSegment.hpp"
+#include <utility>
 
 namespace WS2Common {
     namespace Model {
@@ -6,18 +7,19 @@ namespace WS2Common {
                 QVector<Vertex> vertices,
                 QVector<unsigned int> indices,
                 QVector<Resource::ResourceTexture*> textures) {
-            this->vertices = vertices;
-            this->indices = indices;
-            this->textures = textures;
+            //Move rather than copy - Callers can std::move large arrays in to avoid ever copying them
+            this->vertices = std::move(vertices);
+            this->indices = std::move(indices);
+            this->textures = std::move(textures);
 
             //Don't start the AABB at 0, 0, 0 (Not all object may intersect the world origin point)
-            if (vertices.size() > 0) {
-                aabb.a = vertices.at(0).position;
-                aabb.b = vertices.at(0).position;
+            if (this->vertices.size() > 0) {
+                aabb.a = this->vertices.at(0).position;
+                aabb.b = this->vertices.at(0).position;
             }
 
             //Merge all verts into the AABB to make it fit this mesh segment
-            for (Vertex &vert : vertices) {
+            for (const Vertex &vert : this->vertices) {
                 aabb.mergeWith(vert.position);
             }
         }
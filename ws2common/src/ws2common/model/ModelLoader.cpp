@@ -2,17 +2,182 @@
 #include "ws2common/exception/IOException.hpp"
 #include "ws2common/exception/ModelLoadingException.hpp"
 #include "ws2common/MathUtils.hpp"
+#include "ws2common/model/MeshCache.hpp"
+#include "ws2common/model/MeshOptimizer.hpp"
+#include "ws2common/MessageHandler.hpp"
 #include <assimp/Importer.hpp>
+#include <assimp/DefaultIOSystem.h>
 #include <assimp/postprocess.h>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <math.h>
+#include <utility>
 #include <QDebug>
 
 namespace WS2Common {
     namespace Model {
         namespace ModelLoader {
+                static QString meshCacheDirectory;
+                static QMutex meshCacheDirectoryMutex;
+                static QAtomicInt vertexWeldingEnabled(0);
+                static QAtomicPointer<Resource::TextureManager> textureManager(nullptr);
+
+                /**
+                 * @brief Reads files like Assimp normally would, but notes down every file Assimp looks for or opens
+                 *
+                 * Used to find the files a model depends on other than itself, such as an OBJ's MTL file
+                 */
+                class RecordingIOSystem : public Assimp::DefaultIOSystem {
+                    protected:
+                        QStringList *paths;
+
+                        void record(const char *path) const {
+                            QString absolutePath = QFileInfo(QString::fromLocal8Bit(path)).absoluteFilePath();
+                            if (!paths->contains(absolutePath)) paths->append(absolutePath);
+                        }
+
+                    public:
+                        RecordingIOSystem(QStringList *paths) : paths(paths) {}
+
+                        bool Exists(const char *path) const {
+                            record(path);
+                            return Assimp::DefaultIOSystem::Exists(path);
+                        }
+
+                        Assimp::IOStream* Open(const char *path, const char *mode = "rb") {
+                            record(path);
+                            return Assimp::DefaultIOSystem::Open(path, mode);
+                        }
+                };
+
+                /**
+                 * @brief Makes a texture path from a material absolute
+                 */
+                static QString resolveTexturePath(const aiString &str, const QDir *parentDir) {
+                    const QFileInfo fileInfo = QFileInfo(str.C_Str());
+                    if ((fileInfo.isRelative() || QString(str.C_Str()).startsWith("//")) && parentDir != nullptr) {
+                        //The filepath is relative - Make it absolute
+                        //Filepaths that begin with // are relative (Due to Blender)
+                        QString relPath = str.C_Str();
+                        if (relPath.startsWith("//")) relPath.remove(0, 2);
+
+                        return parentDir->absoluteFilePath(relPath);
+                    } else {
+                        //The filepath is absolute or parentDir was nullptr
+                        return QString(str.C_Str());
+                    }
+                }
+
+                /**
+                 * @brief Appends the path of every texture the scene's materials refer to, as loadMaterialTextures would
+                 *        resolve it
+                 */
+                static void appendTexturePaths(const aiScene *scene, const QDir *parentDir, QStringList *paths) {
+                    static const aiTextureType TYPES[] = {aiTextureType_DIFFUSE, aiTextureType_SPECULAR};
+
+                    for (unsigned int i = 0; i < scene->mNumMaterials; i++) {
+                        for (aiTextureType type : TYPES) {
+                            unsigned int count = scene->mMaterials[i]->GetTextureCount(type);
+                            for (unsigned int j = 0; j < count; j++) {
+                                aiString str;
+                                scene->mMaterials[i]->GetTexture(type, j, &str);
+                                QString path = resolveTexturePath(str, parentDir);
+                                if (!paths->contains(path)) paths->append(path);
+                            }
+                        }
+                    }
+                }
+
+                void setTextureManager(Resource::TextureManager *manager) {
+                    textureManager.store(manager);
+                }
+
+                Resource::TextureManager* getTextureManager() {
+                    return textureManager.load();
+                }
+
+                void setVertexWeldingEnabled(bool enabled) {
+                    vertexWeldingEnabled.store(enabled ? 1 : 0);
+                }
+
+                bool isVertexWeldingEnabled() {
+                    return vertexWeldingEnabled.load() != 0;
+                }
+
+                void setMeshCacheDirectory(const QString &cacheDirectory) {
+                    QMutexLocker locker(&meshCacheDirectoryMutex);
+
+                    meshCacheDirectory = cacheDirectory;
+                    if (!cacheDirectory.isEmpty() && !QDir().mkpath(cacheDirectory)) {
+                        qWarning().noquote() << "Failed to create mesh cache directory" << cacheDirectory;
+                    }
+                }
+
+                QString getMeshCacheDirectory() {
+                    QMutexLocker locker(&meshCacheDirectoryMutex);
+                    return meshCacheDirectory;
+                }
+
+                void transformVertices(QVector<WS2Common::Model::Vertex> &vertices, const glm::mat4 &transform, bool transformNormals) {
+                    //Hoist the matrix out of the loops into plain floats so that the loops vectorize well
+                    const float m00 = transform[0][0], m01 = transform[0][1], m02 = transform[0][2];
+                    const float m10 = transform[1][0], m11 = transform[1][1], m12 = transform[1][2];
+                    const float m20 = transform[2][0], m21 = transform[2][1], m22 = transform[2][2];
+                    const float m30 = transform[3][0], m31 = transform[3][1], m32 = transform[3][2];
+
+                    int vertexCount = vertices.size();
+                    WS2Common::Model::Vertex *data = vertices.data();
+
+                    //Positions - The root transform is affine, so w is always 1 and there's no divide
+                    for (int i = 0; i < vertexCount; i++) {
+                        float x = data[i].position.x;
+                        float y = data[i].position.y;
+                        float z = data[i].position.z;
+                        data[i].position.x = m00 * x + m10 * y + m20 * z + m30;
+                        data[i].position.y = m01 * x + m11 * y + m21 * z + m31;
+                        data[i].position.z = m02 * x + m12 * y + m22 * z + m32;
+                    }
+
+                    if (!transformNormals) return;
+
+                    //Normals use the inverse transpose, so non uniform scales keep them perpendicular to the surface
+                    const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+                    const float n00 = normalMatrix[0][0], n01 = normalMatrix[0][1], n02 = normalMatrix[0][2];
+                    const float n10 = normalMatrix[1][0], n11 = normalMatrix[1][1], n12 = normalMatrix[1][2];
+                    const float n20 = normalMatrix[2][0], n21 = normalMatrix[2][1], n22 = normalMatrix[2][2];
+
+                    for (int i = 0; i < vertexCount; i++) {
+                        float x = data[i].normal.x;
+                        float y = data[i].normal.y;
+                        float z = data[i].normal.z;
+                        float nx = n00 * x + n10 * y + n20 * z;
+                        float ny = n01 * x + n11 * y + n21 * z;
+                        float nz = n02 * x + n12 * y + n22 * z;
+
+                        //Renormalize, leaving degenerate (zero length) normals alone
+                        float lengthSquared = nx * nx + ny * ny + nz * nz;
+                        float scale = lengthSquared > 0.0f ? 1.0f / sqrtf(lengthSquared) : 0.0f;
+                        data[i].normal.x = nx * scale;
+                        data[i].normal.y = ny * scale;
+                        data[i].normal.z = nz * scale;
+                    }
+                }
+
+                unsigned int getPostProcessFlags(const MeshRequirements *requirements) {
+                    unsigned int flags = aiProcess_Triangulate;
+
+                    //Generating normals is a fair chunk of import time - skip it if nothing will read them
+                    if (requirements == nullptr || requirements->needsNormals()) flags |= aiProcess_GenNormals;
+
+                    return flags;
+                }
+
                 QVector<WS2Common::Resource::ResourceMesh*> loadModel(
                         QFile &file,
                         QVector<Resource::AbstractResource*> *resources,
-                        QMutex *resourcesMutex
+                        QMutex *resourcesMutex,
+                        const MeshRequirements *requirements
                         ) {
                     QString fileName = file.fileName();
 
@@ -23,22 +188,42 @@ namespace WS2Common {
                         }
 
                         QByteArray bytes = file.readAll();
-                        return addModelFromMemory(bytes.data(), bytes.size(), resources, resourcesMutex);
+                        return addModelFromMemory(bytes.data(), bytes.size(), resources, resourcesMutex, requirements);
                     } else {
-                        //The file is from elsewhere - Assume it's from the local filesystem, and pass it to Assimp
-                        return addModelFromFile(fileName.toLatin1().constData(), resources, resourcesMutex);
+                        //The file is from elsewhere - Assume it's from the local filesystem
+                        QString cacheDirectory = getMeshCacheDirectory();
+                        if (cacheDirectory.isEmpty()) {
+                            return addModelFromFile(fileName.toLatin1().constData(), resources, resourcesMutex, requirements);
+                        }
+
+                        //Skip Assimp entirely if the model is unchanged since it was last cached
+                        QString cacheFilePath = MeshCache::getCacheFilePath(cacheDirectory, fileName, requirements);
+                        QVector<WS2Common::Resource::ResourceMesh*> meshVector;
+                        if (MeshCache::readCache(cacheFilePath, fileName, meshVector, requirements, resources, resourcesMutex)) {
+                            return meshVector;
+                        }
+
+                        QStringList dependencies;
+                        meshVector = addModelFromFile(fileName.toLatin1().constData(), resources, resourcesMutex, requirements, &dependencies);
+                        MeshCache::writeCache(cacheFilePath, fileName, meshVector, requirements, dependencies);
+                        return meshVector;
                     }
                 }
 
                 QVector<WS2Common::Resource::ResourceMesh*> addModelFromFile(
                         const char *filePath,
                         QVector<Resource::AbstractResource*> *resources,
-                        QMutex *resourcesMutex
+                        QMutex *resourcesMutex,
+                        const MeshRequirements *requirements,
+                        QStringList *dependencies
                         ) {
                     Assimp::Importer importer;
+                    QStringList openedPaths;
+                    if (dependencies != nullptr) importer.SetIOHandler(new RecordingIOSystem(&openedPaths)); //The importer deletes it
+
                     const aiScene *scene = importer.ReadFile(
                             filePath,
-                            aiProcess_Triangulate | aiProcess_GenNormals
+                            getPostProcessFlags(requirements)
                             );
 
                     //Check if stuff went wrong
@@ -54,7 +239,15 @@ namespace WS2Common {
 
                     const glm::mat4 globalTransform = MathUtils::toGlmMat4(scene->mRootNode->mTransformation);
                     const QString filePathStr(filePath);
-                    processNode(scene->mRootNode, scene, globalTransform, &filePathStr, &parentDir, meshVector, resources, resourcesMutex);
+                    processNode(scene->mRootNode, scene, globalTransform, &filePathStr, &parentDir, meshVector, resources, resourcesMutex, requirements);
+
+                    if (dependencies != nullptr) {
+                        openedPaths.removeAll(fileInfo.absoluteFilePath());
+                        appendTexturePaths(scene, &parentDir, &openedPaths);
+                        foreach(const QString &path, openedPaths) {
+                            if (!dependencies->contains(path)) dependencies->append(path);
+                        }
+                    }
 
                     return meshVector;
                 }
@@ -63,13 +256,14 @@ namespace WS2Common {
                         const void *bytes,
                         size_t byteCount,
                         QVector<Resource::AbstractResource*> *resources,
-                        QMutex *resourcesMutex
+                        QMutex *resourcesMutex,
+                        const MeshRequirements *requirements
                         ) {
                     Assimp::Importer importer;
                     const aiScene *scene = importer.ReadFileFromMemory(
                             bytes,
                             byteCount,
-                            aiProcess_Triangulate | aiProcess_GenNormals
+                            getPostProcessFlags(requirements)
                             );
 
                     //Check if stuff went wrong
@@ -83,7 +277,7 @@ namespace WS2Common {
                     const glm::mat4 globalTransform = MathUtils::toGlmMat4(scene->mRootNode->mTransformation);
                     QString filePath;
                     QDir parentDir;
-                    processNode(scene->mRootNode, scene, globalTransform, &filePath, &parentDir, meshVector, resources, resourcesMutex);
+                    processNode(scene->mRootNode, scene, globalTransform, &filePath, &parentDir, meshVector, resources, resourcesMutex, requirements);
 
                     return meshVector;
                 }
@@ -96,16 +290,23 @@ namespace WS2Common {
                         const QDir *parentDir,
                         QVector<WS2Common::Resource::ResourceMesh*> &meshVector,
                         QVector<Resource::AbstractResource*> *resources,
-                        QMutex *resourcesMutex
+                        QMutex *resourcesMutex,
+                        const MeshRequirements *requirements
                         ) {
                     //qInfo() << "Processing node" << node->mName.C_Str() << node->mNumMeshes;
 
                     QVector<WS2Common::Model::MeshSegment*> segments; //Will contain all mesh segments for each material of this node's mesh
-                    //Process this node's mesh segments
-                    for (unsigned int i = 0; i < node->mNumMeshes; i++) {
-                        aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
-                        WS2Common::Model::MeshSegment *segment = processMeshSegment(mesh, scene, globalTransform, parentDir, resources, resourcesMutex);
-                        segments.append(segment);
+                    //Process this node's mesh segments - unless nothing needs this mesh
+                    if (requirements == nullptr || requirements->isMeshRequired(node->mName.C_Str())) {
+                        MeshRequirements::Attributes attributes = requirements != nullptr ?
+                            requirements->getAttributes(node->mName.C_Str()) :
+                            MeshRequirements::Attributes::all();
+
+                        for (unsigned int i = 0; i < node->mNumMeshes; i++) {
+                            aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
+                            WS2Common::Model::MeshSegment *segment = processMeshSegment(mesh, scene, globalTransform, parentDir, resources, resourcesMutex, &attributes);
+                            segments.append(segment);
+                        }
                     }
 
                     //Gather all segments of the mesh into a single WS2Common::Resource::ResourceMesh
@@ -129,7 +330,7 @@ namespace WS2Common {
 
                     //Recursively call this function to process meshes for all children
                     for (unsigned int i = 0; i < node->mNumChildren; i++) {
-                        processNode(node->mChildren[i], scene, globalTransform, filePath, parentDir, meshVector, resources, resourcesMutex);
+                        processNode(node->mChildren[i], scene, globalTransform, filePath, parentDir, meshVector, resources, resourcesMutex, requirements);
                     }
                 }
 
@@ -139,7 +340,8 @@ namespace WS2Common {
                         const glm::mat4 globalTransform,
                         const QDir *parentDir,
                         QVector<Resource::AbstractResource*> *resources,
-                        QMutex *resourcesMutex
+                        QMutex *resourcesMutex,
+                        const MeshRequirements::Attributes *attributes
                         ) {
                     QVector<WS2Common::Model::Vertex> vertices;
                     QVector<unsigned int> indices;
@@ -147,44 +349,44 @@ namespace WS2Common {
 
                     static const int UV_CHANNEL = 0;
 
+                    //Load everything if we weren't told otherwise
+                    const MeshRequirements::Attributes allAttributes = MeshRequirements::Attributes::all();
+                    if (attributes == nullptr) attributes = &allAttributes;
+
                     //Just for the warning
-                    if (!mesh->HasTextureCoords(UV_CHANNEL)) {
+                    if (attributes->texCoords && !mesh->HasTextureCoords(UV_CHANNEL)) {
                         qWarning() << "A mesh is missing texuture coordinates - Defaulting to 0, 0 for all vertices";
                     }
 
-                    for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
-                        WS2Common::Model::Vertex vertex;
-                        glm::vec3 vec;
+                    //Process vertex positions, normals, and texture coordinates
+                    unsigned int vertexCount = mesh->mNumVertices;
+                    bool hasNormals = attributes->normals && mesh->mNormals != nullptr;
+                    bool hasTexCoords = attributes->texCoords && mesh->mTextureCoords[UV_CHANNEL] != nullptr;
+                    vertices.resize(vertexCount);
 
-                        //Process vertex positions, normals, and texture coordinates
-                        vec.x = mesh->mVertices[i].x;
-                        vec.y = mesh->mVertices[i].y;
-                        vec.z = mesh->mVertices[i].z;
-                        vec = glm::vec3(glm::vec4(vec, 1.0f) / globalTransform);
-                        vertex.position = vec;
+                    for (unsigned int i = 0; i < vertexCount; i++) {
+                        WS2Common::Model::Vertex &vertex = vertices[i];
+
+                        vertex.position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
 
                         //mNormals can be a nullptr sometimes
                         //For example, when trying to import an OBJ that has a curve exported from Blender
-                        if (mesh->mNormals != nullptr) {
-                            vec.x = mesh->mNormals[i].x;
-                            vec.y = mesh->mNormals[i].y;
-                            vec.z = mesh->mNormals[i].z;
-                            vertex.normal = vec;
+                        if (hasNormals) {
+                            vertex.normal = glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
+                        } else {
+                            vertex.normal = glm::vec3(0.0f, 0.0f, 0.0f);
                         }
 
-                        if (mesh->mTextureCoords[UV_CHANNEL]) {
-                            glm::vec2 vec2;
-                            vec2.x = mesh->mTextureCoords[UV_CHANNEL][i].x;
-                            vec2.y = mesh->mTextureCoords[UV_CHANNEL][i].y;
-
-                            vertex.texCoord = vec2;
+                        if (hasTexCoords) {
+                            vertex.texCoord = glm::vec2(mesh->mTextureCoords[UV_CHANNEL][i].x, mesh->mTextureCoords[UV_CHANNEL][i].y);
                         } else {
                             vertex.texCoord = glm::vec2(0.0f, 0.0f);
                         }
-
-                        vertices.append(vertex);
                     }
 
+                    //Most files have an identity root transform - don't bother touching every vertex again for those
+                    if (globalTransform != glm::mat4(1.0f)) transformVertices(vertices, globalTransform, hasNormals);
+
                     //Process indices (Faces vertices)
                     for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
                         aiFace face = mesh->mFaces[i];
@@ -193,14 +395,27 @@ namespace WS2Common {
                         }
                     }
 
+                    if (isVertexWeldingEnabled()) {
+                        //Assimp gives us separate vertices for every face corner in most OBJs - merge duplicates
+                        int originalVertexCount = vertices.size();
+                        MeshOptimizer::weldVertices(vertices, indices);
+                        MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+
+                        ws2Debug().noquote().nospace() << "Welded " << originalVertexCount << " vertices to " <<
+                            vertices.size() << " (" << (originalVertexCount - vertices.size()) * sizeof(Vertex) <<
+                            " bytes saved)";
+                    }
+
                     //Process material
-                    aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
-                    QVector<WS2Common::Resource::ResourceTexture*> diffuseMaps = loadMaterialTextures(material, aiTextureType_DIFFUSE, parentDir, resources, resourcesMutex);
-                    textures.append(diffuseMaps);
-                    QVector<WS2Common::Resource::ResourceTexture*> specularMaps = loadMaterialTextures(material, aiTextureType_SPECULAR, parentDir, resources, resourcesMutex);
-                    textures.append(specularMaps);
+                    if (attributes->textures) {
+                        aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
+                        QVector<WS2Common::Resource::ResourceTexture*> diffuseMaps = loadMaterialTextures(material, aiTextureType_DIFFUSE, parentDir, resources, resourcesMutex);
+                        textures.append(diffuseMaps);
+                        QVector<WS2Common::Resource::ResourceTexture*> specularMaps = loadMaterialTextures(material, aiTextureType_SPECULAR, parentDir, resources, resourcesMutex);
+                        textures.append(specularMaps);
+                    }
 
-                    WS2Common::Model::MeshSegment *segment = new WS2Common::Model::MeshSegment(vertices, indices, textures);
+                    WS2Common::Model::MeshSegment *segment = new WS2Common::Model::MeshSegment(std::move(vertices), std::move(indices), std::move(textures));
 
                     return segment;
                 }
@@ -218,46 +433,49 @@ namespace WS2Common {
                     for (int i = 0; i < maxI; i++) {
                         aiString str;
                         mat->GetTexture(type, i, &str);
-                        const QFileInfo fileInfo = QFileInfo(str.C_Str());
-                        QString filePath;
-                        if ((fileInfo.isRelative() || QString(str.C_Str()).startsWith("//")) && parentDir != nullptr) {
-                            //The filepath is relative - Make it absolute
-                            //Filepaths that begin with // are relative (Due to Blender)
-                            QString relPath = str.C_Str();
-                            if (relPath.startsWith("//")) relPath.remove(0, 2);
-
-                            filePath = parentDir->absoluteFilePath(relPath);
-                        } else {
-                            //The filepath is absolute or parentDir was nullptr
-                            filePath = QString(str.C_Str());
-                        }
+                        QString filePath = resolveTexturePath(str, parentDir);
 
-                        //Check if the file doesn't exist, and load the uvtemplate texture instead
-                        if (!QFileInfo(filePath).exists()) {
-                            filePath = ":/WS2Common/Images/uvtemplate.png";
-                        }
+                        WS2Common::Resource::ResourceTexture *texture = getOrCreateTexture(filePath, resources, resourcesMutex);
+                        if (!textures.contains(texture)) textures.append(texture);
+                    }
 
-                        WS2Common::Resource::ResourceTexture *texture = nullptr;
-                        //Don't load another copy of the texture if it is already in the ResourceManager
-                        if (resources != nullptr) {
-                            texture = getResourceFromFilePath<WS2Common::Resource::ResourceTexture*>(filePath, *resources, resourcesMutex);
-                        }
+                    return textures;
+                }
 
-                        if (texture == nullptr) {
-                            texture = new WS2Common::Resource::ResourceTexture();
-                            texture->setId(filePath);
-                            texture->setFilePath(filePath);
-                            if (resources != nullptr) {
-                                if (resourcesMutex != nullptr) resourcesMutex->lock();
-                                resources->append(texture);
-                                if (resourcesMutex != nullptr) resourcesMutex->unlock();
-                            }
-                        }
+                WS2Common::Resource::ResourceTexture* getOrCreateTexture(
+                        QString filePath,
+                        QVector<Resource::AbstractResource*> *resources,
+                        QMutex *resourcesMutex
+                        ) {
+                    //Check if the file doesn't exist, and load the uvtemplate texture instead
+                    if (!QFileInfo(filePath).exists()) {
+                        filePath = ":/WS2Common/Images/uvtemplate.png";
+                    }
 
-                        if (!textures.contains(texture)) textures.append(texture);
+                    //Look the texture up by path in constant time if a texture manager indexes these resources
+                    Resource::TextureManager *manager = textureManager.load();
+                    if (manager != nullptr && resources != nullptr && manager->getResources() == resources) {
+                        return manager->getTexture(filePath);
                     }
 
-                    return textures;
+                    WS2Common::Resource::ResourceTexture *texture = nullptr;
+                    //Don't load another copy of the texture if it is already in the ResourceManager
+                    if (resources != nullptr) {
+                        texture = getResourceFromFilePath<WS2Common::Resource::ResourceTexture*>(filePath, *resources, resourcesMutex);
+                    }
+
+                    if (texture == nullptr) {
+                        texture = new WS2Common::Resource::ResourceTexture();
+                        texture->setId(filePath);
+                        texture->setFilePath(filePath);
+                        if (resources != nullptr) {
+                            if (resourcesMutex != nullptr) resourcesMutex->lock();
+                            resources->append(texture);
+                            if (resourcesMutex != nullptr) resourcesMutex->unlock();
+                        }
+                    }
+
+                    return texture;
                 }
         }
     }
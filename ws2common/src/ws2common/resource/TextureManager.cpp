@@ -0,0 +1,176 @@
+#include "ws2common/resource/TextureManager.hpp"
+#include <QMutexLocker>
+#include <QFileInfo>
+#include <QFile>
+#include <QSaveFile>
+#include <QDir>
+#include <QDataStream>
+#include <QDateTime>
+#include <QImageReader>
+#include <QCryptographicHash>
+#include <QDebug>
+
+namespace WS2Common {
+    namespace Resource {
+        TextureManager::TextureManager(QVector<AbstractResource*> *resources, QMutex *resourcesMutex) :
+            resources(resources),
+            resourcesMutex(resourcesMutex) {}
+
+        const QVector<AbstractResource*>* TextureManager::getResources() const {
+            return resources;
+        }
+
+        ResourceTexture* TextureManager::getTexture(const QString &filePath) {
+            QString canonicalPath = getCanonicalPath(filePath);
+
+            //Held until the texture is added, so two threads can't both create the same texture
+            QMutexLocker locker(&texturesMutex);
+
+            ResourceTexture *texture = textures.value(canonicalPath);
+            if (texture != nullptr) return texture;
+
+            texture = new ResourceTexture();
+            texture->setId(filePath);
+            texture->setFilePath(filePath);
+            textures[canonicalPath] = texture;
+
+            if (resources != nullptr) {
+                if (resourcesMutex != nullptr) resourcesMutex->lock();
+                resources->append(texture);
+                if (resourcesMutex != nullptr) resourcesMutex->unlock();
+            }
+
+            return texture;
+        }
+
+        void TextureManager::setCacheDirectory(const QString &cacheDirectory) {
+            QMutexLocker locker(&cacheDirectoryMutex);
+
+            this->cacheDirectory = cacheDirectory;
+            if (!cacheDirectory.isEmpty() && !QDir().mkpath(cacheDirectory)) {
+                qWarning().noquote() << "Failed to create texture cache directory" << cacheDirectory;
+            }
+        }
+
+        QString TextureManager::getCacheDirectory() const {
+            QMutexLocker locker(&cacheDirectoryMutex);
+            return cacheDirectory;
+        }
+
+        QImage TextureManager::decode(const QString &filePath, int maxSize) const {
+            //Qt resources are built in and quick to decode - don't bother caching them
+            QString cacheFile;
+            if (!filePath.startsWith(":")) cacheFile = getCacheFilePath(filePath, maxSize);
+
+            QImage image;
+            if (!cacheFile.isEmpty() && readCache(cacheFile, image)) return image;
+
+            QImageReader reader(filePath);
+            if (maxSize > 0) {
+                //Let the decoder scale down while decoding where it can, rather than decoding the full image first
+                QSize size = reader.size();
+                if (size.isValid() && (size.width() > maxSize || size.height() > maxSize)) {
+                    reader.setScaledSize(size.scaled(maxSize, maxSize, Qt::KeepAspectRatio));
+                }
+            }
+
+            if (!reader.read(&image)) {
+                qWarning().noquote() << "Failed to decode texture" << filePath << "-" << reader.errorString();
+                return QImage();
+            }
+
+            image = image.convertToFormat(QImage::Format_RGBA8888);
+
+            if (!cacheFile.isEmpty()) writeCache(cacheFile, image);
+
+            return image;
+        }
+
+        QString TextureManager::getCanonicalPath(const QString &filePath) {
+            if (filePath.startsWith(":")) return filePath;
+
+            QFileInfo fileInfo(filePath);
+            QString canonicalPath = fileInfo.canonicalFilePath();
+            return canonicalPath.isEmpty() ? fileInfo.absoluteFilePath() : canonicalPath;
+        }
+
+        QString TextureManager::getCacheFilePath(const QString &filePath, int maxSize) const {
+            QString dir = getCacheDirectory();
+            if (dir.isEmpty()) return QString();
+
+            //The file's modification time and size are part of the name, so an edited image gets a new cache file
+            QFileInfo fileInfo(filePath);
+            QCryptographicHash hash(QCryptographicHash::Sha1);
+            hash.addData(getCanonicalPath(filePath).toUtf8());
+            hash.addData(QByteArray::number(fileInfo.lastModified().toMSecsSinceEpoch()));
+            hash.addData(QByteArray::number(fileInfo.size()));
+            hash.addData(QByteArray::number(maxSize));
+
+            return QDir(dir).filePath(QString::fromLatin1(hash.result().toHex()) + ".ws2tex");
+        }
+
+        bool TextureManager::readCache(const QString &cacheFile, QImage &image) const {
+            QFile file(cacheFile);
+            if (!file.open(QIODevice::ReadOnly)) return false;
+
+            QDataStream in(&file);
+            in.setByteOrder(QDataStream::BigEndian);
+
+            QByteArray magic(4, '\0');
+            quint32 version;
+            qint32 width;
+            qint32 height;
+            in.readRawData(magic.data(), 4);
+            in >> version >> width >> height;
+
+            if (in.status() != QDataStream::Ok || magic != "WS2T" || version != FORMAT_VERSION ||
+                    width <= 0 || height <= 0) {
+                qWarning().noquote() << "Ignoring stale or corrupt texture cache file" << cacheFile;
+                return false;
+            }
+
+            //Rows are stored tightly packed, whereas QImage rows may be padded
+            int rowLength = width * 4;
+            if (file.size() - file.pos() != (qint64) rowLength * height) {
+                qWarning().noquote() << "Ignoring truncated texture cache file" << cacheFile;
+                return false;
+            }
+
+            image = QImage(width, height, QImage::Format_RGBA8888);
+            for (int y = 0; y < height; y++) {
+                if (in.readRawData(reinterpret_cast<char*>(image.scanLine(y)), rowLength) != rowLength) {
+                    qWarning().noquote() << "Ignoring truncated texture cache file" << cacheFile;
+                    image = QImage();
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        void TextureManager::writeCache(const QString &cacheFile, const QImage &image) const {
+            //QSaveFile only replaces the old file once everything is written, so a crash can't leave half an image
+            QSaveFile file(cacheFile);
+            if (!file.open(QIODevice::WriteOnly)) {
+                qWarning().noquote() << "Failed to write texture cache file" << cacheFile << "-" << file.errorString();
+                return;
+            }
+
+            QDataStream out(&file);
+            out.setByteOrder(QDataStream::BigEndian);
+
+            out.writeRawData("WS2T", 4);
+            out << FORMAT_VERSION << (qint32) image.width() << (qint32) image.height();
+
+            int rowLength = image.width() * 4;
+            for (int y = 0; y < image.height(); y++) {
+                out.writeRawData(reinterpret_cast<const char*>(image.constScanLine(y)), rowLength);
+            }
+
+            if (!file.commit()) {
+                qWarning().noquote() << "Failed to write texture cache file" << cacheFile << "-" << file.errorString();
+            }
+        }
+    }
+}
+
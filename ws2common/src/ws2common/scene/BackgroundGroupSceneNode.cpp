@@ -3,6 +3,10 @@
 namespace WS2Common {
     namespace Scene {
         BackgroundGroupSceneNode::BackgroundGroupSceneNode(const QString name) : SceneNode(name) {}
+
+        SceneNode* BackgroundGroupSceneNode::clone() const {
+            return new BackgroundGroupSceneNode(*this);
+        }
     }
 }
 
@@ -4,12 +4,17 @@ namespace WS2Common {
     namespace Scene {
         BananaSceneNode::BananaSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* BananaSceneNode::clone() const {
+            return new BananaSceneNode(*this);
+        }
+
         EnumBananaType BananaSceneNode::getType() const {
             return type;
         }
 
         void BananaSceneNode::setType(EnumBananaType type) {
             this->type = type;
+            markDirty();
         }
 
         const QString BananaSceneNode::getSerializableName() const {
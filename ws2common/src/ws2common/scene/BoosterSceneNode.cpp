@@ -4,6 +4,10 @@ namespace WS2Common {
     namespace Scene {
         BoosterSceneNode::BoosterSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* BoosterSceneNode::clone() const {
+            return new BoosterSceneNode(*this);
+        }
+
         const QString BoosterSceneNode::getSerializableName() const {
             return "boosterSceneNode";
         }
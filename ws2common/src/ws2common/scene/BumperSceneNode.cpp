@@ -4,6 +4,10 @@ namespace WS2Common {
     namespace Scene {
         BumperSceneNode::BumperSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* BumperSceneNode::clone() const {
+            return new BumperSceneNode(*this);
+        }
+
         const QString BumperSceneNode::getSerializableName() const {
             return "bumperSceneNode";
         }
@@ -4,6 +4,10 @@ namespace WS2Common {
     namespace Scene {
         CollisionSceneNode::CollisionSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* CollisionSceneNode::clone() const {
+            return new CollisionSceneNode(*this);
+        }
+
         const QString CollisionSceneNode::getSerializableName() const {
             return "collisionSceneNode";
         }
@@ -4,6 +4,10 @@ namespace WS2Common {
     namespace Scene {
         ConeCollisionObjectSceneNode::ConeCollisionObjectSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* ConeCollisionObjectSceneNode::clone() const {
+            return new ConeCollisionObjectSceneNode(*this);
+        }
+
         const QString ConeCollisionObjectSceneNode::getSerializableName() const {
             return "coneCollisionObjectSceneNode";
         }
@@ -14,6 +18,7 @@ namespace WS2Common {
 
         void ConeCollisionObjectSceneNode::setRadius(float radius) {
             this->radius = radius;
+            markDirty();
         }
 
         float ConeCollisionObjectSceneNode::getHeight() const {
@@ -22,6 +27,7 @@ namespace WS2Common {
 
         void ConeCollisionObjectSceneNode::setHeight(float height) {
             this->height = height;
+            markDirty();
         }
 
     }
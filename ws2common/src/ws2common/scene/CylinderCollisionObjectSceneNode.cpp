@@ -4,6 +4,10 @@ namespace WS2Common {
     namespace Scene {
         CylinderCollisionObjectSceneNode::CylinderCollisionObjectSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* CylinderCollisionObjectSceneNode::clone() const {
+            return new CylinderCollisionObjectSceneNode(*this);
+        }
+
         const QString CylinderCollisionObjectSceneNode::getSerializableName() const {
             return "cylinderCollisionObjectSceneNode";
         }
@@ -14,6 +18,7 @@ namespace WS2Common {
 
         void CylinderCollisionObjectSceneNode::setRadius(float radius) {
             this->radius = radius;
+            markDirty();
         }
 
         float CylinderCollisionObjectSceneNode::getHeight() const {
@@ -22,6 +27,7 @@ namespace WS2Common {
 
         void CylinderCollisionObjectSceneNode::setHeight(float height) {
             this->height = height;
+            markDirty();
         }
     }
 }
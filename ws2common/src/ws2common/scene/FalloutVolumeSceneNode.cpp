@@ -3,6 +3,10 @@
 namespace WS2Common {
     namespace Scene {
         FalloutVolumeSceneNode::FalloutVolumeSceneNode(const QString name) : SceneNode(name) {}
+
+        SceneNode* FalloutVolumeSceneNode::clone() const {
+            return new FalloutVolumeSceneNode(*this);
+        }
     }
 }
 
@@ -3,6 +3,10 @@
 namespace WS2Common {
     namespace Scene {
         ForegroundGroupSceneNode::ForegroundGroupSceneNode(const QString name) : SceneNode(name) {}
+
+        SceneNode* ForegroundGroupSceneNode::clone() const {
+            return new ForegroundGroupSceneNode(*this);
+        }
     }
 }
 
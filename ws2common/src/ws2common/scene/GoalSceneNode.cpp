@@ -4,12 +4,17 @@ namespace WS2Common {
     namespace Scene {
         GoalSceneNode::GoalSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* GoalSceneNode::clone() const {
+            return new GoalSceneNode(*this);
+        }
+
         EnumGoalType GoalSceneNode::getType() const {
             return type;
         }
 
         void GoalSceneNode::setType(EnumGoalType type) {
             this->type = type;
+            markDirty();
         }
 
         const QString GoalSceneNode::getSerializableName() const {
@@ -22,6 +27,7 @@ namespace WS2Common {
 
         void GoalSceneNode::setCastShadow(bool castShadow) {
             this->castShadow = castShadow;
+            markDirty();
         }
 
         void GoalSceneNode::serializeNodeDataXml(QXmlStreamWriter &s) const {
@@ -4,6 +4,10 @@ namespace WS2Common {
     namespace Scene {
         GolfHoleSceneNode::GolfHoleSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* GolfHoleSceneNode::clone() const {
+            return new GolfHoleSceneNode(*this);
+        }
+
         const QString GolfHoleSceneNode::getSerializableName() const {
             return "golfHoleSceneNode";
         }
@@ -4,15 +4,22 @@ namespace WS2Common {
     namespace Scene {
         GroupSceneNode::GroupSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* GroupSceneNode::clone() const {
+            return new GroupSceneNode(*this);
+        }
+
         void GroupSceneNode::setCollisionGrid(CollisionGrid &collisionGrid) {
             this->collisionGrid = collisionGrid;
+            markDirty();
         }
 
         void GroupSceneNode::setCollisionGrid(CollisionGrid collisionGrid) {
             this->collisionGrid = collisionGrid;
+            markDirty();
         }
 
         CollisionGrid& GroupSceneNode::getCollisionGrid() {
+            markDirty();
             return collisionGrid;
         }
 
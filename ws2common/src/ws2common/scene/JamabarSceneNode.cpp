@@ -4,6 +4,10 @@ namespace WS2Common {
     namespace Scene {
         JamabarSceneNode::JamabarSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* JamabarSceneNode::clone() const {
+            return new JamabarSceneNode(*this);
+        }
+
         const QString JamabarSceneNode::getSerializableName() const {
             return "jamabarSceneNode";
         }
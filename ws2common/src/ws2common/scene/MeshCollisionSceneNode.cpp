@@ -5,8 +5,13 @@ namespace WS2Common {
     namespace Scene {
         MeshCollisionSceneNode::MeshCollisionSceneNode(const QString name) : CollisionSceneNode(name) {}
 
+        SceneNode* MeshCollisionSceneNode::clone() const {
+            return new MeshCollisionSceneNode(*this);
+        }
+
         void MeshCollisionSceneNode::setMeshName(QString meshName) {
             this->meshName = meshName;
+            markDirty();
         }
 
         const QString MeshCollisionSceneNode::getMeshName() const {
@@ -23,6 +28,7 @@ namespace WS2Common {
 
         void MeshCollisionSceneNode::setCollisionTriangleFlag(quint16 collisionTriangleFlag) {
             this->collisionTriangleFlag = collisionTriangleFlag;
+            markDirty();
         }
 
 
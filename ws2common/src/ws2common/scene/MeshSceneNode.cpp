@@ -4,8 +4,13 @@ namespace WS2Common {
     namespace Scene {
         MeshSceneNode::MeshSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* MeshSceneNode::clone() const {
+            return new MeshSceneNode(*this);
+        }
+
         void MeshSceneNode::setMeshName(QString meshName) {
             this->meshName = meshName;
+            markDirty();
         }
 
         const QString MeshSceneNode::getMeshName() const {
@@ -14,6 +19,7 @@ namespace WS2Common {
 
         void MeshSceneNode::setRuntimeReflective(bool runtimeReflective) {
             this->runtimeReflective = runtimeReflective;
+            markDirty();
         }
 
         bool MeshSceneNode::isRuntimeReflective() const {
@@ -22,6 +28,7 @@ namespace WS2Common {
 
         void MeshSceneNode::setBitflag(unsigned int bitflag) {
             this->bitflag = bitflag;
+            markDirty();
         }
 
         unsigned int MeshSceneNode::getBitflag() const {
@@ -30,6 +37,7 @@ namespace WS2Common {
 
         void MeshSceneNode::setMeshType(unsigned int meshType) {
             this->meshType = meshType;
+            markDirty();
         }
 
         unsigned int MeshSceneNode::getMeshType() const {
@@ -4,6 +4,10 @@ namespace WS2Common {
     namespace Scene {
         RaceTrackPathSceneNode::RaceTrackPathSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* RaceTrackPathSceneNode::clone() const {
+            return new RaceTrackPathSceneNode(*this);
+        }
+
         const QString RaceTrackPathSceneNode::getSerializableName() const {
             return "raceTrackPathSceneNode";
         }
@@ -16,6 +20,7 @@ namespace WS2Common {
 		void RaceTrackPathSceneNode::setTrackPath(Animation::RaceTrackPath *value)
 		{
 			trackPath = value;
+			markDirty();
 		}
     }
 }
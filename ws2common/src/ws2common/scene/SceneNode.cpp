@@ -1,17 +1,51 @@
 #include "ws2common/scene/SceneNode.hpp"
 #include "ws2common/SerializeUtils.hpp"
 #include <QtAlgorithms>
+#include <QAtomicInteger>
 #include <QDebug>
 
 namespace WS2Common {
     namespace Scene {
+        /**
+         * @brief The last revision handed out to any node
+         *
+         * Nodes are created on several threads at once when parsing item groups in parallel
+         */
+        static QAtomicInteger<quint64> lastRevision(0);
+
         SceneNode::SceneNode(const QString name) {
             this->name = name;
         }
 
+        SceneNode::SceneNode(const SceneNode &other) :
+            name(other.name),
+            uuid(other.uuid),
+            parent(nullptr),
+            originPosition(other.originPosition),
+            originRotation(other.originRotation),
+            transform(other.transform),
+            conveyorSpeed(other.conveyorSpeed),
+            animationGroupId(other.animationGroupId),
+            animationSeesawType(other.animationSeesawType),
+            seesawSensitivity(other.seesawSensitivity),
+            seesawFriction(other.seesawFriction),
+            seesawSpring(other.seesawSpring),
+            textureScroll(other.textureScroll) {
+            //Animations are deleted along with the node, so each copy needs its own
+            if (other.animation != nullptr) animation = new Animation::TransformAnimation(*other.animation);
+            if (other.effectAnimation != nullptr) effectAnimation = new Animation::EffectAnimation(*other.effectAnimation);
+
+            for (const SceneNode *child : other.children) addChild(child->clone());
+        }
+
         SceneNode::~SceneNode() {
             qDeleteAll(children);
             if (animation != nullptr) delete animation;
+            if (effectAnimation != nullptr) delete effectAnimation;
+        }
+
+        SceneNode* SceneNode::clone() const {
+            return new SceneNode(*this);
         }
 
         const QString SceneNode::getName() const {
@@ -20,6 +54,7 @@ namespace WS2Common {
 
         void SceneNode::setName(const QString name) {
             this->name = name;
+            markDirty();
         }
 
         const QUuid SceneNode::getUuid() const {
@@ -28,6 +63,7 @@ namespace WS2Common {
 
         void SceneNode::setUuid(const QUuid uuid) {
             this->uuid = uuid;
+            markDirty();
         }
 
         SceneNode* SceneNode::findNodeByUuid(const QUuid &uuid) {
@@ -84,10 +120,12 @@ namespace WS2Common {
         void SceneNode::addChild(SceneNode *child) {
             child->setParent(this);
             children.append(child);
+            markSubtreeDirty();
         }
 
         int SceneNode::removeChild(SceneNode *child, bool shouldDelete) {
             int removed = children.removeAll(child);
+            if (removed > 0) markSubtreeDirty();
             if (shouldDelete) delete child;
 
             return removed;
@@ -115,6 +153,7 @@ namespace WS2Common {
 
         void SceneNode::setOriginPosition(const glm::vec3 originPosition) {
             this->originPosition = originPosition;
+            markDirty();
         }
 
         glm::vec3 SceneNode::getOriginRotation() const {
@@ -123,6 +162,7 @@ namespace WS2Common {
 
         void SceneNode::setOriginRotation(const glm::vec3 originRotation) {
             this->originRotation = originRotation;
+            markDirty();
         }
 
         const Transform& SceneNode::getTransform() const {
@@ -130,6 +170,7 @@ namespace WS2Common {
         }
 
         Transform& SceneNode::getTransform() {
+            markDirty();
             return transform;
         }
 
@@ -139,6 +180,7 @@ namespace WS2Common {
 
         void SceneNode::setPosition(const glm::vec3 position) {
             transform.setPosition(position);
+            markDirty();
         }
 
         glm::vec3 SceneNode::getRotation() const {
@@ -147,6 +189,7 @@ namespace WS2Common {
 
         void SceneNode::setRotation(const glm::vec3 rotation) {
             transform.setRotation(rotation);
+            markDirty();
         }
 
         glm::vec3 SceneNode::getScale() const {
@@ -155,6 +198,7 @@ namespace WS2Common {
 
         void SceneNode::setScale(const glm::vec3 scale) {
             transform.setScale(scale);
+            markDirty();
         }
 
         glm::vec3 SceneNode::getConveyorSpeed() const {
@@ -163,18 +207,22 @@ namespace WS2Common {
 
         void SceneNode::setConveyorSpeed(const glm::vec3 conveyorSpeed) {
             this->conveyorSpeed = conveyorSpeed;
+            markDirty();
         }
 
         void SceneNode::setTransformAnimation(Animation::TransformAnimation *anim) {
             animation = anim;
+            markDirty();
         }
 
         void SceneNode::removeTransformAnimation() {
             delete animation;
             animation = nullptr;
+            markDirty();
         }
 
         Animation::TransformAnimation* SceneNode::getTransformAnimation() {
+            markDirty();
             return animation;
         }
 
@@ -184,6 +232,7 @@ namespace WS2Common {
 
         void SceneNode::setAnimationGroupId(unsigned int animationGroupId) {
             this->animationGroupId = animationGroupId;
+            markDirty();
         }
 
         unsigned int SceneNode::getAnimationGroupId() const {
@@ -192,6 +241,7 @@ namespace WS2Common {
 
         void SceneNode::setAnimationSeesawType(EnumAnimationSeesawType type) {
             this->animationSeesawType = type;
+            markDirty();
         }
 
         EnumAnimationSeesawType SceneNode::getAnimationSeesawType() const {
@@ -204,6 +254,7 @@ namespace WS2Common {
 
         void SceneNode::setSeesawSensitivity(float value) {
             seesawSensitivity = value;
+            markDirty();
         }
 
         float SceneNode::getSeesawFriction() const {
@@ -212,6 +263,7 @@ namespace WS2Common {
 
         void SceneNode::setSeesawFriction(float value) {
             seesawFriction = value;
+            markDirty();
         }
 
         float SceneNode::getSeesawSpring() const {
@@ -220,6 +272,7 @@ namespace WS2Common {
 
         void SceneNode::setSeesawSpring(float value) {
             seesawSpring = value;
+            markDirty();
         }
 
         glm::vec2 SceneNode::getTextureScroll() const {
@@ -228,6 +281,7 @@ namespace WS2Common {
 
         void SceneNode::setTextureScroll(glm::vec2 textureScroll) {
             this->textureScroll = textureScroll;
+            markDirty();
         }
 
         void SceneNode::serializeXml(QXmlStreamWriter &s) const {
@@ -244,18 +298,88 @@ namespace WS2Common {
             s.writeEndElement();
         }
 
+        const QByteArray& SceneNode::serializeXmlCached() const {
+            if (cachedXmlRevision == subtreeRevision) return cachedXml;
+
+            if (cachedHeadRevision != dataRevision) {
+                //Written just like serializeXml, but stopping where the children start
+                cachedHeadXml.clear();
+                QXmlStreamWriter s(&cachedHeadXml);
+
+                s.writeStartElement("node-" + getSerializableName());
+
+                s.writeStartElement("data");
+                serializeNodeDataXml(s);
+                s.writeEndElement();
+
+                cachedHeadRevision = dataRevision;
+            }
+
+            const QByteArray tail = "</node-" + getSerializableName().toUtf8() + ">";
+
+            if (children.isEmpty()) {
+                //QXmlStreamWriter writes empty elements self closed
+                cachedXml = cachedHeadXml + "<children/>" + tail;
+            } else {
+                QVector<const QByteArray*> childXml;
+                childXml.reserve(children.size());
+                int size = cachedHeadXml.size() + 21 + tail.size(); //21 is <children></children>
+                for (const SceneNode *child : children) {
+                    childXml.append(&child->serializeXmlCached());
+                    size += childXml.last()->size();
+                }
+
+                cachedXml.clear();
+                cachedXml.reserve(size);
+                cachedXml += cachedHeadXml;
+                cachedXml += "<children>";
+                for (const QByteArray *xml : childXml) cachedXml += *xml;
+                cachedXml += "</children>";
+                cachedXml += tail;
+            }
+
+            cachedXmlRevision = subtreeRevision;
+            return cachedXml;
+        }
+
+        void SceneNode::markDirty() {
+            dataRevision = takeRevision();
+            markSubtreeDirty();
+        }
+
+        quint64 SceneNode::getDataRevision() const {
+            return dataRevision;
+        }
+
+        quint64 SceneNode::getSubtreeRevision() const {
+            return subtreeRevision;
+        }
+
+        quint64 SceneNode::takeRevision() {
+            return lastRevision.fetchAndAddRelaxed(1) + 1;
+        }
+
+        void SceneNode::markSubtreeDirty() {
+            quint64 revision = takeRevision();
+            for (SceneNode *node = this; node != nullptr; node = node->parent) node->subtreeRevision = revision;
+        }
+
         const QString SceneNode::getSerializableName() const {
             return "sceneNode";
         }
 
-        Animation::EffectAnimation *SceneNode::getEffectAnimation() const
-        {
+        Animation::EffectAnimation* SceneNode::getEffectAnimation() {
+            markDirty();
             return effectAnimation;
         }
-        
-        void SceneNode::setEffectAnimation(Animation::EffectAnimation *value)
-        {
+
+        const Animation::EffectAnimation* SceneNode::getEffectAnimation() const {
+            return effectAnimation;
+        }
+
+        void SceneNode::setEffectAnimation(Animation::EffectAnimation *value) {
             effectAnimation = value;
+            markDirty();
         }
         
         void SceneNode::serializeNodeDataXml(QXmlStreamWriter &s) const {
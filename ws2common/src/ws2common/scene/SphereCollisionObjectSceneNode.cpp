@@ -4,6 +4,10 @@ namespace WS2Common {
     namespace Scene {
         SphereCollisionObjectSceneNode::SphereCollisionObjectSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* SphereCollisionObjectSceneNode::clone() const {
+            return new SphereCollisionObjectSceneNode(*this);
+        }
+
         const QString SphereCollisionObjectSceneNode::getSerializableName() const {
             return "sphereCollisionObjectSceneNode";
         }
@@ -14,6 +18,7 @@ namespace WS2Common {
 
         void SphereCollisionObjectSceneNode::setRadius(float radius) {
             this->radius = radius;
+            markDirty();
         }
     }
 }
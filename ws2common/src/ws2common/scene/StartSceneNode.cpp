@@ -4,6 +4,10 @@ namespace WS2Common {
     namespace Scene {
         StartSceneNode::StartSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* StartSceneNode::clone() const {
+            return new StartSceneNode(*this);
+        }
+
         const QString StartSceneNode::getSerializableName() const {
             return "startSceneNode";
         }
@@ -16,6 +20,7 @@ namespace WS2Common {
         void StartSceneNode::setPlayerID(unsigned int value)
         {
             playerID = value;
+            markDirty();
         }
     }
 }
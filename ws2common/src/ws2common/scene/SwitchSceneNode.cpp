@@ -5,12 +5,17 @@ namespace WS2Common {
     namespace Scene {
         SwitchSceneNode::SwitchSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* SwitchSceneNode::clone() const {
+            return new SwitchSceneNode(*this);
+        }
+
         EnumPlaybackState SwitchSceneNode::getType() const {
             return type;
         }
 
         void SwitchSceneNode::setType(EnumPlaybackState type) {
             this->type = type;
+            markDirty();
         }
 
         unsigned short SwitchSceneNode::getLinkedAnimGroupId() const {
@@ -19,6 +24,7 @@ namespace WS2Common {
 
         void SwitchSceneNode::setLinkedAnimGroupId(unsigned short linkedAnimGroupId) {
             this->linkedAnimGroupId = linkedAnimGroupId;
+            markDirty();
         }
     }
 }
@@ -4,12 +4,17 @@ namespace WS2Common {
     namespace Scene {
         WormholeSceneNode::WormholeSceneNode(const QString name) : SceneNode(name) {}
 
+        SceneNode* WormholeSceneNode::clone() const {
+            return new WormholeSceneNode(*this);
+        }
+
         const QUuid& WormholeSceneNode::getDestinationUuid() const {
             return destinationUuid;
         }
 
         void WormholeSceneNode::setDestinationUuid(QUuid destinationUuid) {
             this->destinationUuid = destinationUuid;
+            markDirty();
         }
 
         const QString WormholeSceneNode::getSerializableName() const {
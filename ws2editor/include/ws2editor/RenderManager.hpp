@@ -42,6 +42,11 @@ namespace WS2Editor {
         protected:
             WS2EDITOR_EXPORT static const qint64 CACHE_TIMEOUT = 30 * 1000; //30s = 30 * 1000 ms
 
+            /**
+             * @brief Textures are first shown scaled down to fit in this many pixels, while the full size is decoded
+             */
+            WS2EDITOR_EXPORT static const int TEXTURE_PREVIEW_SIZE = 128;
+
             QQueue<Rendering::IRenderCommand*> renderFifo;
             QQueue<Rendering::IRenderCommand*> renderSelectionFifo;
 
@@ -117,8 +122,8 @@ namespace WS2Editor {
             /**
              * @brief Loads a ResourceTexture to a GL texture
              *
-             * The default texture will be loaded into the textureCache, before it is replaced with the provided texture
-             * when it has loaded
+             * The default texture will be loaded into the textureCache, before it is replaced with a downscaled preview,
+             * then the full texture, as they are decoded on the thread pool
              *
              * @param texture A loaded ResourceTexture
              */
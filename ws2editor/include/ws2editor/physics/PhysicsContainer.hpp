@@ -49,7 +49,7 @@ namespace WS2Editor {
 
                 ~PhysicsContainer();
 
-                void updateTransform(WS2Common::Transform &transform);
+                void updateTransform(const WS2Common::Transform &transform);
 
                 btRigidBody* getRigidBody();
         };
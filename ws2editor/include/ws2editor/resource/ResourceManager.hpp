@@ -8,6 +8,7 @@
 
 #include "ws2editor_export.h"
 #include "ws2common/resource/ResourceMesh.hpp"
+#include "ws2common/resource/TextureManager.hpp"
 #include <QVector>
 #include <QFile>
 #include <QDir>
@@ -31,6 +32,13 @@ namespace WS2Editor {
              */
             WS2EDITOR_EXPORT QVector<WS2Common::Resource::AbstractResource*>& getResources();
 
+            /**
+             * @brief Getter for the texture manager, which indexes and decodes the textures in the resources vector
+             *
+             * @return A reference to the texture manager
+             */
+            WS2EDITOR_EXPORT WS2Common::Resource::TextureManager& getTextureManager();
+
             /**
              * @brief Adds a resource to the WS2Editor::Resource::ResourceManager::resources vector
              * @note WS2Editor::Resource::ResourceManager should be the owner of all resources, therefore **do not** delete
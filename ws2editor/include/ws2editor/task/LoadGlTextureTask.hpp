@@ -18,9 +18,17 @@ namespace WS2Editor {
 
             protected:
                 const WS2Common::Resource::ResourceTexture &tex;
+                int previewSize;
 
             public:
-                LoadGlTextureTask(const WS2Common::Resource::ResourceTexture &tex);
+                /**
+                 * @brief Creates a task to decode a texture for GL
+                 *
+                 * @param tex The texture to decode
+                 * @param previewSize If above 0, a preview scaled down to fit within previewSize x previewSize is
+                 *                    decoded and sent first, so something shows up before a big texture is decoded
+                 */
+                LoadGlTextureTask(const WS2Common::Resource::ResourceTexture &tex, int previewSize = 0);
 
                 void runTask(Progress *prog) override;
                 QString getTranslatedMessage() override;
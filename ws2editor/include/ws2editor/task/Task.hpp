@@ -48,6 +48,13 @@ namespace WS2Editor {
 
             signals:
                 void onFinished(Task *obj);
+
+                /**
+                 * @brief Emit this when the result of getTranslatedMessage() changes, to update the status shown
+                 *
+                 * @param obj The task whose message changed
+                 */
+                void onMessageChanged(Task *obj);
         };
     }
 }
@@ -17,8 +17,6 @@ namespace WS2Editor {
             Q_OBJECT
 
             protected:
-                Progress *progress = new Progress();
-
                 /**
                  * @brief A vector of tasks that are currently running async/queued up to run soon
                  *
@@ -59,6 +57,13 @@ namespace WS2Editor {
                  * @param obj The task that just finished
                  */
                 void onTaskFinished(Task *obj);
+
+                /**
+                 * @brief Emits messageChanged with an updated status message
+                 *
+                 * @param obj The task whose message changed
+                 */
+                void onTaskMessageChanged(Task *obj);
         };
     }
 }
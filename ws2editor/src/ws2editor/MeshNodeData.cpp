@@ -10,13 +10,13 @@ namespace WS2Editor {
     MeshNodeData::MeshNodeData(SceneNode *node, ResourceMesh *mesh) :
         node(node),
         meshes(QVector<ResourceMesh*> {mesh}) {
-        physicsContainer = new PhysicsContainer(node, meshes, node->getTransform());
+        physicsContainer = new PhysicsContainer(node, meshes, static_cast<const SceneNode*>(node)->getTransform());
     }
 
     MeshNodeData::MeshNodeData(SceneNode *node, QVector<ResourceMesh*>& meshes) :
         node(node),
         meshes(meshes) {
-        physicsContainer = new PhysicsContainer(node, meshes, node->getTransform());
+        physicsContainer = new PhysicsContainer(node, meshes, static_cast<const SceneNode*>(node)->getTransform());
     }
 
     const SceneNode* MeshNodeData::getNode() const {
@@ -398,9 +398,8 @@ namespace WS2Editor {
         if (texture->isLoaded()) {
             img = *texture->getTexture();
         } else {
-            img = QImage(*texture->getFirstFilePath());
-
-            LoadGlTextureTask *task = new LoadGlTextureTask(*texture);
+            //Don't decode anything here - that's left to the task, so the render thread doesn't stall on big images
+            LoadGlTextureTask *task = new LoadGlTextureTask(*texture, TEXTURE_PREVIEW_SIZE);
             connect(task, &LoadGlTextureTask::addTexture, this, &RenderManager::addTexture);
             WS2EditorInstance::getInstance()->getTaskManager()->enqueueTask(task);
 
@@ -756,6 +755,14 @@ namespace WS2Editor {
     }
 
     void RenderManager::addTexture(const QImage image, const ResourceTexture *tex) {
+        //Free the preview this replaces, if any
+        CachedGlTexture *previous = textureCache.value(tex);
+        if (previous != nullptr && previous != defaultTexture) {
+            GLuint texId = previous->getTextureId();
+            glDeleteTextures(1, &texId);
+            delete previous;
+        }
+
         textureCache[tex] = loadTexture(image);
     }
 
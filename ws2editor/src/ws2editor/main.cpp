@@ -6,10 +6,12 @@
 #include "ws2editor/command/CommandInterpreter.hpp"
 #include "ws2editor/plugin/IEditorPlugin.hpp"
 #include "ws2common/MessageHandler.hpp"
+#include "ws2common/model/ModelLoader.hpp"
 #include <QFile>
 #include <QSurfaceFormat>
 #include <QSplashScreen>
 #include <QTranslator>
+#include <QStandardPaths>
 
 namespace WS2Editor {
     WS2EDITOR_EXPORT int ws2editorLaunch(int argc, char *argv[]) {
@@ -36,6 +38,18 @@ namespace WS2Editor {
             qApp->installTranslator(&translator);
         }
 
+        //Vertex welding is left off, as it reorders collision triangles - LZ exports from the editor would no longer
+        //match ws2lzfrontend's byte for byte
+
+        //Cache imported models, so reopening a stage doesn't have to import them all over again
+        WS2Common::Model::ModelLoader::setMeshCacheDirectory(
+                QDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)).filePath("ws2editor/meshcache"));
+
+        //Look textures up by path instead of searching every resource, and cache decoded textures
+        WS2Common::Model::ModelLoader::setTextureManager(&WS2Editor::Resource::ResourceManager::getTextureManager());
+        WS2Editor::Resource::ResourceManager::getTextureManager().setCacheDirectory(
+                QDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)).filePath("ws2editor/texturecache"));
+
         //Init command interpreter
         Command::CommandInterpreter::createInstance();
 
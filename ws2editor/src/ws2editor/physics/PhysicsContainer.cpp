@@ -65,7 +65,7 @@ namespace WS2Editor {
             delete physicsRigidBody;
         }
 
-        void PhysicsContainer::updateTransform(Transform &transform) {
+        void PhysicsContainer::updateTransform(const Transform &transform) {
             glm::quat rotQuat = MathUtils::eulerZyxToGlmQuat(transform.getRotation());
 
             btTransform bulletTransform(
@@ -25,6 +25,11 @@ namespace WS2Editor {
                 return resources;
             }
 
+            TextureManager& getTextureManager() {
+                static TextureManager textureManager(&getResources(), &resourcesMutex);
+                return textureManager;
+            }
+
             void addResource(WS2Common::Resource::AbstractResource *res) {
                 resourcesMutex.lock();
                 getResources().append(res);
@@ -62,7 +62,7 @@ namespace WS2Editor {
 
             //Search for non-animated nodes
             for (SceneNode *node : stage->getRootNode()->getChildren()) {
-                if (node->getTransformAnimation() == nullptr) return node;
+                if (static_cast<const SceneNode*>(node)->getTransformAnimation() == nullptr) return node;
             }
 
             //Nothing found
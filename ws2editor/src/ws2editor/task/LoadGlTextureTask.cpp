@@ -1,17 +1,37 @@
 #include "ws2editor/task/LoadGlTextureTask.hpp"
 #include "ws2editor/RenderManager.hpp"
 #include "ws2editor/task/TaskManager.hpp"
+#include "ws2editor/resource/ResourceManager.hpp"
+#include <QImageReader>
 
 namespace WS2Editor {
     namespace Task {
         using namespace WS2Common::Resource;
 
-        LoadGlTextureTask::LoadGlTextureTask(const ResourceTexture &tex) :
+        LoadGlTextureTask::LoadGlTextureTask(const ResourceTexture &tex, int previewSize) :
             Task(),
-            tex(tex) {}
+            tex(tex),
+            previewSize(previewSize) {}
 
         void LoadGlTextureTask::runTask(Progress *prog) {
-            QImage img(*tex.getFirstFilePath());
+            TextureManager &textureManager = Resource::ResourceManager::getTextureManager();
+            const QString filePath = *tex.getFirstFilePath();
+
+            if (previewSize > 0) {
+                QImage preview = textureManager.decode(filePath, previewSize);
+                if (preview.isNull()) return; //Keep showing the default texture
+
+                emit addTexture(RenderManager::convertToGLFormat(preview), &tex);
+
+                //Textures no bigger than the preview size were decoded at full size already - check the file's own size,
+                //as a larger texture scaled down to fit can end up exactly the preview size too
+                QSize fullSize = QImageReader(filePath).size();
+                if (!fullSize.isValid() || (fullSize.width() <= previewSize && fullSize.height() <= previewSize)) return;
+            }
+
+            QImage img = textureManager.decode(filePath);
+            if (img.isNull()) return;
+
             emit addTexture(RenderManager::convertToGLFormat(img), &tex);
         }
 
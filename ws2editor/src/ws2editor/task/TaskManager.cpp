@@ -1,16 +1,20 @@
 #include "ws2editor/task/TaskManager.hpp"
-#include <QThreadPool>
+#include "ws2common/ThreadPoolUtils.hpp"
 #include <QDebug>
 
 namespace WS2Editor {
     namespace Task {
         void TaskManager::enqueueTask(Task *task) {
             connect(task, &Task::onFinished, this, &TaskManager::onTaskFinished);
+            connect(task, &Task::onMessageChanged, this, &TaskManager::onTaskMessageChanged);
             task->setAutoDelete(false);
-            task->setProgress(progress);
-            QThreadPool::globalInstance()->start(task);
 
-            runningTasks[task] = new Progress();
+            //Each task gets its own progress tracker, as tasks may run concurrently
+            Progress *taskProgress = new Progress();
+            runningTasks[task] = taskProgress;
+            task->setProgress(taskProgress);
+            WS2Common::ThreadPoolUtils::startGlobal(task);
+
             emit messageChanged(getStatusString());
         }
 
@@ -35,6 +39,13 @@ namespace WS2Editor {
 
             delete obj;
         }
+
+        void TaskManager::onTaskMessageChanged(Task *obj) {
+            //The task may have finished before this queued signal arrived
+            if (!runningTasks.contains(obj)) return;
+
+            emit messageChanged(getStatusString());
+        }
     }
 }
 
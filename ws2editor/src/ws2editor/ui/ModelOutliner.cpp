@@ -282,7 +282,7 @@ namespace WS2Editor {
             MeshNodeData *meshData = Project::ProjectManager::getActiveProject()->getScene()->getMeshNodeData(node->getUuid());
 
             if (meshData != nullptr) {
-                meshData->getPhysicsContainer()->updateTransform(node->getTransform());
+                meshData->getPhysicsContainer()->updateTransform(static_cast<const SceneNode*>(node)->getTransform());
             }
 
             //Signal the data change
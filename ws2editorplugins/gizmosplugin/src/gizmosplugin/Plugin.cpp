@@ -172,7 +172,7 @@ namespace WS2EditorPlugins {
 
                     preGrabTransforms.clear();
                     for (SceneNode *node : topmostSelected) {
-                        preGrabTransforms[node] = node->getTransform(); //Copy the initial transforms for each node
+                        preGrabTransforms[node] = static_cast<const SceneNode*>(node)->getTransform(); //Copy the initial transforms for each node
                     }
                 }
             }
@@ -0,0 +1,125 @@
+/**
+ * @file
+ * @brief Header for the LzExportTask class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2EDITORPLUGINS_LZEXPORTPROVIDERPLUGIN_LZEXPORTTASK_HPP
+#define SMBLEVELWORKSHOP2_WS2EDITORPLUGINS_LZEXPORTPROVIDERPLUGIN_LZEXPORTTASK_HPP
+
+#include "ws2editor/task/Task.hpp"
+#include "ws2common/Stage.hpp"
+#include "ws2common/resource/ResourceMesh.hpp"
+#include "ws2lz/CollisionCache.hpp"
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+
+namespace WS2EditorPlugins {
+    namespace LzExportProviderPlugin {
+
+        /**
+         * @brief Generates an LZ in the background and writes it to files
+         *
+         * The stage and the collision meshes it uses are copied when the task is created, so the scene can keep
+         * being edited while the export runs
+         */
+        class LzExportTask : public WS2Editor::Task::Task {
+            Q_OBJECT
+
+            protected:
+                /**
+                 * @brief A snapshot of the stage being exported - owned by this task
+                 */
+                WS2Common::Stage *stage;
+
+                /**
+                 * @brief Snapshots of every mesh used for collision in the stage - owned by this task
+                 */
+                QHash<QString, WS2Common::Resource::ResourceMesh*> models;
+
+                QStringList targetFiles;
+                bool compress;
+
+                /**
+                 * @brief Optional - may be nullptr
+                 */
+                WS2Lz::CollisionCache *collisionCache;
+
+                /**
+                 * @brief What the task is currently doing, shown in the status bar
+                 */
+                QString status;
+
+                /**
+                 * @brief How many stages of the export are done, out of stepCount, shown in the status bar
+                 */
+                unsigned int currentStep = 0;
+                unsigned int stepCount = 0;
+
+                /**
+                 * @brief Guards status, currentStep and stepCount
+                 */
+                QMutex statusMutex;
+
+            protected:
+                /**
+                 * @brief Recursive function - Copies the mesh of every MeshCollisionSceneNode in node and its children
+                 *        into models
+                 *
+                 * @param node The node to recursively search
+                 * @param sourceModels All meshes, to copy from
+                 */
+                void snapshotCollisionMeshes(
+                        const WS2Common::Scene::SceneNode *node,
+                        const QHash<QString, WS2Common::Resource::ResourceMesh*> &sourceModels
+                        );
+
+                void setStatus(const QString &status);
+
+                /**
+                 * @brief Marks the current stage of the export as done
+                 *
+                 * @param prog The progress tracker to increment (Optional - may be nullptr)
+                 */
+                void finishStep(WS2Editor::Progress *prog);
+
+            public:
+                /**
+                 * @brief Constructor for LzExportTask - This should be created on the GUI thread, as it copies the
+                 *        stage and meshes
+                 *
+                 * @param stage The stage to export
+                 * @param sourceModels All meshes available, by name
+                 * @param targetFiles Files to write the LZ to
+                 * @param compress Whether to compress the LZ before writing it
+                 * @param collisionCache Cache to reuse optimized collision from (Optional - may be nullptr)
+                 */
+                LzExportTask(
+                        const WS2Common::Stage &stage,
+                        const QHash<QString, WS2Common::Resource::ResourceMesh*> &sourceModels,
+                        QStringList targetFiles,
+                        bool compress,
+                        WS2Lz::CollisionCache *collisionCache
+                        );
+
+                /**
+                 * @brief Deletes the stage and mesh snapshots
+                 */
+                ~LzExportTask();
+
+                void runTask(WS2Editor::Progress *prog) override;
+                QString getTranslatedMessage() override;
+
+            signals:
+                /**
+                 * @brief Emitted from the task's thread if the LZ could not be written to one or more target files
+                 *
+                 * @param message A user friendly message listing the files that failed
+                 */
+                void exportFailed(QString message);
+        };
+    }
+}
+
+#endif
+
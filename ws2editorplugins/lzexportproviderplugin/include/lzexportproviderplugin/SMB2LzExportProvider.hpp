@@ -0,0 +1,30 @@
+/**
+ * @file
+ * @brief ws2editor compressed LZ export provider for Super Monkey Ball 2
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2EDITORPLUGINS_LZEXPORTPROVIDERPLUGIN_SMB2LZEXPORTPROVIDER_HPP
+#define SMBLEVELWORKSHOP2_WS2EDITORPLUGINS_LZEXPORTPROVIDERPLUGIN_SMB2LZEXPORTPROVIDER_HPP
+
+#include "lzexportproviderplugin/SMB2RawLzExportProvider.hpp"
+
+namespace WS2EditorPlugins {
+    namespace LzExportProviderPlugin {
+        /**
+         * @brief Same as SMB2RawLzExportProvider, but compresses the LZ so it can be used in-game as is
+         */
+        class SMB2LzExportProvider : public SMB2RawLzExportProvider {
+            Q_OBJECT
+
+            protected:
+                virtual bool shouldCompress() override;
+
+            public:
+                virtual QString getTranslatedTypeName() override;
+                virtual QVector<QPair<QString, QString>> getNameFilters() override;
+        };
+    }
+}
+
+#endif
+
@@ -8,16 +8,38 @@
 
 #include "ws2editor/plugin/IEditorPlugin.hpp"
 #include "ws2editor/IExportProvider.hpp"
+#include "ws2lz/CollisionCache.hpp"
 
 namespace WS2EditorPlugins {
     namespace LzExportProviderPlugin {
         class SMB2RawLzExportProvider : public WS2Editor::IExportProvider {
             Q_OBJECT
 
+            protected:
+                /**
+                 * @brief Kept across exports so that item groups with unchanged collision don't need optimizing again
+                 */
+                WS2Lz::CollisionCache collisionCache;
+
+            protected:
+                /**
+                 * @brief Whether exported LZs should be compressed before being written
+                 *
+                 * @return false - Raw LZs are left uncompressed
+                 */
+                virtual bool shouldCompress();
+
             public:
                 virtual QString getTranslatedTypeName() override;
                 virtual QVector<QPair<QString, QString>> getNameFilters() override;
                 virtual WS2Common::Result<void, QString> checkProject(WS2Editor::Project::Project *project) override;
+
+                /**
+                 * @brief Snapshots the project's stage, then generates and writes the LZ in a background task
+                 *
+                 * @param targetFiles A list of files to save to
+                 * @param project The project to export
+                 */
                 virtual void exportFiles(QStringList targetFiles, WS2Editor::Project::Project *project) override;
         };
     }
@@ -0,0 +1,151 @@
+#include "lzexportproviderplugin/LzExportTask.hpp"
+#include "ws2lz/SMB2LzExporter.hpp"
+#include "ws2lz/LZCompressor.hpp"
+#include "ws2common/scene/MeshCollisionSceneNode.hpp"
+#include "ws2common/ThreadPoolUtils.hpp"
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QBuffer>
+#include <QFile>
+#include <QDebug>
+
+namespace WS2EditorPlugins {
+    namespace LzExportProviderPlugin {
+        using namespace WS2Common;
+        using namespace WS2Common::Resource;
+
+        LzExportTask::LzExportTask(
+                const Stage &stage,
+                const QHash<QString, ResourceMesh*> &sourceModels,
+                QStringList targetFiles,
+                bool compress,
+                WS2Lz::CollisionCache *collisionCache
+                ) :
+            Task(),
+            stage(stage.clone()),
+            targetFiles(targetFiles),
+            compress(compress),
+            collisionCache(collisionCache),
+            status(tr("Waiting")) {
+            snapshotCollisionMeshes(this->stage->getRootNode(), sourceModels);
+        }
+
+        LzExportTask::~LzExportTask() {
+            delete stage;
+            qDeleteAll(models);
+        }
+
+        void LzExportTask::snapshotCollisionMeshes(const Scene::SceneNode *node, const QHash<QString, ResourceMesh*> &sourceModels) {
+            if (const Scene::MeshCollisionSceneNode *coli = dynamic_cast<const Scene::MeshCollisionSceneNode*>(node)) {
+                const QString &meshName = coli->getMeshName();
+
+                if (!models.contains(meshName) && sourceModels.contains(meshName)) {
+                    //Only vertex positions and indices are needed for collision - leave textures out
+                    //Vertex/index vectors are implicitly shared, so this is cheap until the original is modified
+                    ResourceMesh *mesh = new ResourceMesh();
+                    mesh->setId(meshName);
+                    for (const Model::MeshSegment *seg : sourceModels.value(meshName)->getMeshSegments()) {
+                        mesh->addMeshSegment(new Model::MeshSegment(seg->getVertices(), seg->getIndices(), QVector<ResourceTexture*>()));
+                    }
+
+                    models[meshName] = mesh;
+                }
+            }
+
+            for (const Scene::SceneNode *child : node->getChildren()) {
+                snapshotCollisionMeshes(child, sourceModels);
+            }
+        }
+
+        void LzExportTask::setStatus(const QString &status) {
+            {
+                QMutexLocker locker(&statusMutex);
+                this->status = status;
+            }
+
+            emit onMessageChanged(this);
+        }
+
+        void LzExportTask::finishStep(WS2Editor::Progress *prog) {
+            {
+                QMutexLocker locker(&statusMutex);
+                currentStep++;
+            }
+
+            if (prog != nullptr) prog->inc();
+            emit onMessageChanged(this);
+        }
+
+        void LzExportTask::runTask(WS2Editor::Progress *prog) {
+            QElapsedTimer timer;
+            timer.start();
+
+            //Generating, optionally compressing, then writing each file
+            {
+                QMutexLocker locker(&statusMutex);
+                currentStep = 0;
+                stepCount = 1 + (compress ? 1 : 0) + targetFiles.size();
+            }
+            if (prog != nullptr) prog->begin(stepCount);
+
+            //Generate an LZ
+            setStatus(tr("Optimizing collision and generating"));
+            QBuffer buf;
+            buf.open(QIODevice::ReadWrite);
+            QDataStream dStream(&buf);
+
+            WS2Lz::SMB2LzExporter exporter;
+            exporter.setModels(models);
+            exporter.setCollisionCache(collisionCache);
+
+            {
+                //The exporter waits on collision optimization tasks in the global thread pool - let another thread run
+                //in this one's place while it waits, otherwise this could deadlock with few threads
+                ThreadPoolUtils::WaitScope waitScope;
+                exporter.generate(dStream, *stage);
+            }
+
+            QByteArray data = buf.data();
+            finishStep(prog);
+
+            if (compress) {
+                setStatus(tr("Compressing"));
+                WS2Lz::LZCompressor compressor;
+                data = compressor.compress(data);
+                finishStep(prog);
+            }
+
+            //Write it to each target file
+            QStringList failedFiles;
+            for (const QString &file : targetFiles) {
+                setStatus(tr("Writing %1").arg(file));
+
+                QFile o(file);
+                if (!o.open(QIODevice::WriteOnly)) {
+                    qCritical().noquote() << "Failed to open" << file << "for writing:" << o.errorString();
+                    failedFiles.append(tr("%1 (%2)").arg(file, o.errorString()));
+                } else if (o.write(data) != data.size() || !o.flush()) {
+                    qCritical().noquote() << "Failed to write" << file << ":" << o.errorString();
+                    failedFiles.append(tr("%1 (%2)").arg(file, o.errorString()));
+                }
+
+                finishStep(prog);
+            }
+
+            if (prog != nullptr) prog->end();
+
+            if (!failedFiles.isEmpty()) {
+                emit exportFailed(tr("Failed to write the LZ to:\n%1").arg(failedFiles.join('\n')));
+            }
+
+            qInfo().noquote().nospace() << "Exported LZ in " << timer.nsecsElapsed() / 1000000000.0f << "s";
+        }
+
+        QString LzExportTask::getTranslatedMessage() {
+            QMutexLocker locker(&statusMutex);
+            if (stepCount == 0) return tr("Exporting LZ: %1").arg(status);
+            return tr("Exporting LZ (%1/%2): %3").arg(qMin(currentStep + 1, stepCount)).arg(stepCount).arg(status);
+        }
+    }
+}
+
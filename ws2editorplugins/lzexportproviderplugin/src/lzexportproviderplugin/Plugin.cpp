@@ -1,5 +1,6 @@
 #include "lzexportproviderplugin/Plugin.hpp"
 #include "lzexportproviderplugin/SMB2RawLzExportProvider.hpp"
+#include "lzexportproviderplugin/SMB2LzExportProvider.hpp"
 #include "ws2editor/WS2EditorInstance.hpp"
 #include <QDebug>
 
@@ -8,8 +9,9 @@ namespace WS2EditorPlugins {
         using namespace WS2Editor;
 
         bool Plugin::init() {
-            //Create and register our export provider
+            //Create and register our export providers
             WS2EditorInstance::getInstance()->registerExportProvider(new SMB2RawLzExportProvider());
+            WS2EditorInstance::getInstance()->registerExportProvider(new SMB2LzExportProvider());
 
             //The plugin initialized successfully, return true
             qInfo() << "WS2Editor LZExportProviderPlugin successfully initialized";
@@ -0,0 +1,21 @@
+#include "lzexportproviderplugin/SMB2LzExportProvider.hpp"
+
+namespace WS2EditorPlugins {
+    namespace LzExportProviderPlugin {
+        bool SMB2LzExportProvider::shouldCompress() {
+            return true;
+        }
+
+        QString SMB2LzExportProvider::getTranslatedTypeName() {
+            return tr("Super Monkey Ball 2 LZ [*.lz]");
+        }
+
+        QVector<QPair<QString, QString>> SMB2LzExportProvider::getNameFilters() {
+            QPair<QString, QString> entry(tr("Compressed LZ (*.lz)"), ".lz");
+
+            QVector<QPair<QString, QString>> vec = {entry};
+            return vec;
+        }
+    }
+}
+
@@ -1,9 +1,12 @@
 #include "lzexportproviderplugin/SMB2RawLzExportProvider.hpp"
+#include "lzexportproviderplugin/LzExportTask.hpp"
+#include "ws2editor/WS2EditorInstance.hpp"
 #include "ws2editor/resource/ResourceManager.hpp"
-#include "ws2lz/SMB2LzExporter.hpp"
+#include "ws2editor/ui/StatusPopupWidget.hpp"
 #include "ws2common/scene/StartSceneNode.hpp"
 #include <QInputDialog>
-#include <QBuffer>
+#include <QApplication>
+#include <QCursor>
 #include <QDebug>
 
 namespace WS2EditorPlugins {
@@ -62,6 +65,10 @@ namespace WS2EditorPlugins {
             }
         }
 
+        bool SMB2RawLzExportProvider::shouldCompress() {
+            return false;
+        }
+
         void SMB2RawLzExportProvider::exportFiles(QStringList targetFiles, Project *project) {
             //Fetch models from the resource manager
             QHash<QString, ResourceMesh*> models; //name, mesh
@@ -73,23 +80,23 @@ namespace WS2EditorPlugins {
                 }
             }
 
-            //Generate an LZ
-            QBuffer buf;
-            buf.open(QIODevice::ReadWrite);
-            QDataStream dStream(&buf);
+            //Generate the LZ in the background, so the editor stays usable on big stages
+            LzExportTask *task = new LzExportTask(
+                    *project->getScene()->getStage(),
+                    models,
+                    targetFiles,
+                    shouldCompress(),
+                    &collisionCache
+                    );
 
-            WS2Lz::SMB2LzExporter exporter;
+            //The task emits from its own thread - this queues the popup onto the GUI thread
+            connect(task, &LzExportTask::exportFailed, this, [](QString message) {
+                WS2Editor::UI::StatusPopupWidget *w = new WS2Editor::UI::StatusPopupWidget(
+                        QCursor::pos(), message, "statusMessageFailed", QApplication::activeWindow());
+                w->show();
+            });
 
-            exporter.setModels(models);
-            exporter.generate(dStream, *project->getScene()->getStage());
-
-            //Write it to each target file
-            for (QString file : targetFiles) {
-                QFile o(file);
-                o.open(QIODevice::WriteOnly);
-                o.write(buf.data());
-                o.close();
-            }
+            WS2Editor::WS2EditorInstance::getInstance()->getTaskManager()->enqueueTask(task);
         }
     }
 }
@@ -91,9 +91,9 @@ namespace WS2EditorPlugins {
 
             for (SceneNode *node : ProjectManager::getActiveProject()->getScene()->getSelectionManager()->getTopmostSelectedObjects()) {
                 ++numTransforms;
-                avgPosition += node->getTransform().getPosition();
-                avgRotation += node->getTransform().getRotation();
-                avgScale += node->getTransform().getScale();
+                avgPosition += node->getPosition();
+                avgRotation += node->getRotation();
+                avgScale += node->getScale();
             }
 
             avgPosition /= numTransforms;
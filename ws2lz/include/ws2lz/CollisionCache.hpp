@@ -0,0 +1,144 @@
+/**
+ * @file
+ * @brief Header for the CollisionCache class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2LZ_COLLISIONCACHE_HPP
+#define SMBLEVELWORKSHOP2_WS2LZ_COLLISIONCACHE_HPP
+
+#include "ws2lz_export.h"
+#include "ws2common/CollisionGrid.hpp"
+#include <QByteArray>
+#include <QVector>
+#include <QCache>
+#include <QMutex>
+#include <QString>
+
+namespace WS2Lz {
+
+    /**
+     * @brief Collision data for a single item group that can be reused between exports
+     */
+    struct WS2LZ_EXPORT CollisionCacheEntry {
+        /**
+         * @brief Converted collision triangles, exactly as they are written to an LZ (64 bytes per triangle)
+         */
+        QByteArray triangleData;
+
+        /**
+         * @brief Compressed sparse row offsets into tileIndices - Tile i's triangles are
+         *        tileIndices[tileOffsets[i]] to tileIndices[tileOffsets[i + 1]]
+         *
+         * Tiles are ordered the same way as TriangleIntersectionGrid::indicesGrid is (Y, then X)
+         */
+        QVector<quint32> tileOffsets;
+
+        /**
+         * @brief Triangle indices for every grid tile, back to back
+         */
+        QVector<quint16> tileIndices;
+
+        /**
+         * @brief Flattens a TriangleIntersectionGrid indices grid into tileOffsets/tileIndices
+         *
+         * @param indicesGrid The indices grid to flatten
+         */
+        void setIndicesGrid(const QVector<QVector<QVector<quint16>>> &indicesGrid);
+
+        /**
+         * @brief Expands tileOffsets/tileIndices back into a TriangleIntersectionGrid indices grid
+         *
+         * @param grid The collision grid the entry was created with, used for the grid dimensions
+         *
+         * @return The indices grid, stored Y then X
+         */
+        QVector<QVector<QVector<quint16>>> getIndicesGrid(const WS2Common::CollisionGrid &grid) const;
+
+        /**
+         * @return Roughly how many bytes of memory this entry uses
+         */
+        int getCost() const;
+    };
+
+    /**
+     * @brief A content addressed cache for optimized collision and converted collision triangles
+     *
+     * Entries are keyed by a hash of everything that affects an item group's collision output (See
+     * SMB2LzExporter::computeCollisionCacheKey), so an unchanged group can skip collision optimization and triangle
+     * conversion entirely.
+     *
+     * Entries are always kept in memory (up to a cost limit). If a cache directory is set, entries are also persisted
+     * to disk so that they can be reused between runs.
+     *
+     * This is thread safe.
+     */
+    class WS2LZ_EXPORT CollisionCache {
+        protected:
+            /**
+             * @brief Bumped whenever the on disk format or the collision output changes, to invalidate old entries
+             */
+            static const quint32 FORMAT_VERSION = 1;
+
+            QCache<QByteArray, CollisionCacheEntry> memoryCache;
+            QString cacheDirectory;
+
+            /**
+             * @brief Guards memoryCache and cacheDirectory - Not held while reading or writing entry files, so threads
+             *        don't queue up behind each other's disk I/O
+             */
+            QMutex mutex;
+
+            static QString getEntryFilePath(const QString &cacheDirectory, const QByteArray &key);
+            static bool readEntryFromDisk(const QString &filePath, const QByteArray &key, CollisionCacheEntry &entry);
+            static void writeEntryToDisk(const QString &filePath, const QByteArray &key, const CollisionCacheEntry &entry);
+
+        public:
+            /**
+             * @brief Creates an in-memory only collision cache
+             *
+             * @param maxMemoryBytes Roughly how much memory cached entries can use before old ones are evicted
+             */
+            CollisionCache(int maxMemoryBytes = 256 * 1024 * 1024);
+
+            /**
+             * @brief Sets a directory to persist entries to, and read entries from on a memory miss
+             *
+             * @param cacheDirectory The directory to use (It will be created if it doesn't exist), or an empty string
+             *                       to only cache in memory
+             */
+            void setCacheDirectory(const QString &cacheDirectory);
+
+            const QString& getCacheDirectory() const;
+
+            /**
+             * @brief Looks up an entry
+             *
+             * @param key The cache key
+             * @param entry Where the found entry is copied to
+             *
+             * @return Whether the entry was found
+             */
+            bool get(const QByteArray &key, CollisionCacheEntry &entry);
+
+            /**
+             * @brief Adds an entry, writing it to disk too if a cache directory is set
+             *
+             * @param key The cache key
+             * @param entry The entry to store
+             */
+            void insert(const QByteArray &key, const CollisionCacheEntry &entry);
+
+            /**
+             * @brief Removes all entries from memory (Entries on disk are kept)
+             */
+            void clear();
+
+            /**
+             * @return The version number mixed into every cache key
+             */
+            static quint32 getFormatVersion();
+    };
+}
+
+#endif
+
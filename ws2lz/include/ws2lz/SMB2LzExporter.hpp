@@ -8,7 +8,9 @@
 
 #include "ws2lz_export.h"
 #include "ws2lz/TriangleIntersectionGrid.hpp"
+#include "ws2lz/CollisionCache.hpp"
 #include "ws2common/Stage.hpp"
+#include "ws2common/Profiler.hpp"
 #include "ws2common/scene/GroupSceneNode.hpp"
 #include "ws2common/scene/GoalSceneNode.hpp"
 #include "ws2common/scene/BumperSceneNode.hpp"
@@ -22,6 +24,8 @@
 #include "ws2common/scene/CylinderCollisionObjectSceneNode.hpp"
 #include "ws2common/scene/MeshSceneNode.hpp"
 #include "ws2common/resource/ResourceMesh.hpp"
+#include "ws2common/model/CollisionMesh.hpp"
+#include "ws2common/model/MeshRequirements.hpp"
 #include "ws2common/scene/BoosterSceneNode.hpp"
 #include "ws2common/scene/GolfHoleSceneNode.hpp"
 #include "ws2common/scene/RaceTrackPathSceneNode.hpp"
@@ -62,6 +66,16 @@ namespace WS2Lz {
      * - Fallout volumes
      */
     class WS2LZ_EXPORT SMB2LzExporter {
+        public:
+            /**
+             * @brief A range of bytes in the output file written by one step of generate()
+             */
+            struct Section {
+                QString name;
+                quint32 offset;
+                quint32 length;
+            };
+
         protected:
             //Constants
             const unsigned int FILE_HEADER_LENGTH = 2204;
@@ -107,6 +121,12 @@ namespace WS2Lz {
              */
             QHash<const WS2Common::Scene::GroupSceneNode*, TriangleIntersectionGrid*> triangleIntGridMap;
 
+            /**
+             * @brief Converted collision triangles per collision header, ready to be written as is - These are
+             *        converted alongside collision optimization, or taken from the collision cache
+             */
+            QHash<const WS2Common::Scene::GroupSceneNode*, QByteArray*> collisionTriangleDataMap;
+
             //Offsets and counts
             //Key: Offset, Value: What the offset points to
             QMultiMap<quint32, const WS2Common::Scene::GroupSceneNode*> collisionHeaderOffsetMap;
@@ -191,14 +211,79 @@ namespace WS2Lz {
             //All 3D models for mesh collision
             QHash<QString, WS2Common::Resource::ResourceMesh*> models; //name, mesh - Using a hashmap as it will have a quicker lookup
 
+            /**
+             * @brief Compact copies of every mesh used for mesh collision, made once per export so that collision
+             *        optimization, caching and triangle conversion only read vertex positions
+             */
+            QHash<QString, WS2Common::Model::CollisionMesh*> collisionMeshes;
+
             //Some flag related to whether or not the stage is for the main game or some party game mode
             quint32 stageType;
 
+            /**
+             * @brief Records timings for each export stage if set (Optional - may be nullptr)
+             */
+            WS2Common::Profiler *profiler = nullptr;
+
+            /**
+             * @brief Optimized collision is looked up in and stored to this if set (Optional - may be nullptr)
+             */
+            CollisionCache *collisionCache = nullptr;
+
+            /**
+             * @brief Where each section was written to during the last call to generate(), in file order
+             */
+            QVector<Section> sections;
+
         public:
             virtual ~SMB2LzExporter();
 
             void setModels(QHash<QString, WS2Common::Resource::ResourceMesh*> &models);
 
+            /**
+             * @brief Sets the profiler to record collision optimization, offset calculation and per section write
+             *        timings to
+             *
+             * @param profiler The profiler to record to, or nullptr to disable profiling
+             */
+            void setProfiler(WS2Common::Profiler *profiler);
+
+            /**
+             * @brief Sets the cache to reuse optimized collision and converted collision triangles from
+             *
+             * Item groups whose collision hasn't changed since they were last cached skip collision optimization and
+             * triangle conversion entirely. The output is identical either way.
+             *
+             * @param collisionCache The cache to use, or nullptr to always optimize collision from scratch
+             */
+            void setCollisionCache(CollisionCache *collisionCache);
+
+            /**
+             * @brief Computes the key an item group's collision is stored under in a CollisionCache
+             *
+             * This hashes everything that affects the group's collision output - the collision grid, and the
+             * collision triangle flag, vertex positions and indices of every mesh collision node in the group.
+             * Transforms aren't included as mesh collision is exported untransformed.
+             *
+             * @param group The item group to compute a key for
+             *
+             * @return The cache key
+             */
+            QByteArray computeCollisionCacheKey(const WS2Common::Scene::GroupSceneNode *group);
+
+            /**
+             * @brief Works out which meshes an export of the stage reads from the models passed to setModels
+             *
+             * Only meshes used for mesh collision are read, and only their vertex positions and indices - level,
+             * background and foreground models are referenced by name alone. Anything else can be skipped when
+             * loading models for export.
+             *
+             * @param stage The stage to be exported
+             *
+             * @return The meshes and vertex attributes needed
+             */
+            static WS2Common::Model::MeshRequirements getMeshRequirements(const WS2Common::Stage &stage);
+
             /**
              * @brief Generates an uncompressed LZ for SMB 2, and writes it to dev
              *
@@ -207,21 +292,63 @@ namespace WS2Lz {
              */
             void generate(QDataStream &dev, const WS2Common::Stage &stage);
 
+            /**
+             * @brief Returns the byte range of each section written by the last call to generate(), in file order
+             *
+             * Useful for figuring out which part of a file differs between two exports
+             *
+             * @return The sections written, with offsets being positions in the device dev writes to
+             */
+            const QVector<Section>& getSections() const;
+
         protected:
+            /**
+             * @brief Recursive function - Adds the mesh of every MeshCollisionSceneNode under node to requirements
+             *
+             * @param node The node to recursively search
+             * @param requirements The requirements to add to
+             */
+            static void addMeshRequirements(
+                    const WS2Common::Scene::SceneNode *node,
+                    WS2Common::Model::MeshRequirements &requirements
+                    );
+
+            /**
+             * @brief Recursive function - Searches through the node's children, and their children, and their children, etc
+             *        for MeshCollisionSceneNodes, and creates a CollisionMesh for each mesh they use
+             *
+             * @param node The node to recursively search
+             */
+            void createCollisionMeshes(const WS2Common::Scene::SceneNode *node);
+
             /**
              * @brief Recursive function - Searches through the node's children, and their children, and their children, etc
-             *        for MeshCollisionSceneNodes, and adds their vertices/indices to the vectors specified
+             *        for MeshCollisionSceneNodes, and adds their collision meshes to the vector specified
              *
              * @param node The node to recursively search
-             * @param vertices All vertices - This will be added to
-             * @param indices Every 3 integers here corresponds to vertices for a triangle in the vertices vector - This will be added to
+             * @param meshes All collision meshes, in export order - This will be added to
              */
-            void addCollisionTriangles(
+            void addCollisionMeshes(
                     const WS2Common::Scene::SceneNode *node,
-                    QVector<WS2Common::Model::Vertex> &allVertices,
-                    QVector<unsigned int> &allIndices
+                    QVector<const WS2Common::Model::CollisionMesh*> &meshes
                     );
 
+            /**
+             * @brief Recursive function - Searches through the node's children, and their children, and their children, etc
+             *        for MeshCollisionSceneNodes, and writes everything that affects their collision output to key
+             *
+             * @param node The node to recursively search
+             * @param key The stream to write to - Big endian with single precision floats, so the key is the same on
+             *            every machine
+             */
+            void addCollisionCacheKeyData(const WS2Common::Scene::SceneNode *node, QDataStream &key);
+
+            /**
+             * @brief Sorts collision triangles into grid tiles and converts them for every item group, or takes them
+             *        from the collision cache if possible
+             *
+             * @param stage The stage to optimize collision for
+             */
             void optimizeCollision(const WS2Common::Stage &stage);
 
             /**
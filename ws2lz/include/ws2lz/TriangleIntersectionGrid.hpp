@@ -9,6 +9,7 @@
 #include "ws2lz_export.h"
 #include "ws2common/CollisionGrid.hpp"
 #include "ws2common/model/Vertex.hpp"
+#include "ws2common/model/CollisionMesh.hpp"
 #include "ws2common/AABB.hpp"
 #include <QVector>
 
@@ -26,51 +27,50 @@ namespace WS2Lz {
              */
             QVector<QVector<QVector<quint16>>> indicesGrid;
 
-            /**
-             * @brief A vector containing all vertices used in a model in no specific order
-             *
-             * @note Every 3 vertices does not necessarily correspond to a triangle!
-             */
-            QVector<WS2Common::Model::Vertex> vertices;
-
         protected:
             bool doAABBsIntersect(WS2Common::AABB2 a, WS2Common::AABB2 b);
 
         public:
             /**
-             * @brief Constructs a TriangleIntersectionGrid without sorting triangles into intersecting grid tiles
+             * @brief Constructs an empty TriangleIntersectionGrid, sized for the collision grid given
              *
-             * @param vertices All vertices
              * @param grid The collision grid used to set the initial size of the indicesGrid vector
              */
-            TriangleIntersectionGrid(
-                    QVector<WS2Common::Model::Vertex> &vertices,
-                    WS2Common::CollisionGrid &grid
-                    );
+            TriangleIntersectionGrid(const WS2Common::CollisionGrid &grid);
 
             /**
-             * @brief Constructs a TriangleIntersectionGrid without and sorts triangles into intersecting grid tiles
+             * @brief Constructs a TriangleIntersectionGrid and sorts triangles into intersecting grid tiles
              *
              * @param vertices All vertices
              * @param indices Every 3 integers here corresponds to vertices for a triangle in the vertices vector
              * @param grid The collision grid to check triangles against
              */
             TriangleIntersectionGrid(
-                    QVector<WS2Common::Model::Vertex> &vertices,
-                    QVector<unsigned int> &indices,
-                    WS2Common::CollisionGrid &grid
+                    const QVector<WS2Common::Model::Vertex> &vertices,
+                    const QVector<unsigned int> &indices,
+                    const WS2Common::CollisionGrid &grid
                     );
 
             /**
              * @brief Checks every triangle against every grid tile to see if they intersect, and if they do, add it
              *        to the appropriate location within indicesGrid
              *
-             * @param indices Every 3 integers here corresponds to vertices for a triangle in the vertices vector
+             * @param mesh The triangles to check
+             * @param grid The collision grid to check triangles against
+             */
+            void sortIntersections(const WS2Common::Model::CollisionMesh &mesh, const WS2Common::CollisionGrid &grid);
+
+            /**
+             * @brief Checks every triangle of every mesh given against every grid tile, without merging the meshes
+             *
+             * Triangles are numbered as if every mesh was appended one after another, in order.
+             *
+             * @param meshes The meshes to sort triangles from - These must stay alive until this returns
              * @param grid The collision grid to check triangles against
              */
             void sortIntersections(
-                    QVector<unsigned int> &indices,
-                    WS2Common::CollisionGrid &grid
+                    const QVector<const WS2Common::Model::CollisionMesh*> &meshes,
+                    const WS2Common::CollisionGrid &grid
                     );
 
             /**
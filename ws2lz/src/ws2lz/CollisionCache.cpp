@@ -0,0 +1,166 @@
+#include "ws2lz/CollisionCache.hpp"
+#include <QMutexLocker>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QDebug>
+
+namespace WS2Lz {
+    void CollisionCacheEntry::setIndicesGrid(const QVector<QVector<QVector<quint16>>> &indicesGrid) {
+        tileOffsets.clear();
+        tileIndices.clear();
+
+        tileOffsets.append(0);
+        foreach(const QVector<QVector<quint16>> &row, indicesGrid) {
+            foreach(const QVector<quint16> &tile, row) {
+                tileIndices += tile;
+                tileOffsets.append(tileIndices.size());
+            }
+        }
+    }
+
+    QVector<QVector<QVector<quint16>>> CollisionCacheEntry::getIndicesGrid(const WS2Common::CollisionGrid &grid) const {
+        QVector<QVector<QVector<quint16>>> indicesGrid;
+
+        unsigned int countX = grid.getGridStepCount().x;
+        unsigned int countY = grid.getGridStepCount().y;
+
+        indicesGrid.resize(countY);
+        for (unsigned int y = 0; y < countY; y++) {
+            indicesGrid[y].resize(countX);
+
+            for (unsigned int x = 0; x < countX; x++) {
+                unsigned int tile = y * countX + x;
+                if (tile + 1 >= (unsigned int) tileOffsets.size()) continue; //Malformed entry - leave the tile empty
+
+                quint32 start = tileOffsets.at(tile);
+                quint32 end = tileOffsets.at(tile + 1);
+                indicesGrid[y][x] = tileIndices.mid(start, end - start);
+            }
+        }
+
+        return indicesGrid;
+    }
+
+    int CollisionCacheEntry::getCost() const {
+        return triangleData.size() + tileOffsets.size() * sizeof(quint32) + tileIndices.size() * sizeof(quint16);
+    }
+
+    CollisionCache::CollisionCache(int maxMemoryBytes) :
+        memoryCache(maxMemoryBytes) {}
+
+    void CollisionCache::setCacheDirectory(const QString &cacheDirectory) {
+        QMutexLocker locker(&mutex);
+
+        this->cacheDirectory = cacheDirectory;
+        if (!cacheDirectory.isEmpty() && !QDir().mkpath(cacheDirectory)) {
+            qWarning().noquote() << "Failed to create collision cache directory" << cacheDirectory;
+        }
+    }
+
+    const QString& CollisionCache::getCacheDirectory() const {
+        return cacheDirectory;
+    }
+
+    bool CollisionCache::get(const QByteArray &key, CollisionCacheEntry &entry) {
+        QString directory;
+        {
+            QMutexLocker locker(&mutex);
+
+            if (CollisionCacheEntry *cached = memoryCache.object(key)) {
+                entry = *cached;
+                return true;
+            }
+
+            directory = cacheDirectory;
+        }
+
+        //Read without holding the lock, so other lookups don't wait on the disk
+        if (directory.isEmpty() || !readEntryFromDisk(getEntryFilePath(directory, key), key, entry)) return false;
+
+        //Keep it around in memory for next time
+        CollisionCacheEntry *cached = new CollisionCacheEntry(entry);
+        QMutexLocker locker(&mutex);
+        memoryCache.insert(key, cached, cached->getCost());
+
+        return true;
+    }
+
+    void CollisionCache::insert(const QByteArray &key, const CollisionCacheEntry &entry) {
+        QString directory;
+        {
+            QMutexLocker locker(&mutex);
+
+            CollisionCacheEntry *cached = new CollisionCacheEntry(entry);
+            memoryCache.insert(key, cached, cached->getCost()); //Takes ownership - may delete cached if it's too big
+
+            directory = cacheDirectory;
+        }
+
+        //Written without holding the lock - QSaveFile makes concurrent writes of the same entry safe
+        if (!directory.isEmpty()) writeEntryToDisk(getEntryFilePath(directory, key), key, entry);
+    }
+
+    void CollisionCache::clear() {
+        QMutexLocker locker(&mutex);
+        memoryCache.clear();
+    }
+
+    quint32 CollisionCache::getFormatVersion() {
+        return FORMAT_VERSION;
+    }
+
+    QString CollisionCache::getEntryFilePath(const QString &cacheDirectory, const QByteArray &key) {
+        return QDir(cacheDirectory).filePath(QString::fromLatin1(key.toHex()) + ".ws2coli");
+    }
+
+    bool CollisionCache::readEntryFromDisk(const QString &filePath, const QByteArray &key, CollisionCacheEntry &entry) {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly)) return false;
+
+        QDataStream in(&file);
+        in.setByteOrder(QDataStream::BigEndian);
+
+        QByteArray magic(4, '\0');
+        quint32 version;
+        QByteArray storedKey;
+        in.readRawData(magic.data(), 4);
+        in >> version >> storedKey;
+
+        if (magic != "WS2C" || version != FORMAT_VERSION || storedKey != key) {
+            qWarning().noquote() << "Ignoring stale or corrupt collision cache entry" << file.fileName();
+            return false;
+        }
+
+        in >> entry.triangleData >> entry.tileOffsets >> entry.tileIndices;
+
+        if (in.status() != QDataStream::Ok) {
+            qWarning().noquote() << "Ignoring truncated collision cache entry" << file.fileName();
+            return false;
+        }
+
+        return true;
+    }
+
+    void CollisionCache::writeEntryToDisk(const QString &filePath, const QByteArray &key, const CollisionCacheEntry &entry) {
+        //QSaveFile only replaces the old file once everything is written, so a crash can't leave half an entry
+        QSaveFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qWarning().noquote() << "Failed to write collision cache entry" << file.fileName() << "-" << file.errorString();
+            return;
+        }
+
+        QDataStream out(&file);
+        out.setByteOrder(QDataStream::BigEndian);
+
+        out.writeRawData("WS2C", 4);
+        out << FORMAT_VERSION << key;
+        out << entry.triangleData << entry.tileOffsets << entry.tileIndices;
+
+        if (!file.commit()) {
+            qWarning().noquote() << "Failed to write collision cache entry" << file.fileName() << "-" << file.errorString();
+        }
+    }
+}
+
@@ -1,16 +1,20 @@
 #include "ws2lz/SMB2LzExporter.hpp"
 #include "ws2lz/WS2Lz.hpp"
 #include "ws2common/WS2Common.hpp"
+#include "ws2common/Profiler.hpp"
+#include "ws2common/ThreadPoolUtils.hpp"
 #include "ws2common/scene/StartSceneNode.hpp"
 #include "ws2common/scene/MeshCollisionSceneNode.hpp"
 #include "ws2common/scene/RaceTrackPathSceneNode.hpp"
 #include "ws2common/scene/BoosterSceneNode.hpp"
 #include "ws2common/scene/GolfHoleSceneNode.hpp"
 #include <QElapsedTimer>
-#include <QThreadPool>
+#include <QBuffer>
+#include <QCryptographicHash>
 #include <QDebug>
 #include <QtMath>
 #include <glm/gtc/constants.hpp>
+#include <utility>
 #include <math.h>
 
 //Macros
@@ -43,102 +47,188 @@
  */
 #define forEachGroupChildType(type, child) forEachGroup(group) forEachChildType(group, type, child)
 
+/**
+ * @brief Times the statement following it with the exporter's profiler, if one is set - The statement is run exactly once
+ *
+ * The scope lives on the stack for the duration of the loop, so this costs nothing when there's no profiler
+ */
+#define profileStage(name, category)\
+    for (WS2Common::Profiler::Scope profileScope(profiler, name, category), *profileScopeOnce = &profileScope;\
+            profileScopeOnce != nullptr; profileScopeOnce = nullptr)
+
+/**
+ * @brief Times the statement following it as a section of the output file, and records where in the file the
+ *        section was written to - The statement is run exactly once
+ */
+#define profileWrite(name)\
+    for (WriteSectionScope sectionScope(profiler, sections, dev, name), *sectionScopeOnce = &sectionScope;\
+            sectionScopeOnce != nullptr; sectionScopeOnce = nullptr)
+
 namespace WS2Lz {
     using namespace WS2Common;
 
+    namespace {
+        /**
+         * @brief Used by the profileWrite macro - Records the offset and length of a section written to dev, and
+         *        profiles it if a profiler is set
+         */
+        class WriteSectionScope {
+            protected:
+                Profiler::Scope profileScope;
+                QVector<SMB2LzExporter::Section> &sections;
+                QDataStream &dev;
+                SMB2LzExporter::Section section;
+
+            public:
+                WriteSectionScope(Profiler *profiler, QVector<SMB2LzExporter::Section> &sections, QDataStream &dev, const QString &name) :
+                    profileScope(profiler, name, "write"),
+                    sections(sections),
+                    dev(dev) {
+                    section.name = name;
+                    section.offset = dev.device() != nullptr ? dev.device()->pos() : 0;
+                }
+
+                ~WriteSectionScope() {
+                    quint32 end = dev.device() != nullptr ? dev.device()->pos() : 0;
+                    section.length = end - section.offset;
+                    sections.append(section);
+                }
+        };
+    }
+
     SMB2LzExporter::~SMB2LzExporter() {
         qDeleteAll(triangleIntGridMap.values());
+        qDeleteAll(collisionTriangleDataMap.values());
+        qDeleteAll(collisionMeshes.values());
     }
 
     void SMB2LzExporter::setModels(QHash<QString, Resource::ResourceMesh*> &models) {
         this->models = models;
     }
 
+    Model::MeshRequirements SMB2LzExporter::getMeshRequirements(const Stage &stage) {
+        Model::MeshRequirements requirements;
+        addMeshRequirements(stage.getRootNode(), requirements);
+        return requirements;
+    }
+
+    void SMB2LzExporter::addMeshRequirements(const Scene::SceneNode *node, Model::MeshRequirements &requirements) {
+        if (const Scene::MeshCollisionSceneNode *coli = dynamic_cast<const Scene::MeshCollisionSceneNode*>(node)) {
+            //Collision only needs positions and indices, which are always loaded
+            requirements.require(coli->getMeshName());
+        }
+
+        foreach(const Scene::SceneNode *child, node->getChildren()) {
+            addMeshRequirements(child, requirements);
+        }
+    }
+
+    void SMB2LzExporter::setProfiler(Profiler *profiler) {
+        this->profiler = profiler;
+    }
+
+    void SMB2LzExporter::setCollisionCache(CollisionCache *collisionCache) {
+        this->collisionCache = collisionCache;
+    }
+
+    const QVector<SMB2LzExporter::Section>& SMB2LzExporter::getSections() const {
+        return sections;
+    }
+
     void SMB2LzExporter::generate(QDataStream &dev, const Stage &stage) {
         //TODO: Add a configureDataStream function or something - to make it easy to override for a Dx exporter
         dev.setByteOrder(QDataStream::BigEndian);
         dev.setFloatingPointPrecision(QDataStream::SinglePrecision);
+        sections.clear();
 
-        optimizeCollision(stage);
-        calculateOffsets(stage);
+        profileStage("Prepare collision meshes", "collision") createCollisionMeshes(stage.getRootNode());
+        profileStage("Optimize collision", "collision") optimizeCollision(stage);
+        profileStage("Calculate offsets", "offsets") calculateOffsets(stage);
 
         stageType = StageType::toStageTypeFlag(stage.getStageType());
 
         //Write the data
-        writeFileHeader(dev);
-        writeStart(dev, stage);
-        writeFallout(dev, stage);
-        writeFog(dev, stage.getFog());
-        writeFogAnimationHeader(dev, stage.getFogAnimation());
-        writeFogAnimation(dev, stage.getFogAnimation());
+        profileWrite("File header") writeFileHeader(dev);
+        profileWrite("Start") writeStart(dev, stage);
+        profileWrite("Fallout") writeFallout(dev, stage);
+        profileWrite("Fog") writeFog(dev, stage.getFog());
+        profileWrite("Fog animation header") writeFogAnimationHeader(dev, stage.getFogAnimation());
+        profileWrite("Fog animation") writeFogAnimation(dev, stage.getFogAnimation());
         if (stage.getStageType() == EnumStageType::MONKEY_RACE_2) {
-            writeRaceHeader(dev, stage);
-            writeCPUTrackPathHeaders(dev, stage);
-            forEachChildType(stage.getRootNode(), Scene::RaceTrackPathSceneNode*, node) writeRaceTrackPath(dev, node);
-            forEachChildType(stage.getRootNode(), Scene::BoosterSceneNode*, node) writeBooster(dev, node);
+            profileWrite("Race header") writeRaceHeader(dev, stage);
+            profileWrite("CPU track path headers") writeCPUTrackPathHeaders(dev, stage);
+            profileWrite("Race track paths") forEachChildType(stage.getRootNode(), Scene::RaceTrackPathSceneNode*, node) writeRaceTrackPath(dev, node);
+            profileWrite("Boosters") forEachChildType(stage.getRootNode(), Scene::BoosterSceneNode*, node) writeBooster(dev, node);
         }
         if (stage.getStageType() == EnumStageType::MONKEY_GOLF_2) {
-            forEachChildType(stage.getRootNode(), Scene::GolfHoleSceneNode*, node) writeGolfHole(dev, node);
-        }
-        forEachGroup(group) writeCollisionHeader(dev, group); //Collision Headers
-        forEachGroup(group) writeCollisionTriangles(dev, group); //Collision triangles
-        forEachGroup(group) writeCollisionTriangleIndexListPointers(dev, group); //Collision triangle pointer
-        forEachGroup(group) writeCollisionTriangleIndexList(dev, triangleIntGridMap.value(group)); //Collision triangle index list
-        forEachGroupChildType(const Scene::GoalSceneNode*, node) writeGoal(dev, node); //Goals
-        forEachGroupChildType(const Scene::BumperSceneNode*, node) writeBumper(dev, node); //Bumpers
-        forEachGroupChildType(const Scene::JamabarSceneNode*, node) writeJamabar(dev, node); //Jamabars
-        forEachGroupChildType(const Scene::BananaSceneNode*, node) writeBanana(dev, node); //Bananas
-        forEachGroupChildType(const Scene::ConeCollisionObjectSceneNode*, node) writeConeCollisionObject(dev, node); //ConeCollisionObjects
-        forEachGroupChildType(const Scene::SphereCollisionObjectSceneNode*, node) writeSphereCollisionObject(dev, node); //SphereCollisionObjects
-        forEachGroupChildType(const Scene::CylinderCollisionObjectSceneNode*, node) writeCylinderCollisionObject(dev, node); //CylinderCollisionObjects
-        forEachGroupChildType(const Scene::SwitchSceneNode*, node) writeSwitch(dev, node); //Switches
-        forEachGroupChildType(const Scene::WormholeSceneNode*, node) writeWormhole(dev, node); //Wormholes
-        forEachGroup(group) writeLevelModelPointerAList(dev, group); //Level model pointers type A
-        forEachGroup(group) writeLevelModelPointerBList(dev, group); //Level model pointers type B
-        forEachGroup(group) writeLevelModelList(dev, group); //Level models
-        forEachGroup(group) writeLevelModelNameList(dev, group); //Level model names     
-        forEachBg(mesh) writeBackgroundModel(dev, mesh); //Background models
-        forEachBg(mesh) writeBackgroundName(dev, mesh); //Background model names
-        forEachFg(mesh) writeForegroundModel(dev, mesh); // Foreground models
-        forEachFg(mesh) writeForegroundName(dev, mesh); // Foreground model names
-        forEachBg(mesh) writeBgFgAnimationHeader(dev, mesh->getTransformAnimation()); // Background animation headers
-        forEachFg(mesh) writeBgFgAnimationHeader(dev, mesh->getTransformAnimation()); // Foreground animation headers
-        forEachGroup(group) writeAnimationHeader(dev, group->getTransformAnimation()); // Item group animation headers
-        forEachBg(mesh) writeEffectHeader(dev, mesh); // Background effect headers
-        forEachFg(mesh) writeEffectHeader(dev, mesh); // Foreground effect headers
-        forEachBg(mesh) writeTextureScroll(dev, mesh); // Background texture scroll
-        forEachFg(mesh) writeTextureScroll(dev, mesh); // Foreground texture scroll
-        forEachGroup(group) writeTextureScroll(dev, group); // Item group texture scroll
-        forEachBg(mesh) writeEffectAnimation(dev, mesh->getEffectAnimation());
-        forEachFg(mesh) writeEffectAnimation(dev, mesh->getEffectAnimation());
-        forEachBg(mesh) writeTransformAnimation(dev, mesh->getTransformAnimation(), true); // Background object animations (scaling)
-        forEachFg(mesh) writeTransformAnimation(dev, mesh->getTransformAnimation(), true); // Foreground object animations (scaling)
-        forEachGroup(group) writeTransformAnimation(dev, group->getTransformAnimation(), false); // Item group animations (no scaling)
-        forEachGroup(group) writeRuntimeReflectiveModelList(dev, group); //Runtime reflective models
-        forEachGroupChildType(const Scene::FalloutVolumeSceneNode*, node) writeFalloutVolume(dev, node); //Fallout volumes
-        writeNull(dev, 64); // Taking a page out of Deluxe's book - having extra null padding at the end of the file can prevent weird crashes
-    }
-
-    void SMB2LzExporter::addCollisionTriangles(
+            profileWrite("Golf holes") forEachChildType(stage.getRootNode(), Scene::GolfHoleSceneNode*, node) writeGolfHole(dev, node);
+        }
+        profileWrite("Collision headers") forEachGroup(group) writeCollisionHeader(dev, group); //Collision Headers
+        profileWrite("Collision triangles") forEachGroup(group) { //Collision triangles - Already converted when optimizing collision
+            const QByteArray *triangleData = collisionTriangleDataMap.value(group);
+            dev.writeRawData(triangleData->constData(), triangleData->size());
+        }
+        profileWrite("Collision triangle index list pointers") forEachGroup(group) writeCollisionTriangleIndexListPointers(dev, group); //Collision triangle pointer
+        profileWrite("Collision triangle index lists") forEachGroup(group) writeCollisionTriangleIndexList(dev, triangleIntGridMap.value(group)); //Collision triangle index list
+        profileWrite("Goals") forEachGroupChildType(const Scene::GoalSceneNode*, node) writeGoal(dev, node); //Goals
+        profileWrite("Bumpers") forEachGroupChildType(const Scene::BumperSceneNode*, node) writeBumper(dev, node); //Bumpers
+        profileWrite("Jamabars") forEachGroupChildType(const Scene::JamabarSceneNode*, node) writeJamabar(dev, node); //Jamabars
+        profileWrite("Bananas") forEachGroupChildType(const Scene::BananaSceneNode*, node) writeBanana(dev, node); //Bananas
+        profileWrite("Cone collision objects") forEachGroupChildType(const Scene::ConeCollisionObjectSceneNode*, node) writeConeCollisionObject(dev, node); //ConeCollisionObjects
+        profileWrite("Sphere collision objects") forEachGroupChildType(const Scene::SphereCollisionObjectSceneNode*, node) writeSphereCollisionObject(dev, node); //SphereCollisionObjects
+        profileWrite("Cylinder collision objects") forEachGroupChildType(const Scene::CylinderCollisionObjectSceneNode*, node) writeCylinderCollisionObject(dev, node); //CylinderCollisionObjects
+        profileWrite("Switches") forEachGroupChildType(const Scene::SwitchSceneNode*, node) writeSwitch(dev, node); //Switches
+        profileWrite("Wormholes") forEachGroupChildType(const Scene::WormholeSceneNode*, node) writeWormhole(dev, node); //Wormholes
+        profileWrite("Level model pointers A") forEachGroup(group) writeLevelModelPointerAList(dev, group); //Level model pointers type A
+        profileWrite("Level model pointers B") forEachGroup(group) writeLevelModelPointerBList(dev, group); //Level model pointers type B
+        profileWrite("Level models") forEachGroup(group) writeLevelModelList(dev, group); //Level models
+        profileWrite("Level model names") forEachGroup(group) writeLevelModelNameList(dev, group); //Level model names
+        profileWrite("Background models") forEachBg(mesh) writeBackgroundModel(dev, mesh); //Background models
+        profileWrite("Background model names") forEachBg(mesh) writeBackgroundName(dev, mesh); //Background model names
+        profileWrite("Foreground models") forEachFg(mesh) writeForegroundModel(dev, mesh); // Foreground models
+        profileWrite("Foreground model names") forEachFg(mesh) writeForegroundName(dev, mesh); // Foreground model names
+        profileWrite("Background animation headers") forEachBg(mesh) writeBgFgAnimationHeader(dev, mesh->getTransformAnimation()); // Background animation headers
+        profileWrite("Foreground animation headers") forEachFg(mesh) writeBgFgAnimationHeader(dev, mesh->getTransformAnimation()); // Foreground animation headers
+        profileWrite("Item group animation headers") forEachGroup(group) writeAnimationHeader(dev, group->getTransformAnimation()); // Item group animation headers
+        profileWrite("Background effect headers") forEachBg(mesh) writeEffectHeader(dev, mesh); // Background effect headers
+        profileWrite("Foreground effect headers") forEachFg(mesh) writeEffectHeader(dev, mesh); // Foreground effect headers
+        profileWrite("Background texture scroll") forEachBg(mesh) writeTextureScroll(dev, mesh); // Background texture scroll
+        profileWrite("Foreground texture scroll") forEachFg(mesh) writeTextureScroll(dev, mesh); // Foreground texture scroll
+        profileWrite("Item group texture scroll") forEachGroup(group) writeTextureScroll(dev, group); // Item group texture scroll
+        profileWrite("Background effect animations") forEachBg(mesh) writeEffectAnimation(dev, mesh->getEffectAnimation());
+        profileWrite("Foreground effect animations") forEachFg(mesh) writeEffectAnimation(dev, mesh->getEffectAnimation());
+        profileWrite("Background animations") forEachBg(mesh) writeTransformAnimation(dev, mesh->getTransformAnimation(), true); // Background object animations (scaling)
+        profileWrite("Foreground animations") forEachFg(mesh) writeTransformAnimation(dev, mesh->getTransformAnimation(), true); // Foreground object animations (scaling)
+        profileWrite("Item group animations") forEachGroup(group) writeTransformAnimation(dev, group->getTransformAnimation(), false); // Item group animations (no scaling)
+        profileWrite("Runtime reflective models") forEachGroup(group) writeRuntimeReflectiveModelList(dev, group); //Runtime reflective models
+        profileWrite("Fallout volumes") forEachGroupChildType(const Scene::FalloutVolumeSceneNode*, node) writeFalloutVolume(dev, node); //Fallout volumes
+        profileWrite("End padding") writeNull(dev, 64); // Taking a page out of Deluxe's book - having extra null padding at the end of the file can prevent weird crashes
+    }
+
+    void SMB2LzExporter::createCollisionMeshes(const Scene::SceneNode *node) {
+        if (const Scene::MeshCollisionSceneNode *coli = dynamic_cast<const Scene::MeshCollisionSceneNode*>(node)) {
+            //Only positions are needed for collision - the same mesh may be used by several nodes, so convert it once
+            if (models.contains(coli->getMeshName()) && !collisionMeshes.contains(coli->getMeshName())) {
+                Model::CollisionMesh *collisionMesh = new Model::CollisionMesh();
+                collisionMesh->append(*models.value(coli->getMeshName()));
+                collisionMeshes[coli->getMeshName()] = collisionMesh;
+            }
+        }
+
+        foreach(const Scene::SceneNode *child, node->getChildren()) {
+            createCollisionMeshes(child);
+        }
+    }
+
+    void SMB2LzExporter::addCollisionMeshes(
             const Scene::SceneNode *node,
-            QVector<Model::Vertex> &allVertices,
-            QVector<unsigned int> &allIndices
+            QVector<const Model::CollisionMesh*> &meshes
             ) {
         if (dynamic_cast<const Scene::MeshCollisionSceneNode*>(node)) {
             const Scene::MeshCollisionSceneNode *coli= static_cast<const Scene::MeshCollisionSceneNode*>(node);
-            //First, find the MeshSceneNode in the models QHash
-            if (models.contains(coli->getMeshName())) {
-                const Resource::ResourceMesh *mesh = models.value(coli->getMeshName());
-                //Now loop over all MeshSegements, and add to nextOffset
-                foreach(const Model::MeshSegment *seg, mesh->getMeshSegments()) {
-                    //Also need to add the previous size of allVertices to the indices to be added
-                    int prevSize = allVertices.size();
-                    allVertices.append(seg->getVertices());
-
-                    foreach(unsigned int ind, seg->getIndices()) {
-                        allIndices.append(ind + prevSize);
-                    }
-                }
+            //First, find the mesh in the collisionMeshes QHash
+            if (collisionMeshes.contains(coli->getMeshName())) {
+                meshes.append(collisionMeshes.value(coli->getMeshName()));
             } else {
                 //models QHash doesn't have the mesh in question - don't add it
                 qWarning().noquote() << "Missing mesh for collision" << coli->getMeshName();
@@ -147,7 +237,55 @@ namespace WS2Lz {
 
         //Loop over all children, looking for MeshCollisionSceneNodes
         foreach(const Scene::SceneNode *child, node->getChildren()) {
-            addCollisionTriangles(child, allVertices, allIndices);
+            addCollisionMeshes(child, meshes);
+        }
+    }
+
+    QByteArray SMB2LzExporter::computeCollisionCacheKey(const Scene::GroupSceneNode *group) {
+        //Written with a fixed byte order, rather than hashing raw native bytes, so the key is the same on every machine
+        QByteArray keyData;
+        QDataStream key(&keyData, QIODevice::WriteOnly);
+        key.setByteOrder(QDataStream::BigEndian);
+        key.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+        key << CollisionCache::getFormatVersion();
+
+        const CollisionGrid &grid = group->getCollisionGrid();
+        glm::vec2 gridStart = grid.getGridStart();
+        glm::vec2 gridStep = grid.getGridStep();
+        glm::uvec2 gridStepCount = grid.getGridStepCount();
+        key << gridStart.x << gridStart.y << gridStep.x << gridStep.y << (quint32) gridStepCount.x << (quint32) gridStepCount.y;
+
+        addCollisionCacheKeyData(group, key);
+
+        return QCryptographicHash::hash(keyData, QCryptographicHash::Sha1);
+    }
+
+    void SMB2LzExporter::addCollisionCacheKeyData(const Scene::SceneNode *node, QDataStream &key) {
+        if (const Scene::MeshCollisionSceneNode *coli = dynamic_cast<const Scene::MeshCollisionSceneNode*>(node)) {
+            key << (quint16) coli->getCollisionTriangleFlag();
+
+            if (collisionMeshes.contains(coli->getMeshName())) {
+                const Model::CollisionMesh *mesh = collisionMeshes.value(coli->getMeshName());
+
+                //Sizes are hashed too so that data can't shift between meshes without changing the key
+                quint32 vertexCount = mesh->getVertexCount();
+                quint32 indexCount = mesh->getIndices().size();
+                key << vertexCount << indexCount;
+
+                //Only positions affect collision
+                for (float x : mesh->getPositionsX()) key << x;
+                for (float y : mesh->getPositionsY()) key << y;
+                for (float z : mesh->getPositionsZ()) key << z;
+                for (quint32 index : mesh->getIndices()) key << index;
+            } else {
+                //Missing meshes export as no triangles - mark it so the key differs from an empty mesh
+                key.writeRawData("missing", 7);
+            }
+        }
+
+        foreach(const Scene::SceneNode *child, node->getChildren()) {
+            addCollisionCacheKeyData(child, key);
         }
     }
 
@@ -159,50 +297,104 @@ namespace WS2Lz {
 
         QAtomicInt finishedThreads = 0;
         int maxThreads = 0;
+        int cachedGroups = 0;
 
         //Loop over all collision headers
-        foreach(Scene::SceneNode *node, stage.getRootNode()->getChildren()) {
-            if (dynamic_cast<Scene::GroupSceneNode*>(node)) {
+        foreach(const Scene::SceneNode *node, stage.getRootNode()->getChildren()) {
+            if (dynamic_cast<const Scene::GroupSceneNode*>(node)) {
+                //Only read through a const pointer, so this doesn't mark groups dirty
+                const Scene::GroupSceneNode *groupNode = static_cast<const Scene::GroupSceneNode*>(node);
+                QByteArray *triangleData = new QByteArray();
+                collisionTriangleDataMap[groupNode] = triangleData;
+
+                //See if this group's collision is unchanged since it was last cached
+                QByteArray cacheKey;
+                if (collisionCache != nullptr) {
+                    Profiler::Scope scope(profiler, "Collision cache lookup: " + groupNode->getName(), "collision");
+
+                    cacheKey = computeCollisionCacheKey(groupNode);
+                    CollisionCacheEntry entry;
+                    if (collisionCache->get(cacheKey, entry)) {
+                        TriangleIntersectionGrid *intGrid = new TriangleIntersectionGrid(groupNode->getCollisionGrid());
+                        intGrid->getIndicesGrid() = entry.getIndicesGrid(groupNode->getCollisionGrid());
+                        triangleIntGridMap[groupNode] = intGrid;
+                        *triangleData = entry.triangleData;
+
+                        ++cachedGroups;
+                        continue;
+                    }
+                }
+
                 ++maxThreads;
 
-                Scene::GroupSceneNode *groupNode = static_cast<Scene::GroupSceneNode*>(node);
-                //Find all MeshCollisionSceneNodes, and add the triangles to allVertices/allIndices
-                QVector<Model::Vertex> allVertices;
-                QVector<unsigned int> allIndices;
-                addCollisionTriangles(node, allVertices, allIndices);
+                //Find all MeshCollisionSceneNodes - Their collision meshes are sorted in place, without gathering
+                //every triangle into one big copy
+                QVector<const Model::CollisionMesh*> meshes;
+                addCollisionMeshes(node, meshes);
 
                 //Now create the TriangleIntrsectionGrid, which will check each triangle for intersections with each grid tile
                 //Also multithread this!
-                TriangleIntersectionGrid *intGrid = new TriangleIntersectionGrid(
-                        allVertices,
-                        groupNode->getCollisionGrid()
-                        );
+                TriangleIntersectionGrid *intGrid = new TriangleIntersectionGrid(groupNode->getCollisionGrid());
 
                 class SortTask : public QRunnable {
                     public:
+                        SMB2LzExporter *exporter;
+                        const Scene::GroupSceneNode *groupNode;
                         TriangleIntersectionGrid *intGrid;
-                        QVector<unsigned int> indices;
-                        CollisionGrid *grid;
+                        QByteArray *triangleData;
+                        QVector<const Model::CollisionMesh*> meshes;
+                        const CollisionGrid *grid;
                         QAtomicInt *finishedThreadsCounter;
+                        Profiler *profiler;
+                        CollisionCache *collisionCache;
+                        QByteArray cacheKey;
 
                         virtual void run() override {
-                            intGrid->sortIntersections(indices, *grid);
+                            {
+                                Profiler::Scope scope(profiler, "Optimize collision: " + groupNode->getName(), "collision");
+                                intGrid->sortIntersections(meshes, *grid);
+
+                                //Convert the triangles here too so that it's also done in parallel
+                                QBuffer buf(triangleData);
+                                buf.open(QIODevice::WriteOnly);
+                                QDataStream triangleStream(&buf);
+                                triangleStream.setByteOrder(QDataStream::BigEndian);
+                                triangleStream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+                                exporter->writeCollisionTriangles(triangleStream, groupNode);
+
+                                if (collisionCache != nullptr) {
+                                    CollisionCacheEntry entry;
+                                    entry.triangleData = *triangleData;
+                                    entry.setIndicesGrid(intGrid->getIndicesGrid());
+                                    collisionCache->insert(cacheKey, entry);
+                                }
+                            }
                             ++(*finishedThreadsCounter);
                         }
                 };
 
                 SortTask *task = new SortTask;
+                task->exporter = this;
+                task->groupNode = groupNode;
+                task->profiler = profiler;
                 task->intGrid = intGrid;
-                task->indices = allIndices;
+                task->triangleData = triangleData;
+                task->meshes = std::move(meshes);
                 task->grid = &groupNode->getCollisionGrid();
                 task->finishedThreadsCounter = &finishedThreads;
-                QThreadPool::globalInstance()->start(task);
+                task->collisionCache = collisionCache;
+                task->cacheKey = cacheKey;
+                ThreadPoolUtils::startGlobal(task);
 
                 //Store it
                 triangleIntGridMap[groupNode] = intGrid;
             }
         }
 
+        if (cachedGroups > 0) {
+            qInfo().noquote() << cachedGroups << "item group(s) loaded from the collision cache";
+        }
+
         int sleepTime = 1;
         while(finishedThreads < maxThreads) {
             printf("\r[");
@@ -669,7 +861,7 @@ namespace WS2Lz {
 
         //BG effect keyframes
         forEachBg(node) {
-            Animation::EffectAnimation *anim = node->getEffectAnimation();
+            const Animation::EffectAnimation *anim = node->getEffectAnimation();
             if (anim != nullptr) {
                 effectAnimType1KeyframesOffsetMap.insert(nextOffset, anim);
                 nextOffset += EFFECT_TYPE_1_KEYFRAME_LENGTH * anim->getEffect1Keyframes().size();
@@ -680,7 +872,7 @@ namespace WS2Lz {
         }
         //FG effect keyframes
         forEachFg(node) {
-            Animation::EffectAnimation *anim = node->getEffectAnimation();
+            const Animation::EffectAnimation *anim = node->getEffectAnimation();
             if (anim != nullptr) {
                 effectAnimType1KeyframesOffsetMap.insert(nextOffset, anim);
                 nextOffset += EFFECT_TYPE_1_KEYFRAME_LENGTH * anim->getEffect1Keyframes().size();
@@ -863,17 +1055,13 @@ namespace WS2Lz {
         if (dynamic_cast<const Scene::MeshCollisionSceneNode*>(node)) {
             const Scene::MeshCollisionSceneNode *coli= static_cast<const Scene::MeshCollisionSceneNode*>(node);
             //First, find the MeshSceneNode in the models QHash
-            if (models.contains(coli->getMeshName())) {
-                const Resource::ResourceMesh *mesh = models.value(coli->getMeshName());
-                //Now loop over all MeshSegements, and add to nextOffset
-                foreach (const Model::MeshSegment *seg, mesh->getMeshSegments()) {
-                    int triangleCount = seg->getIndices().size() / 3;
-                    nextOffset += COLLISION_TRIANGLE_LENGTH * triangleCount;
-                }
+            if (collisionMeshes.contains(coli->getMeshName())) {
+                int triangleCount = collisionMeshes.value(coli->getMeshName())->getTriangleCount();
+                nextOffset += COLLISION_TRIANGLE_LENGTH * triangleCount;
             } /* else {
                 //models QHash doesn't have the mesh in question - don't add it
                 //qWarning().noquote() << "Missing mesh for collision" << coli->getMeshName();
-                //Don't warn - This is done in addCollisionTriangles
+                //Don't warn - This is done in addCollisionMeshes
             } */
         }
 
@@ -1223,120 +1411,111 @@ namespace WS2Lz {
         if (dynamic_cast<const Scene::MeshCollisionSceneNode*>(node)) {
             const Scene::MeshCollisionSceneNode *coli= static_cast<const Scene::MeshCollisionSceneNode*>(node);
             //This node is a MeshCollisionSceneNode - Loop over all the triangles and write them
-            //First, find the MeshSceneNode in the models QHash
-            if (models.contains(coli->getMeshName())) {
-                const Resource::ResourceMesh *mesh = models.value(coli->getMeshName());
-                //Now loop over all MeshSegements, and write thier collision triangles
-
-                foreach (const Model::MeshSegment *seg, mesh->getMeshSegments()) {
-                    //Now loop over all triangles
-                    for (int i = 0; i < seg->getIndices().size(); i += 3) {
-                        glm::tvec3<Model::Vertex> verts(
-                                seg->getVertices().at(seg->getIndices().at(i)),
-                                seg->getVertices().at(seg->getIndices().at(i + 1)),
-                                seg->getVertices().at(seg->getIndices().at(i + 2))
-                                );
-
-                        //////////////// BEGINNING OF MADNESS ////////////////
-                        //This code is mostly just copied from Yoshimaster96's smb(2)cnv
-                        //with some tweaks to make it less of a nightmare to read
-                        //I'm still not 100% sure what everything does though
-                        //
-                        //For clarification as to how a collision triangle is stored, the first coordinate is (X1, Y1, Z1),
-                        //the second coordinate is calculated as (X1 + DX2X1, Y1 + DY2Y1, Z1) then rotated about first
-                        //point by Z, then Y, then X. The third coordinate is calculated similarly, from
-                        //(X1 + DX3X1, Y1 + DY3Y1, Z1), rotated by the same angles
-                        //
-                        //Update:
-                        //Where the madness began: http://kuribo64.net/board/thread.php?pid=55329
-                        //Blank: cx, sx, cy, sy, cz and sz are floats and are the cosine and sine of the rotation angles.
-                        //Yoshimaster96: Those aren't given however. I'm trying to find the rotation angles.
-                        //Blank: You calculate the angles using cx, sx, etc. In my code snippet this is done with the reverse_angle function.
-                        //
-                        //For more info on how collision triangles work within Super Monkey Ball, see
-                        //https://craftedcart.github.io/SMBLevelWorkshop/documentation/index.html?page=lzFormat2#spec-lzFormat2-section-collisionTriangle
-
-                        glm::vec3 a = verts.x.position;
-                        glm::vec3 b = verts.y.position;
-                        glm::vec3 c = verts.z.position;
-
-                        glm::vec3 normal = glm::normalize(cross(glm::normalize(b - a), glm::normalize(c - a)));
-
-                        float l = qSqrt(normal.x * normal.x + normal.z * normal.z);
-
-                        float cy;
-                        float sy;
-                        if (qFabs(l) < 0.001f) {
-                            cy = 1.0f;
-                            sy = 0.0f;
-                        } else {
-                            cy = normal.z / l;
-                            sy = -normal.x / l;
-                        }
-
-                        float cx = l;
-                        float sx = normal.y;
-
-                        glm::mat3 rotXMat(
-                                1.0f, 0.0f, 0.0f,
-                                0.0f, cx, sx,
-                                0.0f, -sx, cx
-                                );
-
-                        glm::mat3 rotYMat(
-                                cy, 0.0f, -sy,
-                                0.0f, 1.0f, 0.0f,
-                                sy, 0.0f, cy
-                                );
-
-                        glm::vec3 dotry = dotm(b - a, rotYMat);
-                        glm::vec3 dotrxry = dotm(dotry, rotXMat);
-                        l = sqrtf(dotrxry.x * dotrxry.x + dotrxry.y * dotrxry.y);
-
-                        float cz = dotrxry.x / l;
-                        float sz = -dotrxry.y / l;
-
-                        glm::mat3 rotZMat(
-                                cz, sz, 0.0f,
-                                -sz, cz, 0.0f,
-                                0.0f, 0.0f, 1.0f
-                                );
-
-                        //Delta position for vertex B from vertex A (Before rotation is applied)
-                        glm::vec3 deltaPosB = dotm(dotrxry, rotZMat);
-
-                        dotry = dotm(c - a, rotYMat);
-                        dotrxry = dotm(dotry, rotXMat);
-                        //Delta position for vertex C from vertex A (Before rotation is applied)
-                        glm::vec3 deltaPosC = dotm(dotrxry, rotZMat);
-
-                        glm::vec3 n0v(deltaPosC.x - deltaPosB.x, deltaPosC.y - deltaPosB.y, deltaPosC.z - deltaPosB.z);
-                        glm::vec3 n1v(-deltaPosC.x, -deltaPosC.y, -deltaPosC.z);
-                        glm::vec3 tangent = glm::normalize(hat(n0v));
-                        glm::vec3 bitangent = glm::normalize(hat(n1v));
-
-                        float rotX = (2 * glm::pi<float>()) - reverseAngle(cx, sx);
-                        float rotY = (2 * glm::pi<float>()) - reverseAngle(cy, sy);
-                        float rotZ = (2 * glm::pi<float>()) - reverseAngle(cz, sz);
-
-                        dev << a.x; //X1 pos
-                        dev << a.y; //Y1 pos
-                        dev << a.z; //Z1 pos
-                        dev << normal.x; //X normal
-                        dev << normal.y; //Y normal
-                        dev << normal.z; //Z normal
-                        dev << convertRotation(glm::vec3(rotX, rotY, rotZ)); //XYZ rotation from the XZ plane
-                        dev << coli->getCollisionTriangleFlag();
-                        dev << deltaPosB.x; //DX2X1
-                        dev << deltaPosB.y; //DY2X1
-                        dev << deltaPosC.x; //DX3X1
-                        dev << deltaPosC.y; //DY3X1
-                        dev << tangent.x; //X tangent
-                        dev << tangent.y; //Y tangent
-                        dev << bitangent.x; //X bitangent
-                        dev << bitangent.y; //Y bitangent
-                        //////////////// END OF MADNESS ////////////////
+            //First, find the mesh in the collisionMeshes QHash
+            if (collisionMeshes.contains(coli->getMeshName())) {
+                const Model::CollisionMesh *mesh = collisionMeshes.value(coli->getMeshName());
+
+                //Now loop over all triangles
+                for (int i = 0; i < mesh->getTriangleCount(); i++) {
+                    //////////////// BEGINNING OF MADNESS ////////////////
+                    //This code is mostly just copied from Yoshimaster96's smb(2)cnv
+                    //with some tweaks to make it less of a nightmare to read
+                    //I'm still not 100% sure what everything does though
+                    //
+                    //For clarification as to how a collision triangle is stored, the first coordinate is (X1, Y1, Z1),
+                    //the second coordinate is calculated as (X1 + DX2X1, Y1 + DY2Y1, Z1) then rotated about first
+                    //point by Z, then Y, then X. The third coordinate is calculated similarly, from
+                    //(X1 + DX3X1, Y1 + DY3Y1, Z1), rotated by the same angles
+                    //
+                    //Update:
+                    //Where the madness began: http://kuribo64.net/board/thread.php?pid=55329
+                    //Blank: cx, sx, cy, sy, cz and sz are floats and are the cosine and sine of the rotation angles.
+                    //Yoshimaster96: Those aren't given however. I'm trying to find the rotation angles.
+                    //Blank: You calculate the angles using cx, sx, etc. In my code snippet this is done with the reverse_angle function.
+                    //
+                    //For more info on how collision triangles work within Super Monkey Ball, see
+                    //https://craftedcart.github.io/SMBLevelWorkshop/documentation/index.html?page=lzFormat2#spec-lzFormat2-section-collisionTriangle
+
+                    glm::vec3 a = mesh->getTrianglePosition(i, 0);
+                    glm::vec3 b = mesh->getTrianglePosition(i, 1);
+                    glm::vec3 c = mesh->getTrianglePosition(i, 2);
+
+                    glm::vec3 normal = glm::normalize(cross(glm::normalize(b - a), glm::normalize(c - a)));
+
+                    float l = qSqrt(normal.x * normal.x + normal.z * normal.z);
+
+                    float cy;
+                    float sy;
+                    if (qFabs(l) < 0.001f) {
+                        cy = 1.0f;
+                        sy = 0.0f;
+                    } else {
+                        cy = normal.z / l;
+                        sy = -normal.x / l;
                     }
+
+                    float cx = l;
+                    float sx = normal.y;
+
+                    glm::mat3 rotXMat(
+                            1.0f, 0.0f, 0.0f,
+                            0.0f, cx, sx,
+                            0.0f, -sx, cx
+                            );
+
+                    glm::mat3 rotYMat(
+                            cy, 0.0f, -sy,
+                            0.0f, 1.0f, 0.0f,
+                            sy, 0.0f, cy
+                            );
+
+                    glm::vec3 dotry = dotm(b - a, rotYMat);
+                    glm::vec3 dotrxry = dotm(dotry, rotXMat);
+                    l = sqrtf(dotrxry.x * dotrxry.x + dotrxry.y * dotrxry.y);
+
+                    float cz = dotrxry.x / l;
+                    float sz = -dotrxry.y / l;
+
+                    glm::mat3 rotZMat(
+                            cz, sz, 0.0f,
+                            -sz, cz, 0.0f,
+                            0.0f, 0.0f, 1.0f
+                            );
+
+                    //Delta position for vertex B from vertex A (Before rotation is applied)
+                    glm::vec3 deltaPosB = dotm(dotrxry, rotZMat);
+
+                    dotry = dotm(c - a, rotYMat);
+                    dotrxry = dotm(dotry, rotXMat);
+                    //Delta position for vertex C from vertex A (Before rotation is applied)
+                    glm::vec3 deltaPosC = dotm(dotrxry, rotZMat);
+
+                    glm::vec3 n0v(deltaPosC.x - deltaPosB.x, deltaPosC.y - deltaPosB.y, deltaPosC.z - deltaPosB.z);
+                    glm::vec3 n1v(-deltaPosC.x, -deltaPosC.y, -deltaPosC.z);
+                    glm::vec3 tangent = glm::normalize(hat(n0v));
+                    glm::vec3 bitangent = glm::normalize(hat(n1v));
+
+                    float rotX = (2 * glm::pi<float>()) - reverseAngle(cx, sx);
+                    float rotY = (2 * glm::pi<float>()) - reverseAngle(cy, sy);
+                    float rotZ = (2 * glm::pi<float>()) - reverseAngle(cz, sz);
+
+                    dev << a.x; //X1 pos
+                    dev << a.y; //Y1 pos
+                    dev << a.z; //Z1 pos
+                    dev << normal.x; //X normal
+                    dev << normal.y; //Y normal
+                    dev << normal.z; //Z normal
+                    dev << convertRotation(glm::vec3(rotX, rotY, rotZ)); //XYZ rotation from the XZ plane
+                    dev << coli->getCollisionTriangleFlag();
+                    dev << deltaPosB.x; //DX2X1
+                    dev << deltaPosB.y; //DY2X1
+                    dev << deltaPosC.x; //DX3X1
+                    dev << deltaPosC.y; //DY3X1
+                    dev << tangent.x; //X tangent
+                    dev << tangent.y; //Y tangent
+                    dev << bitangent.x; //X bitangent
+                    dev << bitangent.y; //Y bitangent
+                    //////////////// END OF MADNESS ////////////////
                 }
             } /* else {
                 //models QHash doesn't have the mesh in question - don't add it
@@ -1497,7 +1676,7 @@ namespace WS2Lz {
     }
 
     void SMB2LzExporter::writeEffectHeader(QDataStream &dev, const Scene::MeshSceneNode *node) {
-        Animation::EffectAnimation* anim = node->getEffectAnimation();
+        const Animation::EffectAnimation *anim = node->getEffectAnimation();
         dev << (anim != nullptr ? anim->getEffect1Keyframes().size() : 0);
         dev << (anim != nullptr ? effectAnimType1KeyframesOffsetMap.key(anim) : 0);
         dev << (anim != nullptr ? anim->getEffect2Keyframes().size() : 0);
@@ -5,29 +5,58 @@
 //#include <cstdio>
 
 namespace WS2Lz {
-    TriangleIntersectionGrid::TriangleIntersectionGrid(
-            QVector<WS2Common::Model::Vertex> &vertices,
-            WS2Common::CollisionGrid &grid
-            ) {
-        this->vertices = vertices;
-
+    TriangleIntersectionGrid::TriangleIntersectionGrid(const WS2Common::CollisionGrid &grid) {
         //Resize the indicesGrid vectors
         indicesGrid.resize(grid.getGridStepCount().y);
         for (unsigned int i = 0; i < grid.getGridStepCount().y; i++) indicesGrid[i].resize(grid.getGridStepCount().x);
     }
 
     TriangleIntersectionGrid::TriangleIntersectionGrid(
-            QVector<WS2Common::Model::Vertex> &vertices,
-            QVector<unsigned int> &indices,
-            WS2Common::CollisionGrid &grid
-            ) : TriangleIntersectionGrid(vertices, grid) {
-        sortIntersections(indices, grid);
+            const QVector<WS2Common::Model::Vertex> &vertices,
+            const QVector<unsigned int> &indices,
+            const WS2Common::CollisionGrid &grid
+            ) : TriangleIntersectionGrid(grid) {
+        WS2Common::Model::CollisionMesh mesh;
+        mesh.append(vertices, indices);
+        sortIntersections(mesh, grid);
+    }
+
+    void TriangleIntersectionGrid::sortIntersections(
+            const WS2Common::Model::CollisionMesh &mesh,
+            const WS2Common::CollisionGrid &grid
+            ) {
+        sortIntersections(QVector<const WS2Common::Model::CollisionMesh*>() << &mesh, grid);
     }
 
     void TriangleIntersectionGrid::sortIntersections(
-            QVector<unsigned int> &indices,
-            WS2Common::CollisionGrid &grid
+            const QVector<const WS2Common::Model::CollisionMesh*> &meshes,
+            const WS2Common::CollisionGrid &grid
             ) {
+        //Give every triangle an AABB up front, rather than recalculating them for every grid tile
+        //Ignore Y - The collision grid only factors X/Z axes
+        int triangleCount = 0;
+        foreach(const WS2Common::Model::CollisionMesh *mesh, meshes) triangleCount += mesh->getTriangleCount();
+
+        QVector<WS2Common::AABB2> triangleAABBs(triangleCount);
+        WS2Common::AABB2 *triangleAABB = triangleAABBs.data();
+        foreach(const WS2Common::Model::CollisionMesh *mesh, meshes) {
+            const float *x = mesh->getPositionsX().constData();
+            const float *z = mesh->getPositionsZ().constData();
+            const quint32 *indices = mesh->getIndices().constData();
+            int indexCount = mesh->getTriangleCount() * 3;
+
+            for (int i = 0; i < indexCount; i += 3) {
+                //a/b/c = Vertex A/B/C
+                quint32 a = indices[i];
+                quint32 b = indices[i + 1];
+                quint32 c = indices[i + 2];
+
+                triangleAABB->a = glm::vec2(std::min(std::min(x[a], x[b]), x[c]), std::min(std::min(z[a], z[b]), z[c]));
+                triangleAABB->b = glm::vec2(std::max(std::max(x[a], x[b]), x[c]), std::max(std::max(z[a], z[b]), z[c]));
+                triangleAABB++;
+            }
+        }
+
         //Loop over all grid tiles
         //xi/yi = X iterator/Y iterator
         //TODO: Parallelise this maybe? There's probably no need to, but maybe?
@@ -55,26 +84,10 @@ namespace WS2Lz {
                 bottomRight.y += grid.getGridStep().y + PADDING;
                 WS2Common::AABB2 tileAABB(topLeft, bottomRight);
 
-                //Now iterate over every triangle, give the triangle an AABB, and check if they intersect
-                for (int i = 0; i < indices.size(); i += 3) {
-                    //va/b/c = Vertex A/B/C (Positions)
-                    const glm::vec3 va = vertices.at(indices.at(i)).position;
-                    const glm::vec3 vb = vertices.at(indices.at(i + 1)).position;
-                    const glm::vec3 vc = vertices.at(indices.at(i + 2)).position;
-
-                    //Ignore Y - The collision grid only factors X/Z axes
-                    glm::vec2 topLeft(
-                            std::min(std::min(va.x, vb.x), vc.x),
-                            std::min(std::min(va.z, vb.z), vc.z)
-                            );
-                    glm::vec2 bottomRight(
-                            std::max(std::max(va.x, vb.x), vc.x),
-                            std::max(std::max(va.z, vb.z), vc.z)
-                            );
-                    WS2Common::AABB2 triangleAABB(topLeft, bottomRight);
-
-                    if (doAABBsIntersect(tileAABB, triangleAABB)) {
-                        indicesGrid[yi][xi].append(i / 3);
+                //Now check every triangle's AABB against the tile's
+                for (int i = 0; i < triangleCount; i++) {
+                    if (doAABBsIntersect(tileAABB, triangleAABBs.at(i))) {
+                        indicesGrid[yi][xi].append(i);
                     }
                 }
             }
@@ -0,0 +1,91 @@
+/**
+ * @file
+ * @brief Header for the Benchmark class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2LZBENCH_BENCHMARK_HPP
+#define SMBLEVELWORKSHOP2_WS2LZBENCH_BENCHMARK_HPP
+
+#include <QString>
+#include <QVector>
+#include <functional>
+
+namespace WS2LzBench {
+
+    /**
+     * @brief Times repeated runs of a function and computes statistics over the samples
+     */
+    class Benchmark {
+        protected:
+            QString name;
+
+            /**
+             * @brief Wall time of each timed repetition, in seconds
+             */
+            QVector<double> samples;
+
+        public:
+            Benchmark(const QString &name);
+
+            /**
+             * @brief Runs func warmupCount times untimed, then repetitions times timed
+             *
+             * @param warmupCount How many untimed runs to do first, to warm up caches and the thread pool
+             * @param repetitions How many timed runs to do
+             * @param func The function to benchmark
+             */
+            void run(unsigned int warmupCount, unsigned int repetitions, std::function<void()> func);
+
+            /**
+             * @brief Runs func warmupCount times untimed, then repetitions times timed, with untimed setup and cleanup
+             *        around each run
+             *
+             * @param warmupCount How many untimed runs to do first, to warm up caches and the thread pool
+             * @param repetitions How many timed runs to do
+             * @param setup Called before each run of func, untimed - may be empty
+             * @param func The function to benchmark
+             * @param cleanup Called after each run of func, untimed - may be empty
+             */
+            void run(
+                    unsigned int warmupCount,
+                    unsigned int repetitions,
+                    std::function<void()> setup,
+                    std::function<void()> func,
+                    std::function<void()> cleanup
+                    );
+
+            const QString& getName() const;
+            const QVector<double>& getSamples() const;
+
+            /**
+             * @return The mean of all samples, in seconds
+             */
+            double getMean() const;
+
+            /**
+             * @return The sample variance of all samples, in seconds squared
+             */
+            double getVariance() const;
+
+            /**
+             * @return The sample standard deviation of all samples, in seconds
+             */
+            double getStdDev() const;
+
+            double getMin() const;
+            double getMax() const;
+
+            /**
+             * @brief Formats the timing statistics on a single line
+             *
+             * @param workUnits How much work was done per repetition (Eg: triangles or megabytes) - used for throughput
+             * @param workUnitName The name of the unit of work (Eg: "tris" or "MB") - if empty, no throughput is shown
+             *
+             * @return A human readable summary of this benchmark
+             */
+            QString toString(double workUnits = 0.0, const QString &workUnitName = QString()) const;
+    };
+}
+
+#endif
+
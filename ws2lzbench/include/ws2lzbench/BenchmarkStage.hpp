@@ -0,0 +1,136 @@
+/**
+ * @file
+ * @brief Header for the BenchmarkStage class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2LZBENCH_BENCHMARKSTAGE_HPP
+#define SMBLEVELWORKSHOP2_WS2LZBENCH_BENCHMARKSTAGE_HPP
+
+#include "ws2common/Stage.hpp"
+#include "ws2common/scene/GroupSceneNode.hpp"
+#include "ws2common/resource/ResourceMesh.hpp"
+#include "ws2common/model/Vertex.hpp"
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QHash>
+
+namespace WS2LzBench {
+
+    /**
+     * @brief Parameters used to generate a synthetic stage
+     */
+    struct SyntheticStageParams {
+        /**
+         * @brief Total number of collision triangles, split evenly between item groups
+         */
+        unsigned int triangleCount = 10000;
+
+        /**
+         * @brief Number of collision grid tiles along each of the X and Z axes
+         */
+        unsigned int gridSize = 16;
+
+        unsigned int itemGroupCount = 1;
+
+        /**
+         * @brief Total number of bananas, split evenly between item groups
+         */
+        unsigned int bananaCount = 0;
+
+        /**
+         * @brief Seed for the random number generator used to jitter vertex heights and place bananas
+         */
+        quint32 seed = 0;
+    };
+
+    /**
+     * @brief A stage along with all of the models it needs, for use in benchmarks
+     */
+    class BenchmarkStage {
+        public:
+            /**
+             * @brief All collision triangles within an item group, gathered the same way the exporter does
+             */
+            struct CollisionData {
+                const WS2Common::Scene::GroupSceneNode *group;
+                QVector<WS2Common::Model::Vertex> vertices;
+                QVector<unsigned int> indices;
+            };
+
+        protected:
+            QString name;
+            WS2Common::Stage *stage = nullptr;
+
+            /**
+             * @brief Owns all meshes and textures used by the stage
+             */
+            QVector<WS2Common::Resource::AbstractResource*> resources;
+
+            QHash<QString, WS2Common::Resource::ResourceMesh*> models; //name, mesh
+
+            BenchmarkStage() = default;
+
+            void collectCollision(
+                    const WS2Common::Scene::SceneNode *node,
+                    QVector<WS2Common::Model::Vertex> &vertices,
+                    QVector<unsigned int> &indices
+                    );
+
+        public:
+            ~BenchmarkStage();
+
+            /**
+             * @brief Generates a stage made up of heightfield-like collision meshes spanning each item group's
+             *        collision grid, along with randomly placed bananas
+             *
+             * @param params The parameters for stage generation
+             *
+             * @return A new synthetic stage - The caller takes ownership
+             */
+            static BenchmarkStage* createSynthetic(const SyntheticStageParams &params);
+
+            /**
+             * @brief Parses an XML stage config and loads every model it imports
+             *
+             * @param configPath Path to the XML config
+             *
+             * @throws WS2Common::Exception::ModelLoadingException When a model fails to load
+             *
+             * @return A new stage - The caller takes ownership
+             */
+            static BenchmarkStage* loadFromConfig(const QString &configPath);
+
+            /**
+             * @brief Generates an XML config with the given number of item objects, for benchmarking config parsing
+             *
+             * Objects are split between item groups of up to 1000 objects each, and each item group is animated with
+             * 100 keyframes on each of its position and rotation axes. No models are imported.
+             *
+             * @param nodeCount How many item objects (Bananas, bumpers, jamabars and goals) to generate
+             * @param seed Seed for the random number generator used to place objects
+             *
+             * @return The config, as UTF-8 XML
+             */
+            static QByteArray createSyntheticConfig(unsigned int nodeCount, quint32 seed);
+
+            const QString& getName() const;
+            WS2Common::Stage* getStage();
+            QHash<QString, WS2Common::Resource::ResourceMesh*>& getModels();
+
+            /**
+             * @brief Gathers all collision triangles for each root item group
+             *
+             * @return Collision data for each item group
+             */
+            QVector<CollisionData> getCollisionData();
+
+            /**
+             * @return The total number of collision triangles across all item groups
+             */
+            unsigned int getCollisionTriangleCount();
+    };
+}
+
+#endif
+
@@ -0,0 +1,113 @@
+/**
+ * @file
+ * @brief Header for the GoldenCorpus class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2LZBENCH_GOLDENCORPUS_HPP
+#define SMBLEVELWORKSHOP2_WS2LZBENCH_GOLDENCORPUS_HPP
+
+#include "ws2lzbench/BenchmarkStage.hpp"
+#include "ws2lz/SMB2LzExporter.hpp"
+#include <QString>
+#include <QByteArray>
+#include <QJsonObject>
+#include <QDir>
+
+namespace WS2LzBench {
+
+    /**
+     * @brief A fixed set of stages along with SHA-256 hashes of their raw and compressed LZ output
+     *
+     * Used to make sure changes to the exporter, collision optimization or compressor don't change any output bytes.
+     *
+     * The corpus is a JSON file with a "cases" array. Each case has a "name", and either a "config" (An XML stage
+     * config path relative to the JSON file) or "synthetic" parameters ("triangles", "grid", "groups", "bananas",
+     * "seed"). Golden values are stored in each case's "raw" and "compressed" objects, with "raw" also containing a
+     * hash per exporter section so that mismatches can be narrowed down.
+     */
+    class GoldenCorpus {
+        protected:
+            /**
+             * @brief The output of exporting a single case
+             */
+            struct CaseOutput {
+                QByteArray raw;
+                QByteArray compressed;
+                QVector<WS2Lz::SMB2LzExporter::Section> sections;
+            };
+
+            QString filePath;
+            QJsonObject root;
+
+            /**
+             * @brief Loads the stage for a case
+             *
+             * @param caseObj The case to load
+             *
+             * @throws WS2Common::Exception::ModelLoadingException When a model fails to load
+             *
+             * @return The loaded stage, or nullptr if the case is invalid - The caller takes ownership
+             */
+            BenchmarkStage* loadCaseStage(const QJsonObject &caseObj);
+
+            /**
+             * @brief Exports a case to a raw and compressed LZ
+             *
+             * @param caseObj The case to export
+             * @param out Where the output is written to
+             *
+             * @return Whether the export was successful
+             */
+            bool exportCase(const QJsonObject &caseObj, CaseOutput &out);
+
+            /**
+             * @brief Creates the golden values for an export
+             *
+             * @param out The output to hash
+             * @param caseObj The case to write "raw" and "compressed" golden values into
+             */
+            void writeGoldenValues(const CaseOutput &out, QJsonObject &caseObj);
+
+            /**
+             * @brief Compares an export against a case's golden values, and logs every difference
+             *
+             * @param caseObj The case with golden values
+             * @param out The output to compare
+             *
+             * @return Whether the output matches
+             */
+            bool compareGoldenValues(const QJsonObject &caseObj, const CaseOutput &out);
+
+            static QString sha256(const QByteArray &data);
+
+        public:
+            /**
+             * @brief Reads a corpus file
+             *
+             * @param filePath Path to the corpus JSON file
+             * @param error Set to a description of what went wrong if loading fails
+             *
+             * @return Whether loading was successful
+             */
+            bool load(const QString &filePath, QString &error);
+
+            /**
+             * @brief Exports every case and compares it against the golden values
+             *
+             * @return The number of cases that failed (Cases without golden values also count as failures)
+             */
+            int verify();
+
+            /**
+             * @brief Exports every case and overwrites the golden values in the corpus file with the results
+             *
+             * Only do this on a build known to produce correct output!
+             *
+             * @return Whether all cases exported and the corpus file was saved
+             */
+            bool update();
+    };
+}
+
+#endif
+
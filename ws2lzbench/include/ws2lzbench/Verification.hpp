@@ -0,0 +1,46 @@
+/**
+ * @file
+ * @brief Header for the WS2LzBench::Verification namespace
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2LZBENCH_VERIFICATION_HPP
+#define SMBLEVELWORKSHOP2_WS2LZBENCH_VERIFICATION_HPP
+
+#include <QString>
+
+namespace WS2LzBench {
+
+    /**
+     * @brief Checks that compare optimized library code against a simple reference, run with ctest
+     *
+     * Each check logs every mismatch it finds and returns whether everything matched.
+     */
+    namespace Verification {
+
+        /**
+         * @brief Loads a model whose root node has a translation, rotation and non uniform scale with
+         *        ModelLoader::loadModel, and compares every vertex position against the root transform applied by
+         *        Assimp (aiMatrix4x4 * aiVector3D)
+         *
+         * @return Whether every vertex matched
+         */
+        bool verifyRootTransform();
+
+        /**
+         * @brief Compares SerializeUtils::parseFloat against QString::toFloat bit for bit
+         *
+         * Every attribute value and text element in the XML configs under configDirectory (And in a generated
+         * config) is parsed both ways, along with edge cases (Long mantissas, large exponents, denormals, signed zeros,
+         * inf/nan and malformed numbers) and randomly generated literals. Both the result and whether it was valid
+         * must match.
+         *
+         * @param configDirectory A directory to search recursively for XML configs
+         *
+         * @return Whether every literal parsed identically
+         */
+        bool verifyFloats(const QString &configDirectory);
+    }
+}
+
+#endif
+
@@ -0,0 +1,95 @@
+#include "ws2lzbench/Benchmark.hpp"
+#include <QElapsedTimer>
+#include <algorithm>
+#include <math.h>
+
+namespace WS2LzBench {
+    Benchmark::Benchmark(const QString &name) :
+        name(name) {}
+
+    void Benchmark::run(unsigned int warmupCount, unsigned int repetitions, std::function<void()> func) {
+        run(warmupCount, repetitions, std::function<void()>(), func, std::function<void()>());
+    }
+
+    void Benchmark::run(
+            unsigned int warmupCount,
+            unsigned int repetitions,
+            std::function<void()> setup,
+            std::function<void()> func,
+            std::function<void()> cleanup
+            ) {
+        for (unsigned int i = 0; i < warmupCount; i++) {
+            if (setup) setup();
+            func();
+            if (cleanup) cleanup();
+        }
+
+        QElapsedTimer timer;
+        for (unsigned int i = 0; i < repetitions; i++) {
+            if (setup) setup();
+            timer.start();
+            func();
+            samples.append(timer.nsecsElapsed() / 1000000000.0);
+            if (cleanup) cleanup();
+        }
+    }
+
+    const QString& Benchmark::getName() const {
+        return name;
+    }
+
+    const QVector<double>& Benchmark::getSamples() const {
+        return samples;
+    }
+
+    double Benchmark::getMean() const {
+        if (samples.isEmpty()) return 0.0;
+
+        double sum = 0.0;
+        foreach(double sample, samples) sum += sample;
+        return sum / samples.size();
+    }
+
+    double Benchmark::getVariance() const {
+        if (samples.size() < 2) return 0.0;
+
+        double mean = getMean();
+        double sumSquares = 0.0;
+        foreach(double sample, samples) sumSquares += (sample - mean) * (sample - mean);
+        return sumSquares / (samples.size() - 1);
+    }
+
+    double Benchmark::getStdDev() const {
+        return sqrt(getVariance());
+    }
+
+    double Benchmark::getMin() const {
+        if (samples.isEmpty()) return 0.0;
+        return *std::min_element(samples.constBegin(), samples.constEnd());
+    }
+
+    double Benchmark::getMax() const {
+        if (samples.isEmpty()) return 0.0;
+        return *std::max_element(samples.constBegin(), samples.constEnd());
+    }
+
+    QString Benchmark::toString(double workUnits, const QString &workUnitName) const {
+        double mean = getMean();
+
+        QString str = QString("%1 mean %2s ± %3s (%4%), min %5s, max %6s, n=%7")
+            .arg(name, -40)
+            .arg(mean, 0, 'f', 4)
+            .arg(getStdDev(), 0, 'f', 4)
+            .arg(mean > 0.0 ? getStdDev() / mean * 100.0 : 0.0, 0, 'f', 1)
+            .arg(getMin(), 0, 'f', 4)
+            .arg(getMax(), 0, 'f', 4)
+            .arg(samples.size());
+
+        if (!workUnitName.isEmpty() && mean > 0.0) {
+            str += QString(" | %1 %2/s").arg(workUnits / mean, 0, 'f', 2).arg(workUnitName);
+        }
+
+        return str;
+    }
+}
+
@@ -0,0 +1,281 @@
+#include "ws2lzbench/BenchmarkStage.hpp"
+#include "ws2common/config/XMLConfigParser.hpp"
+#include "ws2common/model/ModelLoader.hpp"
+#include "ws2common/scene/StartSceneNode.hpp"
+#include "ws2common/scene/MeshSceneNode.hpp"
+#include "ws2common/scene/MeshCollisionSceneNode.hpp"
+#include "ws2common/scene/BananaSceneNode.hpp"
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QXmlStreamWriter>
+#include <QDebug>
+#include <random>
+#include <utility>
+#include <math.h>
+
+namespace WS2LzBench {
+    using namespace WS2Common;
+
+    /**
+     * @brief Returns a random float in [min, max)
+     *
+     * std::uniform_real_distribution isn't used as its output differs between standard library implementations,
+     * and synthetic stages need to be identical everywhere for golden output checks
+     */
+    static float randomFloat(std::mt19937 &randGen, float min, float max) {
+        float unit = (randGen() >> 8) * (1.0f / 16777216.0f); //Top 24 bits - exactly representable as a float
+        return min + unit * (max - min);
+    }
+
+    BenchmarkStage::~BenchmarkStage() {
+        delete stage;
+        qDeleteAll(resources);
+    }
+
+    BenchmarkStage* BenchmarkStage::createSynthetic(const SyntheticStageParams &params) {
+        //Each grid tile stores triangle indices as 16 bit integers, so an item group can't have more than this many
+        const unsigned int MAX_TRIANGLES_PER_GROUP = 65535;
+        //Synthetic meshes span the default collision grid area
+        const float STAGE_START = -256.0f;
+        const float STAGE_SIZE = 512.0f;
+
+        BenchmarkStage *bench = new BenchmarkStage();
+        bench->name = QString("synthetic [tris=%1 grid=%2 groups=%3 bananas=%4]")
+            .arg(params.triangleCount)
+            .arg(params.gridSize)
+            .arg(params.itemGroupCount)
+            .arg(params.bananaCount);
+        bench->stage = new Stage();
+
+        std::mt19937 randGen(params.seed);
+
+        bench->stage->getRootNode()->addChild(new Scene::StartSceneNode("Start"));
+
+        unsigned int groupCount = qMax(params.itemGroupCount, 1u);
+        unsigned int gridSize = qMax(params.gridSize, 1u);
+
+        for (unsigned int g = 0; g < groupCount; g++) {
+            Scene::GroupSceneNode *group = new Scene::GroupSceneNode(QString("Group %1").arg(g));
+            group->getCollisionGrid().setGridStart(glm::vec2(STAGE_START, STAGE_START));
+            group->getCollisionGrid().setGridStep(glm::vec2(STAGE_SIZE / gridSize, STAGE_SIZE / gridSize));
+            group->getCollisionGrid().setGridStepCount(glm::uvec2(gridSize, gridSize));
+            bench->stage->getRootNode()->addChild(group);
+
+            //Split triangles between groups, giving any remainder to the first group
+            unsigned int triangleCount = params.triangleCount / groupCount;
+            if (g == 0) triangleCount += params.triangleCount % groupCount;
+            if (triangleCount > MAX_TRIANGLES_PER_GROUP) {
+                qWarning().noquote() << "Clamping" << triangleCount << "triangles in a synthetic item group to" <<
+                    MAX_TRIANGLES_PER_GROUP;
+                triangleCount = MAX_TRIANGLES_PER_GROUP;
+            }
+
+            if (triangleCount > 0) {
+                //Build a square heightfield with enough quads to fit triangleCount triangles
+                unsigned int side = (unsigned int) ceil(sqrt(ceil(triangleCount / 2.0)));
+                float quadSize = STAGE_SIZE / side;
+
+                QVector<Model::Vertex> vertices;
+                vertices.reserve((side + 1) * (side + 1));
+                for (unsigned int z = 0; z <= side; z++) {
+                    for (unsigned int x = 0; x <= side; x++) {
+                        Model::Vertex vert;
+                        vert.position = glm::vec3(STAGE_START + x * quadSize, randomFloat(randGen, -1.0f, 1.0f), STAGE_START + z * quadSize);
+                        vert.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+                        vert.texCoord = glm::vec2((float) x / side, (float) z / side);
+                        vertices.append(vert);
+                    }
+                }
+
+                QVector<unsigned int> indices;
+                indices.reserve(triangleCount * 3);
+                for (unsigned int i = 0; i < triangleCount; i++) {
+                    unsigned int quad = i / 2;
+                    unsigned int a = (quad / side) * (side + 1) + (quad % side);
+                    unsigned int b = a + 1;
+                    unsigned int c = a + side + 1;
+                    unsigned int d = c + 1;
+
+                    if (i % 2 == 0) {
+                        indices << a << c << b;
+                    } else {
+                        indices << b << c << d;
+                    }
+                }
+
+                QString meshName = QString("synthetic_%1").arg(g);
+                Resource::ResourceMesh *mesh = new Resource::ResourceMesh();
+                mesh->setId(meshName);
+                mesh->addMeshSegment(new Model::MeshSegment(std::move(vertices), std::move(indices), QVector<Resource::ResourceTexture*>()));
+                bench->resources.append(mesh);
+                bench->models[meshName] = mesh;
+
+                //Same structure as a <stageModel> with mesh collision in an XML config
+                Scene::MeshSceneNode *meshNode = new Scene::MeshSceneNode(meshName);
+                meshNode->setMeshName(meshName);
+                Scene::MeshCollisionSceneNode *collision = new Scene::MeshCollisionSceneNode("Mesh Collision: " + meshName);
+                collision->setMeshName(meshName);
+                meshNode->addChild(collision);
+                group->addChild(meshNode);
+            }
+
+            unsigned int bananaCount = params.bananaCount / groupCount;
+            if (g == 0) bananaCount += params.bananaCount % groupCount;
+            for (unsigned int i = 0; i < bananaCount; i++) {
+                Scene::BananaSceneNode *banana = new Scene::BananaSceneNode(QString("Banana %1").arg(i));
+                float x = randomFloat(randGen, STAGE_START, STAGE_START + STAGE_SIZE);
+                float z = randomFloat(randGen, STAGE_START, STAGE_START + STAGE_SIZE);
+                banana->setPosition(glm::vec3(x, 1.0f, z));
+                group->addChild(banana);
+            }
+        }
+
+        return bench;
+    }
+
+    BenchmarkStage* BenchmarkStage::loadFromConfig(const QString &configPath) {
+        BenchmarkStage *bench = new BenchmarkStage();
+        bench->name = configPath;
+
+        QFile configFile(configPath);
+        configFile.open(QIODevice::ReadOnly);
+
+        Config::XMLConfigParser confParser;
+        bench->stage = confParser.parseStage(configFile, QFileInfo(configFile).dir());
+        configFile.close();
+
+        QMutex resourcesMutex;
+        try {
+            foreach(QUrl url, bench->stage->getModels()) {
+                QFile file(url.toLocalFile());
+                QVector<Resource::ResourceMesh*> meshVec = Model::ModelLoader::loadModel(file, &bench->resources, &resourcesMutex);
+                foreach(Resource::ResourceMesh* mesh, meshVec) {
+                    bench->models[mesh->getId()] = mesh;
+                }
+            }
+        } catch (...) {
+            delete bench;
+            throw;
+        }
+
+        return bench;
+    }
+
+    QByteArray BenchmarkStage::createSyntheticConfig(unsigned int nodeCount, quint32 seed) {
+        const unsigned int NODES_PER_GROUP = 1000;
+        const unsigned int KEYFRAMES_PER_AXIS = 100;
+        const char *AXIS_ELEMENTS[] = {"posX", "posY", "posZ", "rotX", "rotY", "rotZ"};
+        const char *OBJECT_ELEMENTS[] = {"banana", "bumper", "jamabar", "goal"};
+
+        std::mt19937 randGen(seed);
+
+        QByteArray config;
+        QXmlStreamWriter xml(&config);
+        xml.setAutoFormatting(true);
+        xml.writeStartDocument();
+        xml.writeStartElement("superMonkeyBallStage");
+        xml.writeAttribute("version", "1.3.0");
+
+        xml.writeStartElement("start");
+        xml.writeEmptyElement("position");
+        xml.writeAttribute("x", "0");
+        xml.writeAttribute("y", "1");
+        xml.writeAttribute("z", "0");
+        xml.writeEndElement();
+
+        unsigned int groupCount = qMax((nodeCount + NODES_PER_GROUP - 1) / NODES_PER_GROUP, 1u);
+        unsigned int node = 0;
+        for (unsigned int g = 0; g < groupCount; g++) {
+            xml.writeStartElement("itemGroup");
+
+            xml.writeStartElement("animKeyframes");
+            for (const char *axis : AXIS_ELEMENTS) {
+                xml.writeStartElement(axis);
+                for (unsigned int k = 0; k < KEYFRAMES_PER_AXIS; k++) {
+                    xml.writeEmptyElement("keyframe");
+                    xml.writeAttribute("time", QString::number(k * 0.5f));
+                    xml.writeAttribute("value", QString::number(randomFloat(randGen, -10.0f, 10.0f)));
+                    xml.writeAttribute("easing", "LINEAR");
+                }
+                xml.writeEndElement();
+            }
+            xml.writeEndElement();
+            xml.writeTextElement("animLoopTime", QString::number(KEYFRAMES_PER_AXIS * 0.5f));
+
+            unsigned int groupEnd = qMin(node + NODES_PER_GROUP, nodeCount);
+            for (; node < groupEnd; node++) {
+                xml.writeStartElement(OBJECT_ELEMENTS[node % 4]);
+                xml.writeEmptyElement("position");
+                xml.writeAttribute("x", QString::number(randomFloat(randGen, -256.0f, 256.0f)));
+                xml.writeAttribute("y", QString::number(randomFloat(randGen, 0.0f, 16.0f)));
+                xml.writeAttribute("z", QString::number(randomFloat(randGen, -256.0f, 256.0f)));
+                xml.writeEndElement();
+            }
+
+            xml.writeEndElement();
+        }
+
+        xml.writeEndElement();
+        xml.writeEndDocument();
+
+        return config;
+    }
+
+    const QString& BenchmarkStage::getName() const {
+        return name;
+    }
+
+    Stage* BenchmarkStage::getStage() {
+        return stage;
+    }
+
+    QHash<QString, Resource::ResourceMesh*>& BenchmarkStage::getModels() {
+        return models;
+    }
+
+    void BenchmarkStage::collectCollision(
+            const Scene::SceneNode *node,
+            QVector<Model::Vertex> &vertices,
+            QVector<unsigned int> &indices
+            ) {
+        if (const Scene::MeshCollisionSceneNode *coli = dynamic_cast<const Scene::MeshCollisionSceneNode*>(node)) {
+            if (models.contains(coli->getMeshName())) {
+                foreach(const Model::MeshSegment *seg, models.value(coli->getMeshName())->getMeshSegments()) {
+                    int prevSize = vertices.size();
+                    vertices.append(seg->getVertices());
+
+                    foreach(unsigned int ind, seg->getIndices()) {
+                        indices.append(ind + prevSize);
+                    }
+                }
+            }
+        }
+
+        foreach(const Scene::SceneNode *child, node->getChildren()) {
+            collectCollision(child, vertices, indices);
+        }
+    }
+
+    QVector<BenchmarkStage::CollisionData> BenchmarkStage::getCollisionData() {
+        QVector<CollisionData> data;
+
+        foreach(Scene::SceneNode *node, stage->getRootNode()->getChildren()) {
+            if (Scene::GroupSceneNode *group = dynamic_cast<Scene::GroupSceneNode*>(node)) {
+                CollisionData groupData;
+                groupData.group = group;
+                collectCollision(group, groupData.vertices, groupData.indices);
+                data.append(groupData);
+            }
+        }
+
+        return data;
+    }
+
+    unsigned int BenchmarkStage::getCollisionTriangleCount() {
+        unsigned int count = 0;
+        foreach(const CollisionData &data, getCollisionData()) count += data.indices.size() / 3;
+        return count;
+    }
+}
+
@@ -0,0 +1,227 @@
+#include "ws2lzbench/GoldenCorpus.hpp"
+#include "ws2common/exception/ModelLoadingException.hpp"
+#include "ws2lz/LZCompressor.hpp"
+#include <QFile>
+#include <QFileInfo>
+#include <QBuffer>
+#include <QDataStream>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QCryptographicHash>
+#include <QDebug>
+
+namespace WS2LzBench {
+    bool GoldenCorpus::load(const QString &filePath, QString &error) {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            error = QString("Failed to open %1: %2").arg(filePath).arg(file.errorString());
+            return false;
+        }
+
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+        file.close();
+
+        if (doc.isNull() || !doc.isObject()) {
+            error = QString("Failed to parse %1: %2").arg(filePath).arg(parseError.errorString());
+            return false;
+        }
+
+        this->filePath = filePath;
+        root = doc.object();
+        return true;
+    }
+
+    int GoldenCorpus::verify() {
+        int failures = 0;
+
+        foreach(const QJsonValue &caseValue, root.value("cases").toArray()) {
+            QJsonObject caseObj = caseValue.toObject();
+            QString name = caseObj.value("name").toString();
+
+            CaseOutput out;
+            if (!exportCase(caseObj, out)) {
+                qCritical().noquote() << "FAIL" << name << "- export failed";
+                ++failures;
+                continue;
+            }
+
+            if (compareGoldenValues(caseObj, out)) {
+                qInfo().noquote() << "PASS" << name;
+            } else {
+                ++failures;
+            }
+        }
+
+        return failures;
+    }
+
+    bool GoldenCorpus::update() {
+        QJsonArray cases = root.value("cases").toArray();
+        bool success = true;
+
+        for (int i = 0; i < cases.size(); i++) {
+            QJsonObject caseObj = cases[i].toObject();
+
+            CaseOutput out;
+            if (!exportCase(caseObj, out)) {
+                qCritical().noquote() << "Failed to export" << caseObj.value("name").toString();
+                success = false;
+                continue;
+            }
+
+            writeGoldenValues(out, caseObj);
+            cases[i] = caseObj;
+            qInfo().noquote() << "Updated" << caseObj.value("name").toString();
+        }
+
+        root["cases"] = cases;
+
+        QFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qCritical().noquote() << "Failed to write" << filePath << "-" << file.errorString();
+            return false;
+        }
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+        file.close();
+
+        return success;
+    }
+
+    BenchmarkStage* GoldenCorpus::loadCaseStage(const QJsonObject &caseObj) {
+        if (caseObj.contains("config")) {
+            QDir corpusDir = QFileInfo(filePath).dir();
+            return BenchmarkStage::loadFromConfig(corpusDir.filePath(caseObj.value("config").toString()));
+        } else if (caseObj.contains("synthetic")) {
+            QJsonObject synthetic = caseObj.value("synthetic").toObject();
+
+            SyntheticStageParams params;
+            params.triangleCount = synthetic.value("triangles").toInt(params.triangleCount);
+            params.gridSize = synthetic.value("grid").toInt(params.gridSize);
+            params.itemGroupCount = synthetic.value("groups").toInt(params.itemGroupCount);
+            params.bananaCount = synthetic.value("bananas").toInt(params.bananaCount);
+            params.seed = synthetic.value("seed").toInt(params.seed);
+
+            return BenchmarkStage::createSynthetic(params);
+        } else {
+            qCritical().noquote() << "Case" << caseObj.value("name").toString() << "has neither a config nor synthetic parameters";
+            return nullptr;
+        }
+    }
+
+    bool GoldenCorpus::exportCase(const QJsonObject &caseObj, CaseOutput &out) {
+        BenchmarkStage *bench;
+        try {
+            bench = loadCaseStage(caseObj);
+        } catch (const WS2Common::Exception::ModelLoadingException &e) {
+            qCritical().noquote() << "Error while loading model:" << e.getMessage();
+            return false;
+        }
+
+        if (bench == nullptr) return false;
+
+        QBuffer buf;
+        buf.open(QIODevice::ReadWrite);
+        QDataStream dStream(&buf);
+
+        WS2Lz::SMB2LzExporter exporter;
+        exporter.setModels(bench->getModels());
+        exporter.generate(dStream, *bench->getStage());
+
+        out.raw = buf.data();
+        out.sections = exporter.getSections();
+
+        WS2Lz::LZCompressor compressor;
+        out.compressed = compressor.compress(out.raw);
+
+        delete bench;
+        return true;
+    }
+
+    void GoldenCorpus::writeGoldenValues(const CaseOutput &out, QJsonObject &caseObj) {
+        QJsonArray sections;
+        foreach(const WS2Lz::SMB2LzExporter::Section &section, out.sections) {
+            QJsonObject sectionObj;
+            sectionObj["name"] = section.name;
+            sectionObj["offset"] = (qint64) section.offset;
+            sectionObj["length"] = (qint64) section.length;
+            sectionObj["sha256"] = sha256(out.raw.mid(section.offset, section.length));
+            sections.append(sectionObj);
+        }
+
+        QJsonObject raw;
+        raw["size"] = out.raw.size();
+        raw["sha256"] = sha256(out.raw);
+        raw["sections"] = sections;
+
+        QJsonObject compressed;
+        compressed["size"] = out.compressed.size();
+        compressed["sha256"] = sha256(out.compressed);
+
+        caseObj["raw"] = raw;
+        caseObj["compressed"] = compressed;
+    }
+
+    bool GoldenCorpus::compareGoldenValues(const QJsonObject &caseObj, const CaseOutput &out) {
+        QString name = caseObj.value("name").toString();
+
+        if (!caseObj.contains("raw") || !caseObj.contains("compressed")) {
+            qCritical().noquote() << "FAIL" << name << "- no golden values recorded (Run with --update-golden on a known good build)";
+            return false;
+        }
+
+        QJsonObject raw = caseObj.value("raw").toObject();
+        QJsonObject compressed = caseObj.value("compressed").toObject();
+
+        bool rawMatches = raw.value("sha256").toString() == sha256(out.raw);
+        bool compressedMatches = compressed.value("sha256").toString() == sha256(out.compressed);
+        if (rawMatches && compressedMatches) return true;
+
+        qCritical().noquote() << "FAIL" << name;
+        qCritical().noquote().nospace() << "    Raw: " << (rawMatches ? "matches" : "DIFFERS") <<
+            " (size " << raw.value("size").toInt() << " -> " << out.raw.size() << ")";
+        qCritical().noquote().nospace() << "    Compressed: " << (compressedMatches ? "matches" : "DIFFERS") <<
+            " (size " << compressed.value("size").toInt() << " -> " << out.compressed.size() << ")";
+
+        if (rawMatches) return false; //The compressor changed - there's no finer grained info to give
+
+        //Diff the raw LZ section by section
+        QJsonArray goldenSections = raw.value("sections").toArray();
+        if (goldenSections.size() != out.sections.size()) {
+            qCritical().noquote().nospace() << "    Section count differs: " << goldenSections.size() << " -> " << out.sections.size();
+        }
+
+        int sectionCount = qMin(goldenSections.size(), out.sections.size());
+        for (int i = 0; i < sectionCount; i++) {
+            QJsonObject golden = goldenSections[i].toObject();
+            const WS2Lz::SMB2LzExporter::Section &section = out.sections.at(i);
+
+            if (golden.value("name").toString() != section.name) {
+                qCritical().noquote().nospace() << "    Section " << i << " is now " << section.name << " (Was " <<
+                    golden.value("name").toString() << ") - the section layout has changed";
+                break;
+            }
+
+            quint32 goldenOffset = golden.value("offset").toVariant().toUInt();
+            quint32 goldenLength = golden.value("length").toVariant().toUInt();
+            bool contentMatches = golden.value("sha256").toString() == sha256(out.raw.mid(section.offset, section.length));
+
+            if (goldenOffset != section.offset || goldenLength != section.length || !contentMatches) {
+                qCritical().noquote() << QString("    %1 offset 0x%2 -> 0x%3, length %4 -> %5, content %6")
+                    .arg(section.name, -40)
+                    .arg(goldenOffset, 8, 16, QChar('0'))
+                    .arg(section.offset, 8, 16, QChar('0'))
+                    .arg(goldenLength)
+                    .arg(section.length)
+                    .arg(contentMatches ? "matches" : "DIFFERS");
+            }
+        }
+
+        return false;
+    }
+
+    QString GoldenCorpus::sha256(const QByteArray &data) {
+        return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
+    }
+}
+
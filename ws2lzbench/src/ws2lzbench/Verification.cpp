@@ -0,0 +1,295 @@
+#include "ws2lzbench/Verification.hpp"
+#include "ws2lzbench/BenchmarkStage.hpp"
+#include "ws2common/SerializeUtils.hpp"
+#include "ws2common/model/ModelLoader.hpp"
+#include "ws2common/resource/ResourceMesh.hpp"
+#include "ws2common/exception/ModelLoadingException.hpp"
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDirIterator>
+#include <QXmlStreamReader>
+#include <QDebug>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace WS2LzBench {
+    namespace Verification {
+        /**
+         * @brief A glTF 2 model with a single triangle on a single root node
+         *
+         * Assimp uses a glTF scene's only node as the root node, so its transform ends up as the root transform. The
+         * buffer holds the positions (1, 0, 0), (0, 2, 0) and (0, 0, 3).
+         */
+        static const char ROOT_TRANSFORM_GLTF[] = R"({
+    "asset": {"version": "2.0"},
+    "scene": 0,
+    "scenes": [{"nodes": [0]}],
+    "nodes": [{
+        "name": "root",
+        "mesh": 0,
+        "translation": [10.0, -20.0, 30.0],
+        "rotation": [0.2705981, 0.2705981, 0.6532815, 0.6532815],
+        "scale": [1.0, 2.0, 0.5]
+    }],
+    "meshes": [{"primitives": [{"attributes": {"POSITION": 0}}]}],
+    "accessors": [{
+        "bufferView": 0,
+        "componentType": 5126,
+        "count": 3,
+        "type": "VEC3",
+        "min": [0.0, 0.0, 0.0],
+        "max": [1.0, 2.0, 3.0]
+    }],
+    "bufferViews": [{"buffer": 0, "byteLength": 36}],
+    "buffers": [{
+        "byteLength": 36,
+        "uri": "data:application/octet-stream;base64,AACAPwAAAAAAAAAAAAAAAAAAAEAAAAAAAAAAAAAAAAAAAEBA"
+    }]
+}
+)";
+
+        bool verifyRootTransform() {
+            QTemporaryDir dir;
+            QString path = dir.filePath("root-transform.gltf");
+
+            QFile file(path);
+            if (!dir.isValid() || !file.open(QIODevice::WriteOnly) || file.write(ROOT_TRANSFORM_GLTF) < 0) {
+                qCritical().noquote() << "Failed to write" << path;
+                return false;
+            }
+            file.close();
+
+            //The reference - Assimp's own root transform applied to Assimp's own vertices
+            Assimp::Importer importer;
+            const aiScene *scene = importer.ReadFile(path.toLatin1().constData(), 0);
+            if (!scene || !scene->mRootNode || scene->mRootNode->mNumMeshes != 1) {
+                qCritical().noquote() << "Assimp failed to import the root transform model:" << importer.GetErrorString();
+                return false;
+            }
+
+            const aiMatrix4x4 &rootTransform = scene->mRootNode->mTransformation;
+            if (rootTransform.a4 == 0.0f && rootTransform.b4 == 0.0f && rootTransform.c4 == 0.0f) {
+                qCritical().noquote() << "The root transform model imported without a translation - the check would prove nothing";
+                return false;
+            }
+
+            const aiMesh *referenceMesh = scene->mMeshes[scene->mRootNode->mMeshes[0]];
+
+            QVector<WS2Common::Resource::ResourceMesh*> meshes;
+            try {
+                meshes = WS2Common::Model::ModelLoader::loadModel(file);
+            } catch (const WS2Common::Exception::ModelLoadingException &e) {
+                qCritical().noquote() << "ModelLoader failed to load the root transform model:" << e.getMessage();
+                return false;
+            }
+
+            bool success = true;
+            if (meshes.size() != 1 || meshes.first()->getMeshSegments().size() != 1) {
+                qCritical().noquote() << "Expected 1 mesh with 1 segment, got" << meshes.size() << "meshes";
+                success = false;
+            } else {
+                const QVector<WS2Common::Model::Vertex> &vertices = meshes.first()->getMeshSegments().first()->getVertices();
+
+                if ((unsigned int) vertices.size() != referenceMesh->mNumVertices) {
+                    qCritical().noquote() << "Expected" << referenceMesh->mNumVertices << "vertices, got" << vertices.size();
+                    success = false;
+                } else {
+                    for (int i = 0; i < vertices.size(); i++) {
+                        aiVector3D expected = rootTransform * referenceMesh->mVertices[i];
+                        const glm::vec3 &actual = vertices.at(i).position;
+
+                        if (std::fabs(expected.x - actual.x) > 1e-4f ||
+                                std::fabs(expected.y - actual.y) > 1e-4f ||
+                                std::fabs(expected.z - actual.z) > 1e-4f) {
+                            qCritical().noquote().nospace() << "Vertex " << i << " is (" << actual.x << ", " <<
+                                actual.y << ", " << actual.z << "), expected (" << expected.x << ", " << expected.y <<
+                                ", " << expected.z << ")";
+                            success = false;
+                        }
+                    }
+                }
+            }
+
+            qDeleteAll(meshes);
+            return success;
+        }
+
+        /**
+         * @brief Hand picked literals that exercise every way out of the fast path in parseFloat, and the edges of it
+         */
+        static const char *const EDGE_CASE_FLOATS[] = {
+            //Zeros and signs
+            "0", "-0", "+0", "0.0", "-0.0", "+0.0", "0e0", "-0e5", "+1", "+1.5", "-1.5", "--1", "+-1", "-", "+",
+
+            //Things only Qt decides on
+            "1.", ".5", "-.5", "007", "-007.5", "00", "", " 1", "1 ", "1,5", "0x10", "1e", "1e+", "1e-", "1e5x",
+            "1e0000", "1e00022", "1e-0022", "1e99999",
+
+            //Mantissas around 2^53 and 2^64, and too many significant digits
+            "9007199254740991", "9007199254740992", "9007199254740993", "9007199254740994",
+            "900719925474099.3", "18446744073709551615", "18446744073709551616", "1234567890123456789",
+            "12345678901234567890", "123456789012345678901234567890", "0.1234567890123456789012345",
+            "1.00000000000000000000000000001", "16777216", "16777217", "16777216.5", "33554435", "0.1", "0.2", "0.3",
+
+            //Exponents around the exactly representable powers of 10
+            "1e22", "1e-22", "1e23", "1e-23", "9.999999e22", "1.5e-22", "1.5e-23", "123.456e20", "123.456e-25",
+            "4e21", "4e-21", "4e25", "4e-25",
+
+            //The edges of float
+            "3.4028234e38", "3.40282346638528859811704183484516925440e+38", "3.4028235e38", "3.4028236e38", "1e38",
+            "1e39", "-1e39", "1.17549435e-38", "1.1754942e-38", "1e-40", "1.4e-45", "1.401298464e-45", "7e-46",
+            "7.1e-46", "1e-46", "1e-50", "4.9406564584124654e-324", "2.2250738585072014e-308",
+            "1.7976931348623157e308", "1e309", "-1e309",
+
+            //Infinity and NaN spellings
+            "inf", "-inf", "+inf", "INF", "Inf", "infinity", "-infinity", "nan", "-nan", "+nan", "NaN", "NAN", "nan1"
+        };
+
+        /**
+         * @brief Parses a literal both ways, and logs it if they differ
+         *
+         * @return Whether both parsed identically
+         */
+        static bool compareParseFloat(const QStringRef &literal) {
+            bool expectedOk;
+            bool actualOk;
+            float expected = literal.toFloat(&expectedOk);
+            float actual = WS2Common::SerializeUtils::parseFloat(literal, &actualOk);
+
+            quint32 expectedBits;
+            quint32 actualBits;
+            std::memcpy(&expectedBits, &expected, sizeof(float));
+            std::memcpy(&actualBits, &actual, sizeof(float));
+
+            //Any NaN is as good as any other
+            bool sameValue = expectedBits == actualBits || (std::isnan(expected) && std::isnan(actual));
+            if (sameValue && expectedOk == actualOk) return true;
+
+            qCritical().noquote() << QString("\"%1\" parsed to %2 (0x%3, ok %4), expected %5 (0x%6, ok %7)")
+                .arg(literal.toString())
+                .arg((double) actual, 0, 'g', 9)
+                .arg(actualBits, 8, 16, QChar('0'))
+                .arg(actualOk ? "true" : "false")
+                .arg((double) expected, 0, 'g', 9)
+                .arg(expectedBits, 8, 16, QChar('0'))
+                .arg(expectedOk ? "true" : "false");
+            return false;
+        }
+
+        /**
+         * @brief Compares every attribute value and text element in a config
+         *
+         * @return The number of literals that differed
+         */
+        static int compareConfigFloats(const QByteArray &config, int &literalCount) {
+            int failures = 0;
+
+            QXmlStreamReader xml(config);
+            while (!xml.atEnd()) {
+                xml.readNext();
+
+                if (xml.isStartElement()) {
+                    foreach(const QXmlStreamAttribute &attr, xml.attributes()) {
+                        if (!compareParseFloat(attr.value())) failures++;
+                        literalCount++;
+                    }
+                } else if (xml.isCharacters() && !xml.isWhitespace()) {
+                    if (!compareParseFloat(xml.text())) failures++;
+                    literalCount++;
+                }
+            }
+
+            if (xml.hasError()) {
+                qCritical().noquote() << "Failed to read config:" << xml.errorString();
+                failures++;
+            }
+
+            return failures;
+        }
+
+        /**
+         * @brief Generates a random decimal literal - A sign, 1 to 25 digits with an optional decimal point, and an
+         *        optional exponent
+         */
+        static QString randomFloatLiteral(std::mt19937 &randGen) {
+            QString literal;
+
+            quint32 sign = randGen() % 3;
+            if (sign == 1) literal += '-';
+            else if (sign == 2) literal += '+';
+
+            int digitCount = 1 + randGen() % 25;
+            int pointPosition = randGen() % (digitCount + 1); //digitCount means no point
+            for (int i = 0; i < digitCount; i++) {
+                if (i == pointPosition && i > 0) literal += '.';
+                literal += QChar('0' + randGen() % 10);
+            }
+
+            if (randGen() % 2 == 0) {
+                literal += randGen() % 2 == 0 ? 'e' : 'E';
+                int exponent = (int) (randGen() % 81) - 40;
+                literal += QString::number(exponent);
+            }
+
+            return literal;
+        }
+
+        bool verifyFloats(const QString &configDirectory) {
+            int failures = 0;
+            int literalCount = 0;
+
+            for (const char *literal : EDGE_CASE_FLOATS) {
+                QString str = QString::fromLatin1(literal);
+                if (!compareParseFloat(QStringRef(&str))) failures++;
+                literalCount++;
+            }
+
+            //Corpus configs
+            QDirIterator it(configDirectory, QStringList() << "*.xml", QDir::Files, QDirIterator::Subdirectories);
+            int configCount = 0;
+            while (it.hasNext()) {
+                QString configPath = it.next();
+                QFile file(configPath);
+                if (!file.open(QIODevice::ReadOnly)) {
+                    qCritical().noquote() << "Failed to read" << configPath << "-" << file.errorString();
+                    failures++;
+                    continue;
+                }
+
+                failures += compareConfigFloats(file.readAll(), literalCount);
+                configCount++;
+            }
+
+            if (configCount == 0) {
+                qCritical().noquote() << "No XML configs found in" << configDirectory;
+                failures++;
+            }
+
+            //A generated config, for plenty of the numbers QString::number writes
+            failures += compareConfigFloats(BenchmarkStage::createSyntheticConfig(2000, 1), literalCount);
+
+            //Random literals, and random float bit patterns (Including denormals, inf and nan) printed by Qt
+            std::mt19937 randGen(1);
+            for (int i = 0; i < 200000; i++) {
+                QString literal = randomFloatLiteral(randGen);
+                if (!compareParseFloat(QStringRef(&literal))) failures++;
+
+                quint32 bits = randGen();
+                float value;
+                std::memcpy(&value, &bits, sizeof(float));
+                QString printed = QString::number((double) value, 'g', 1 + randGen() % 17);
+                if (!compareParseFloat(QStringRef(&printed))) failures++;
+
+                literalCount += 2;
+            }
+
+            qInfo().noquote() << "Compared" << literalCount << "literals from" << configCount << "configs," <<
+                failures << "mismatch(es)";
+
+            return failures == 0;
+        }
+    }
+}
@@ -0,0 +1,469 @@
+#include "ws2lzbench/Benchmark.hpp"
+#include "ws2lzbench/BenchmarkStage.hpp"
+#include "ws2lzbench/GoldenCorpus.hpp"
+#include "ws2lzbench/Verification.hpp"
+#include "ws2common/MessageHandler.hpp"
+#include "ws2common/config/XMLConfigParser.hpp"
+#include "ws2common/SerializeUtils.hpp"
+#include "ws2common/StageSnapshot.hpp"
+#include "ws2common/exception/ModelLoadingException.hpp"
+#include "ws2lz/SMB2LzExporter.hpp"
+#include "ws2lz/TriangleIntersectionGrid.hpp"
+#include "ws2lz/LZCompressor.hpp"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QBuffer>
+#include <QDataStream>
+#include <QXmlStreamWriter>
+#include <QXmlStreamReader>
+#include <QDebug>
+
+/**
+ * @brief When true, info and debug messages (Such as the exporter's progress output) are dropped
+ */
+static bool quietLibraryOutput = false;
+
+/**
+ * @brief When true, warnings are dropped too (Such as the one XML node serialization prints for every node)
+ */
+static bool quietLibraryWarnings = false;
+
+static void benchMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
+    if (quietLibraryOutput && (type == QtInfoMsg || type == QtDebugMsg)) return;
+    if (quietLibraryWarnings && type == QtWarningMsg) return;
+    WS2Common::messageHandler(type, context, msg);
+}
+
+/**
+ * @brief Parses a comma separated list of unsigned integers, such as "1000,10000,100000"
+ *
+ * @param str The string to parse
+ * @param ok Set to false if any value could not be parsed
+ *
+ * @return The parsed values
+ */
+static QVector<unsigned int> parseUIntList(const QString &str, bool &ok) {
+    QVector<unsigned int> values;
+    ok = true;
+
+    foreach(const QString &part, str.split(',', QString::SkipEmptyParts)) {
+        bool partOk;
+        values.append(part.trimmed().toUInt(&partOk));
+        if (!partOk) ok = false;
+    }
+
+    if (values.isEmpty()) ok = false;
+    return values;
+}
+
+/**
+ * @brief Benchmarks saving and loading a stage's scene graph as XML and as a binary snapshot, and prints the results
+ *
+ * The XML benchmarks use the same node serialization as the editor's drag and drop. The cached XML save moves one
+ * node before each run, like saving after a small edit.
+ *
+ * @param bench The stage to benchmark
+ * @param warmupCount Number of untimed runs before timing
+ * @param repetitions Number of timed runs
+ */
+static void runSnapshotBenchmarks(WS2LzBench::BenchmarkStage &bench, unsigned int warmupCount, unsigned int repetitions) {
+    using namespace WS2LzBench;
+
+    const WS2Common::Stage &stage = *bench.getStage();
+
+    quietLibraryOutput = true;
+    quietLibraryWarnings = true;
+
+    QByteArray xml;
+    Benchmark xmlSaveBench("SceneNode::serializeXml");
+    xmlSaveBench.run(warmupCount, repetitions, [&stage, &xml]() {
+        xml.clear();
+        QXmlStreamWriter writer(&xml);
+        writer.writeStartDocument();
+        stage.getRootNode()->serializeXml(writer);
+        writer.writeEndDocument();
+    });
+
+    //Fill the cache, then move one node before each timed save so only it and its ancestors are serialized again
+    WS2Common::Scene::SceneNode *root = bench.getStage()->getRootNode();
+    WS2Common::Scene::SceneNode *movedNode = root;
+    while (movedNode->getChildCount() > 0) movedNode = movedNode->getChildByIndex(0);
+
+    bool cachedXmlMatches = xml.contains(root->serializeXmlCached());
+
+    const glm::vec3 movedPosition = movedNode->getPosition();
+    float movedOffset = 0.0f;
+    QByteArray cachedXml;
+    Benchmark xmlCachedSaveBench("SceneNode::serializeXmlCached (1 node moved)");
+    xmlCachedSaveBench.run(warmupCount, repetitions, [movedNode, &movedPosition, &movedOffset]() {
+        movedOffset += 1.0f;
+        movedNode->setPosition(movedPosition + glm::vec3(movedOffset, 0.0f, 0.0f));
+    }, [root, &cachedXml]() {
+        cachedXml = root->serializeXmlCached();
+    }, nullptr);
+
+    movedNode->setPosition(movedPosition);
+
+    quietLibraryWarnings = false;
+
+    Benchmark xmlLoadBench("SerializeUtils::deserializeNodeFromXml");
+    xmlLoadBench.run(warmupCount, repetitions, [&xml]() {
+        QXmlStreamReader reader(xml);
+        while (!reader.atEnd() && !reader.isStartElement()) reader.readNext();
+        delete WS2Common::SerializeUtils::deserializeNodeFromXml(reader);
+    });
+
+    QByteArray snapshot;
+    Benchmark snapshotSaveBench("StageSnapshot::write");
+    snapshotSaveBench.run(warmupCount, repetitions, [&stage, &snapshot]() {
+        snapshot.clear();
+        QBuffer buf(&snapshot);
+        buf.open(QIODevice::WriteOnly);
+        WS2Common::StageSnapshot::write(buf, stage);
+    });
+
+    Benchmark snapshotLoadBench("StageSnapshot::read");
+    snapshotLoadBench.run(warmupCount, repetitions, [&snapshot]() {
+        QBuffer buf(&snapshot);
+        buf.open(QIODevice::ReadOnly);
+        delete WS2Common::StageSnapshot::read(buf);
+    });
+
+    quietLibraryOutput = false;
+
+    double xmlMegabytes = xml.size() / (1024.0 * 1024.0);
+    double snapshotMegabytes = snapshot.size() / (1024.0 * 1024.0);
+    qInfo().noquote() << "   " << xmlSaveBench.toString(xmlMegabytes, "MB");
+    qInfo().noquote() << "   " << xmlCachedSaveBench.toString(xmlMegabytes, "MB");
+    if (!cachedXmlMatches) qWarning().noquote() << "    SceneNode::serializeXmlCached doesn't match SceneNode::serializeXml";
+    qInfo().noquote() << "   " << xmlLoadBench.toString(xmlMegabytes, "MB");
+    qInfo().noquote() << "   " << snapshotSaveBench.toString(snapshotMegabytes, "MB");
+    qInfo().noquote() << "   " << snapshotLoadBench.toString(snapshotMegabytes, "MB");
+    qInfo().noquote().nospace() << "    XML size " << xml.size() << " bytes, snapshot size " << snapshot.size() << " bytes";
+}
+
+/**
+ * @brief Benchmarks the collision grid, full export and compression of a stage, and prints the results
+ *
+ * @param bench The stage to benchmark
+ * @param warmupCount Number of untimed runs before timing
+ * @param repetitions Number of timed runs
+ */
+static void runStageBenchmarks(WS2LzBench::BenchmarkStage &bench, unsigned int warmupCount, unsigned int repetitions) {
+    using namespace WS2LzBench;
+
+    QVector<BenchmarkStage::CollisionData> collisionData = bench.getCollisionData();
+    unsigned int triangleCount = 0;
+    foreach(const BenchmarkStage::CollisionData &data, collisionData) triangleCount += data.indices.size() / 3;
+
+    qInfo().noquote() << "Stage:" << bench.getName();
+    qInfo().noquote().nospace() << "    " << triangleCount << " collision triangles in " << collisionData.size() << " item groups";
+
+    quietLibraryOutput = true;
+
+    //TriangleIntersectionGrid on its own, single threaded
+    Benchmark gridBench("TriangleIntersectionGrid");
+    gridBench.run(warmupCount, repetitions, [&collisionData]() {
+        for (int i = 0; i < collisionData.size(); i++) {
+            WS2Lz::TriangleIntersectionGrid intGrid(
+                    collisionData[i].vertices,
+                    collisionData[i].indices,
+                    collisionData[i].group->getCollisionGrid()
+                    );
+        }
+    });
+
+    //Full export - A new exporter is needed each time as it holds state from the previous export
+    QByteArray rawLz;
+    Benchmark exportBench("SMB2LzExporter::generate");
+    exportBench.run(warmupCount, repetitions, [&bench, &rawLz]() {
+        QBuffer buf;
+        buf.open(QIODevice::ReadWrite);
+        QDataStream dStream(&buf);
+
+        WS2Lz::SMB2LzExporter exporter;
+        exporter.setModels(bench.getModels());
+        exporter.generate(dStream, *bench.getStage());
+
+        rawLz = buf.data();
+    });
+
+    Benchmark compressBench("LZCompressor::compress");
+    compressBench.run(warmupCount, repetitions, [&rawLz]() {
+        WS2Lz::LZCompressor compressor;
+        compressor.compress(rawLz);
+    });
+
+    quietLibraryOutput = false;
+
+    double rawMegabytes = rawLz.size() / (1024.0 * 1024.0);
+    qInfo().noquote() << "   " << gridBench.toString(triangleCount, "tris");
+    qInfo().noquote() << "   " << exportBench.toString(triangleCount, "tris");
+    qInfo().noquote() << "   " << compressBench.toString(rawMegabytes, "MB");
+    if (exportBench.getMean() > 0.0) {
+        qInfo().noquote().nospace() << "    Raw LZ size " << rawLz.size() << " bytes, exported at " <<
+            QString::number(rawMegabytes / exportBench.getMean(), 'f', 2) << " MB/s";
+    }
+
+    runSnapshotBenchmarks(bench, warmupCount, repetitions);
+}
+
+/**
+ * @brief Benchmarks parsing, freeing and validating an XML config, and prints the results
+ *
+ * The config is already in memory, so this times the parser rather than the disk. Parsing and freeing the stage are
+ * timed separately, with and without pooled allocation.
+ *
+ * @param name The name to print the results under
+ * @param config The XML config
+ * @param relativeRoot The directory the config resides in
+ * @param warmupCount Number of untimed runs before timing
+ * @param repetitions Number of timed runs
+ */
+static void runConfigParseBenchmark(
+        const QString &name,
+        QByteArray &config,
+        const QDir &relativeRoot,
+        unsigned int warmupCount,
+        unsigned int repetitions
+        ) {
+    using namespace WS2LzBench;
+    using WS2Common::Config::XMLConfigParser;
+
+    quietLibraryOutput = true;
+
+    WS2Common::Stage *stage = nullptr;
+    auto parse = [&config, &relativeRoot, &stage]() {
+        QBuffer buf(&config);
+        buf.open(QIODevice::ReadOnly);
+
+        XMLConfigParser parser;
+        stage = parser.parseStage(buf, relativeRoot);
+    };
+    auto freeStage = [&stage]() {
+        delete stage;
+        stage = nullptr;
+    };
+
+    bool wasParallel = XMLConfigParser::isParallelParsingEnabled();
+    bool wasPooled = XMLConfigParser::isPooledAllocationEnabled();
+
+    XMLConfigParser::setParallelParsingEnabled(false);
+    XMLConfigParser::setPooledAllocationEnabled(false);
+    Benchmark parseBench("XMLConfigParser::parseStage");
+    parseBench.run(warmupCount, repetitions, nullptr, parse, freeStage);
+    Benchmark freeBench("Stage::~Stage");
+    freeBench.run(warmupCount, repetitions, parse, freeStage, nullptr);
+
+    XMLConfigParser::setPooledAllocationEnabled(true);
+    Benchmark pooledParseBench("XMLConfigParser::parseStage (Pooled)");
+    pooledParseBench.run(warmupCount, repetitions, nullptr, parse, freeStage);
+    Benchmark pooledFreeBench("Stage::~Stage (Pooled)");
+    pooledFreeBench.run(warmupCount, repetitions, parse, freeStage, nullptr);
+
+    XMLConfigParser::setPooledAllocationEnabled(false);
+    XMLConfigParser::setParallelParsingEnabled(true);
+    Benchmark parallelParseBench("XMLConfigParser::parseStage (Parallel)");
+    parallelParseBench.run(warmupCount, repetitions, nullptr, parse, freeStage);
+
+    XMLConfigParser::setParallelParsingEnabled(wasParallel);
+    XMLConfigParser::setPooledAllocationEnabled(wasPooled);
+
+    Benchmark validateBench("XMLConfigParser::validateStage");
+    validateBench.run(warmupCount, repetitions, [&config, &relativeRoot]() {
+        QBuffer buf(&config);
+        buf.open(QIODevice::ReadOnly);
+
+        XMLConfigParser::validateStage(buf, relativeRoot);
+    });
+
+    quietLibraryOutput = false;
+
+    double megabytes = config.size() / (1024.0 * 1024.0);
+    qInfo().noquote() << "Config:" << name;
+    qInfo().noquote() << "   " << parseBench.toString(megabytes, "MB");
+    qInfo().noquote() << "   " << freeBench.toString();
+    qInfo().noquote() << "   " << pooledParseBench.toString(megabytes, "MB");
+    qInfo().noquote() << "   " << pooledFreeBench.toString();
+    qInfo().noquote() << "   " << parallelParseBench.toString(megabytes, "MB");
+    qInfo().noquote() << "   " << validateBench.toString(megabytes, "MB");
+}
+
+/**
+ * @brief Benchmarks parsing an XML config file, and prints the results
+ *
+ * @param configPath The path to the XML config
+ * @param warmupCount Number of untimed runs before timing
+ * @param repetitions Number of timed runs
+ */
+static void runConfigParseBenchmark(const QString &configPath, unsigned int warmupCount, unsigned int repetitions) {
+    QFile file(configPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical().noquote() << "Failed to read" << configPath << "-" << file.errorString();
+        return;
+    }
+    QByteArray config = file.readAll();
+
+    runConfigParseBenchmark(configPath, config, QFileInfo(configPath).dir(), warmupCount, repetitions);
+}
+
+int main(int argc, char *argv[]) {
+    qInstallMessageHandler(benchMessageHandler);
+
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ws2lzbench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks collision optimization, LZ export and compression with synthetic and real stages");
+    parser.addHelpOption();
+
+    parser.addOptions({
+            {{"t", "triangles"}, "Comma separated list of total collision triangle counts for synthetic stages.", "counts", "10000"},
+            {"grid", "Comma separated list of collision grid sizes (tiles per axis) for synthetic stages.", "sizes", "16"},
+            {"groups", "Comma separated list of item group counts for synthetic stages.", "counts", "1"},
+            {"bananas", "Comma separated list of banana counts for synthetic stages.", "counts", "0"},
+            {"seed", "Random seed used for synthetic stage generation.", "seed", "0"},
+            {"config-nodes", "Comma separated list of object counts for synthetic XML configs. Benchmarks parsing and freeing each config, instead of exporting stages.", "counts"},
+            {{"d", "corpus"}, "Directory to search recursively for XML stage configs to benchmark (Parsing as well as exporting), instead of synthetic stages.", "directory"},
+            {{"r", "repetitions"}, "Number of timed repetitions per benchmark.", "count", "5"},
+            {{"w", "warmup"}, "Number of untimed warmup runs per benchmark.", "count", "1"},
+            {"golden", "Export every stage in a golden corpus JSON file and compare the output against its recorded hashes, instead of benchmarking.", "corpus file"},
+            {"update-golden", "With --golden, record new hashes in the corpus file instead of comparing against them. Only use this with known good output!"},
+            {"verify-root-transform", "Check that models with a root node transform are loaded with vertices matching Assimp's, instead of benchmarking."},
+            {"verify-floats", "Check that the XML float parser gives bit for bit the same results as QString::toFloat for every number in the XML configs in a directory, edge cases and random numbers, instead of benchmarking.", "directory"},
+            {{"v", "verbose"}, "Enable verbose logging"}
+            });
+
+    parser.process(app);
+
+    WS2Common::setDebugLoggingEnabled(parser.isSet("v"));
+
+    bool repetitionsOk, warmupOk;
+    unsigned int repetitions = parser.value("r").toUInt(&repetitionsOk);
+    unsigned int warmupCount = parser.value("w").toUInt(&warmupOk);
+    if (!repetitionsOk || !warmupOk || repetitions == 0) {
+        qCritical().noquote() << "Invalid repetition or warmup count. Use --help for more info.";
+        return EXIT_FAILURE;
+    }
+
+    if (parser.isSet("verify-root-transform")) {
+        bool success = WS2LzBench::Verification::verifyRootTransform();
+        qInfo().noquote() << (success ? "Root transform check passed" : "Root transform check failed");
+        return success ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (parser.isSet("verify-floats")) {
+        bool success = WS2LzBench::Verification::verifyFloats(parser.value("verify-floats"));
+        qInfo().noquote() << (success ? "Float parsing check passed" : "Float parsing check failed");
+        return success ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (parser.isSet("golden")) {
+        //Regression check against golden output rather than benchmarking
+        WS2LzBench::GoldenCorpus corpus;
+        QString error;
+        if (!corpus.load(parser.value("golden"), error)) {
+            qCritical().noquote() << error;
+            return EXIT_FAILURE;
+        }
+
+        if (parser.isSet("update-golden")) {
+            return corpus.update() ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        int failures = corpus.verify();
+        if (failures > 0) {
+            qCritical().noquote() << failures << "golden output case(s) failed";
+            return EXIT_FAILURE;
+        }
+
+        qInfo().noquote() << "All golden output cases passed";
+        return EXIT_SUCCESS;
+    }
+
+    if (parser.isSet("config-nodes")) {
+        //Benchmark parsing synthetic configs
+        bool nodesOk, seedOk;
+        QVector<unsigned int> nodeCounts = parseUIntList(parser.value("config-nodes"), nodesOk);
+        quint32 seed = parser.value("seed").toUInt(&seedOk);
+
+        if (!nodesOk || !seedOk) {
+            qCritical().noquote() << "Invalid synthetic config parameters. Use --help for more info.";
+            return EXIT_FAILURE;
+        }
+
+        foreach(unsigned int nodeCount, nodeCounts) {
+            QByteArray config = WS2LzBench::BenchmarkStage::createSyntheticConfig(nodeCount, seed);
+            QString name = QString("synthetic config [nodes=%1]").arg(nodeCount);
+            runConfigParseBenchmark(name, config, QDir::current(), warmupCount, repetitions);
+        }
+    } else if (parser.isSet("d")) {
+        //Benchmark real stages
+        QDirIterator it(parser.value("d"), QStringList() << "*.xml", QDir::Files, QDirIterator::Subdirectories);
+        QStringList configPaths;
+        while (it.hasNext()) configPaths.append(it.next());
+        configPaths.sort();
+
+        if (configPaths.isEmpty()) {
+            qCritical().noquote() << "No XML configs found in" << parser.value("d");
+            return EXIT_FAILURE;
+        }
+
+        foreach(const QString &configPath, configPaths) {
+            runConfigParseBenchmark(configPath, warmupCount, repetitions);
+
+            WS2LzBench::BenchmarkStage *bench;
+
+            try {
+                quietLibraryOutput = true;
+                bench = WS2LzBench::BenchmarkStage::loadFromConfig(configPath);
+                quietLibraryOutput = false;
+            } catch (const WS2Common::Exception::ModelLoadingException &e) {
+                quietLibraryOutput = false;
+                qCritical().noquote() << "Skipping" << configPath << "- error while loading model:" << e.getMessage();
+                continue;
+            }
+
+            runStageBenchmarks(*bench, warmupCount, repetitions);
+            delete bench;
+        }
+    } else {
+        //Benchmark synthetic stages - every combination of the parameters given
+        bool trianglesOk, gridOk, groupsOk, bananasOk, seedOk;
+        QVector<unsigned int> triangleCounts = parseUIntList(parser.value("t"), trianglesOk);
+        QVector<unsigned int> gridSizes = parseUIntList(parser.value("grid"), gridOk);
+        QVector<unsigned int> groupCounts = parseUIntList(parser.value("groups"), groupsOk);
+        QVector<unsigned int> bananaCounts = parseUIntList(parser.value("bananas"), bananasOk);
+        quint32 seed = parser.value("seed").toUInt(&seedOk);
+
+        if (!trianglesOk || !gridOk || !groupsOk || !bananasOk || !seedOk) {
+            qCritical().noquote() << "Invalid synthetic stage parameters. Use --help for more info.";
+            return EXIT_FAILURE;
+        }
+
+        foreach(unsigned int triangleCount, triangleCounts) {
+            foreach(unsigned int gridSize, gridSizes) {
+                foreach(unsigned int groupCount, groupCounts) {
+                    foreach(unsigned int bananaCount, bananaCounts) {
+                        WS2LzBench::SyntheticStageParams params;
+                        params.triangleCount = triangleCount;
+                        params.gridSize = gridSize;
+                        params.itemGroupCount = groupCount;
+                        params.bananaCount = bananaCount;
+                        params.seed = seed;
+
+                        WS2LzBench::BenchmarkStage *bench = WS2LzBench::BenchmarkStage::createSynthetic(params);
+                        runStageBenchmarks(*bench, warmupCount, repetitions);
+                        delete bench;
+                    }
+                }
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
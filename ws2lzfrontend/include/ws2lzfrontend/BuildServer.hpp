@@ -0,0 +1,136 @@
+/**
+ * @file
+ * @brief Header for the BuildServer class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2LZFRONTEND_BUILDSERVER_HPP
+#define SMBLEVELWORKSHOP2_WS2LZFRONTEND_BUILDSERVER_HPP
+
+#include "ws2lzfrontend/ModelCache.hpp"
+#include "ws2lzfrontend/StageBuilder.hpp"
+#include "ws2lz/CollisionCache.hpp"
+#include <QObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QThreadPool>
+#include <QPointer>
+#include <QJsonObject>
+#include <QHash>
+
+namespace WS2LzFrontend {
+
+    /**
+     * @brief An export job, as sent to a BuildServer
+     */
+    struct BuildJob {
+        /**
+         * @brief Absolute path to the XML config to export
+         */
+        QString configPath;
+
+        ExportSettings settings;
+
+        QJsonObject toJson() const;
+
+        /**
+         * @brief Reads a job from JSON
+         *
+         * @param json The JSON to read
+         * @param job The job to read into
+         * @param error Set to a description of the problem if reading fails
+         *
+         * @return Whether the job was read successfully
+         */
+        static bool fromJson(const QJsonObject &json, BuildJob &job, QString &error);
+    };
+
+    /**
+     * @brief Accepts export jobs over a local socket and runs them, keeping models and optimized collision cached
+     *        between jobs
+     *
+     * The protocol is one job per connection: the client sends a job as a single line of JSON (See BuildJob::toJson),
+     * and the server replies with a single line of JSON once the job is done, containing "status" ("ok" or "failed"),
+     * "error" if it failed, "wallSeconds" and "timings" (Per step timings, in the same format as ws2lzfrontend
+     * --profile writes).
+     *
+     * Each line a job logs is prefixed with its job ID, as jobs run at the same time.
+     */
+    class BuildServer : public QObject {
+        Q_OBJECT
+
+        protected:
+            QLocalServer server;
+
+            /**
+             * @brief Runs jobs - The number of threads bounds how many jobs run at once
+             */
+            QThreadPool workerPool;
+
+            ModelCache modelCache;
+
+            /**
+             * @brief The least recently used models are dropped after each job once the cache grows past this
+             */
+            qint64 maxModelCacheBytes;
+
+            WS2Lz::CollisionCache collisionCache;
+
+            quint64 nextJobId = 1;
+
+            /**
+             * @brief Sockets waiting for a job to finish, by job ID - A socket becomes null if the client disconnects
+             */
+            QHash<quint64, QPointer<QLocalSocket>> pendingJobs;
+
+        protected:
+            void startJob(QLocalSocket *socket, const QByteArray &request);
+            void sendResponse(QLocalSocket *socket, const QJsonObject &response);
+
+        protected slots:
+            void onNewConnection();
+
+            /**
+             * @brief Called on the server's thread by the worker running a job once it finishes
+             *
+             * @param jobId The ID of the job that finished
+             * @param response The JSON response to send back
+             */
+            void onJobFinished(quint64 jobId, QByteArray response);
+
+        public:
+            /**
+             * @brief Constructor for BuildServer
+             *
+             * @param maxConcurrentJobs The maximum number of jobs to run at once
+             * @param maxModelCacheBytes Roughly how much memory cached models may take up between jobs, in bytes
+             * @param parent The parent QObject
+             */
+            BuildServer(int maxConcurrentJobs, qint64 maxModelCacheBytes, QObject *parent = nullptr);
+
+            /**
+             * @brief Starts listening for jobs
+             *
+             * @param name The name of the local socket to listen on
+             *
+             * @return Whether the server started listening successfully
+             */
+            bool listen(const QString &name);
+
+            WS2Lz::CollisionCache& getCollisionCache();
+
+            /**
+             * @brief Sends a job to a running server and waits for it to finish
+             *
+             * @param name The name of the local socket the server listens on
+             * @param job The job to run
+             * @param response Set to the server's response
+             * @param error Set to a description of the problem if the job couldn't be submitted
+             *
+             * @return Whether the job was submitted and a response received (The job itself may still have failed)
+             */
+            static bool submitJob(const QString &name, const BuildJob &job, QJsonObject &response, QString &error);
+    };
+}
+
+#endif
+
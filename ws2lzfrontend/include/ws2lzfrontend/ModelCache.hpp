@@ -0,0 +1,137 @@
+/**
+ * @file
+ * @brief Header for the ModelCache class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2LZFRONTEND_MODELCACHE_HPP
+#define SMBLEVELWORKSHOP2_WS2LZFRONTEND_MODELCACHE_HPP
+
+#include "ws2common/resource/ResourceMesh.hpp"
+#include "ws2common/model/MeshRequirements.hpp"
+#include "ws2common/Profiler.hpp"
+#include <QSharedPointer>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+
+namespace WS2LzFrontend {
+
+    /**
+     * @brief Everything loaded from a single model file
+     */
+    struct LoadedModel {
+        /**
+         * @brief Meshes and textures loaded from the file - These are deleted along with the LoadedModel
+         */
+        QVector<WS2Common::Resource::AbstractResource*> resources;
+
+        /**
+         * @brief The meshes in the file
+         */
+        QVector<WS2Common::Resource::ResourceMesh*> meshes;
+
+        /**
+         * @brief What was loaded from the file - Meshes and attributes not required here were skipped
+         */
+        WS2Common::Model::MeshRequirements requirements;
+
+        QDateTime lastModified;
+        qint64 size = 0;
+
+        /**
+         * @brief Roughly how much memory the meshes take up, in bytes
+         */
+        qint64 byteSize = 0;
+
+        ~LoadedModel();
+    };
+
+    /**
+     * @brief Keeps loaded models in memory, and only reloads them when their file changes
+     *
+     * Models are shared - A model is kept alive until nothing is using it, even if it is reloaded or removed from the
+     * cache in the meantime.
+     *
+     * This is thread safe.
+     */
+    class ModelCache {
+        protected:
+            struct Entry {
+                QSharedPointer<const LoadedModel> model;
+
+                /**
+                 * @brief The value of useCounter when this model was last fetched
+                 */
+                quint64 lastUsed = 0;
+            };
+
+            QHash<QString, Entry> models; //Absolute file path, model
+            quint64 useCounter = 0;
+            QMutex mutex;
+
+        public:
+            /**
+             * @brief Gets a model, loading it if it isn't cached or its file has changed since it was loaded
+             *
+             * If the cached model skipped something that requirements needs, the model is reloaded with both the old
+             * and new requirements, so callers needing different meshes from the same file don't keep evicting each
+             * other.
+             *
+             * @param path The path to the model file
+             * @param profiler Records model loading time if set (Optional - may be nullptr)
+             * @param requirements Which meshes and vertex attributes are needed (Optional) - Everything is loaded if
+             *                     this is nullptr
+             *
+             * @return The loaded model
+             *
+             * @throws WS2Common::Exception::RuntimeException When the model fails to load
+             */
+            QSharedPointer<const LoadedModel> getModel(
+                    const QString &path,
+                    WS2Common::Profiler *profiler = nullptr,
+                    const WS2Common::Model::MeshRequirements *requirements = nullptr
+                    );
+
+            /**
+             * @brief Forces a model to be reloaded next time it is requested
+             *
+             * @param path The path to the model file
+             */
+            void invalidate(const QString &path);
+
+            /**
+             * @brief Removes all models from the cache except the ones given
+             *
+             * @param paths Paths to the models to keep
+             */
+            void retainOnly(const QStringList &paths);
+
+            /**
+             * @brief Removes the least recently fetched models until the rest take up at most maxBytes
+             *
+             * Models still in use elsewhere stay alive until they're released, but are no longer cached.
+             *
+             * @param maxBytes How much memory the cached models may take up, in bytes
+             */
+            void trimToSize(qint64 maxBytes);
+
+            /**
+             * @brief Removes all models from the cache
+             */
+            void clear();
+
+            /**
+             * @return The number of models cached
+             */
+            int getCount();
+
+            /**
+             * @return Roughly how much memory the cached models take up, in bytes
+             */
+            qint64 getByteSize();
+    };
+}
+
+#endif
+
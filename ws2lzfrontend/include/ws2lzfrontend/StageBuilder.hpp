@@ -0,0 +1,136 @@
+/**
+ * @file
+ * @brief Header for the StageBuilder class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2LZFRONTEND_STAGEBUILDER_HPP
+#define SMBLEVELWORKSHOP2_WS2LZFRONTEND_STAGEBUILDER_HPP
+
+#include "ws2lzfrontend/ModelCache.hpp"
+#include "ws2common/Stage.hpp"
+#include "ws2common/EnumGameVersion.hpp"
+#include "ws2common/Profiler.hpp"
+#include "ws2lz/CollisionCache.hpp"
+#include <QString>
+#include <QStringList>
+#include <QHash>
+
+namespace WS2LzFrontend {
+
+    /**
+     * @brief Where and how to export a stage
+     */
+    struct ExportSettings {
+        /**
+         * @brief Path to write an uncompressed LZ to, or empty to not write one
+         */
+        QString outputPath;
+
+        /**
+         * @brief Path to write a compressed LZ to, or empty to not write one
+         */
+        QString compressedOutputPath;
+
+        WS2Common::EnumGameVersion gameVersion = WS2Common::EnumGameVersion::SUPER_MONKEY_BALL_2;
+    };
+
+    /**
+     * @brief Parses a config, loads its models and exports it - keeping everything around so that only what changed
+     *        needs redoing next time
+     *
+     * Models are fetched from a ModelCache and optimized collision from an optional CollisionCache, both of which may
+     * be shared between builders.
+     */
+    class StageBuilder {
+        protected:
+            ModelCache &modelCache;
+
+            /**
+             * @brief Optional - may be nullptr
+             */
+            WS2Lz::CollisionCache *collisionCache;
+
+            /**
+             * @brief Records timings for each step if set (Optional - may be nullptr)
+             */
+            WS2Common::Profiler *profiler = nullptr;
+
+            QString configPath;
+            WS2Common::Stage *stage = nullptr;
+
+            /**
+             * @brief Models used by the stage, kept alive while the builder uses them
+             */
+            QVector<QSharedPointer<const LoadedModel>> loadedModels;
+            QHash<QString, WS2Common::Resource::ResourceMesh*> models; //name, mesh
+
+        public:
+            /**
+             * @brief Constructor for StageBuilder
+             *
+             * @param modelCache Where to fetch models from
+             * @param collisionCache Where to reuse optimized collision from (Optional - may be nullptr)
+             */
+            StageBuilder(ModelCache &modelCache, WS2Lz::CollisionCache *collisionCache = nullptr);
+            ~StageBuilder();
+
+            void setProfiler(WS2Common::Profiler *profiler);
+
+            /**
+             * @brief Reads and parses a config, replacing the current stage
+             *
+             * @param configPath Path to the XML config to parse
+             *
+             * @return Whether the config was read successfully
+             */
+            bool loadConfig(const QString &configPath);
+
+            /**
+             * @brief Fetches every model the stage uses from the model cache - Only models that changed since they
+             *        were last loaded are actually reloaded
+             *
+             * Model files are loaded concurrently on the global thread pool. Meshes are merged in the order the config
+             * lists the files, so when two files define a mesh with the same name, the last file listed wins.
+             *
+             * @return Whether all models loaded successfully
+             */
+            bool loadModels();
+
+            /**
+             * @brief Exports the stage and writes the output files
+             *
+             * @param settings Where and how to export
+             *
+             * @return Whether the stage was exported successfully
+             */
+            bool exportStage(const ExportSettings &settings);
+
+            /**
+             * @brief Convenience function to load a config, its models and export it
+             *
+             * @param configPath Path to the XML config to parse
+             * @param settings Where and how to export
+             *
+             * @return Whether every step succeeded
+             */
+            bool build(const QString &configPath, const ExportSettings &settings);
+
+            /**
+             * @return The path of the config last loaded
+             */
+            const QString& getConfigPath() const;
+
+            /**
+             * @return Local paths to every model file the current stage uses
+             */
+            QStringList getModelPaths() const;
+
+            /**
+             * @return The current stage, or nullptr if no config has been loaded yet
+             */
+            const WS2Common::Stage* getStage() const;
+    };
+}
+
+#endif
+
@@ -0,0 +1,106 @@
+/**
+ * @file
+ * @brief Header for the Watcher class
+ */
+
+#ifndef SMBLEVELWORKSHOP2_WS2LZFRONTEND_WATCHER_HPP
+#define SMBLEVELWORKSHOP2_WS2LZFRONTEND_WATCHER_HPP
+
+#include "ws2lzfrontend/StageBuilder.hpp"
+#include <QObject>
+#include <QFileSystemWatcher>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QSet>
+
+namespace WS2LzFrontend {
+
+    /**
+     * @brief Watches a config and its models, and re-exports whenever any of them change
+     *
+     * Only what changed is redone - Models are only reloaded if their file changed, the config is only reparsed if it
+     * changed, and item groups with unchanged collision reuse their optimized collision.
+     */
+    class Watcher : public QObject {
+        Q_OBJECT
+
+        protected:
+            /**
+             * @brief How long to wait after a change before rebuilding, so that a burst of changes (Such as an editor
+             *        saving several files) results in a single rebuild
+             */
+            static const int DEBOUNCE_MSECS = 200;
+
+            StageBuilder &builder;
+            ModelCache &modelCache;
+            QString configPath;
+            ExportSettings settings;
+
+            QFileSystemWatcher fileWatcher;
+            QTimer debounceTimer;
+
+            bool configChanged = false;
+            QSet<QString> changedModels;
+
+            /**
+             * @brief Started when the first change before a rebuild is noticed
+             */
+            QElapsedTimer latencyTimer;
+            unsigned int rebuildCount = 0;
+
+        protected:
+            /**
+             * @brief Watches the config and every model the stage currently uses (And the directories they're in)
+             */
+            void updateWatchedFiles();
+
+            void markChanged(const QString &path);
+
+        protected slots:
+            void onFileChanged(const QString &path);
+
+            /**
+             * @brief Checks for watched files that were replaced rather than modified - Many programs save by writing
+             *        a new file and renaming it over the old one, which stops the old file being watched
+             *
+             * @param path The directory that changed
+             */
+            void onDirectoryChanged(const QString &path);
+
+            void rebuild();
+
+        public:
+            /**
+             * @brief Constructor for Watcher
+             *
+             * @param builder The builder to rebuild with
+             * @param modelCache The model cache the builder uses
+             * @param configPath The XML config to watch and export
+             * @param settings Where and how to export
+             * @param parent The parent QObject
+             */
+            Watcher(
+                    StageBuilder &builder,
+                    ModelCache &modelCache,
+                    const QString &configPath,
+                    const ExportSettings &settings,
+                    QObject *parent = nullptr
+                    );
+
+            /**
+             * @brief Does an initial build, and starts watching for changes
+             */
+            void start();
+
+        signals:
+            /**
+             * @brief Emitted after each rebuild
+             *
+             * @param success Whether the rebuild succeeded
+             */
+            void rebuilt(bool success);
+    };
+}
+
+#endif
+
@@ -0,0 +1,228 @@
+#include "ws2lzfrontend/BuildServer.hpp"
+#include "ws2common/Profiler.hpp"
+#include "ws2common/MessageHandler.hpp"
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QElapsedTimer>
+#include <QRunnable>
+#include <QDebug>
+
+namespace WS2LzFrontend {
+    using namespace WS2Common;
+
+    namespace {
+        /**
+         * @brief Runs a single job on the server's worker pool
+         */
+        class JobTask : public QRunnable {
+            public:
+                BuildServer *server;
+                quint64 jobId;
+                BuildJob job;
+                ModelCache *modelCache;
+                WS2Lz::CollisionCache *collisionCache;
+
+                virtual void run() override {
+                    QElapsedTimer timer;
+                    timer.start();
+
+                    Profiler profiler;
+                    bool success;
+                    {
+                        //Jobs run at the same time, so tag each line of output with the job it came from
+                        MessagePrefixScope prefixScope(QString("[Job %1] ").arg(jobId));
+
+                        StageBuilder builder(*modelCache, collisionCache);
+                        builder.setProfiler(&profiler);
+                        success = builder.build(job.configPath, job.settings);
+                    }
+
+                    QJsonObject response;
+                    response["status"] = success ? "ok" : "failed";
+                    if (!success) response["error"] = "Export failed - see the server log for details";
+                    response["wallSeconds"] = timer.nsecsElapsed() / 1000000000.0;
+                    response["timings"] = QJsonDocument::fromJson(profiler.toJson(Profiler::EnumOutputFormat::JSON)).object().value("stages");
+
+                    qInfo().noquote().nospace() << "Job " << jobId << " (" << job.configPath << ") " <<
+                        (success ? "finished" : "failed") << " in " << timer.nsecsElapsed() / 1000000000.0f << "s";
+
+                    QMetaObject::invokeMethod(server, "onJobFinished", Qt::QueuedConnection,
+                            Q_ARG(quint64, jobId),
+                            Q_ARG(QByteArray, QJsonDocument(response).toJson(QJsonDocument::Compact)));
+                }
+        };
+    }
+
+    QJsonObject BuildJob::toJson() const {
+        QJsonObject json;
+        json["config"] = configPath;
+        if (!settings.outputPath.isEmpty()) json["output"] = settings.outputPath;
+        if (!settings.compressedOutputPath.isEmpty()) json["compressedOutput"] = settings.compressedOutputPath;
+
+        switch (settings.gameVersion) {
+            case EnumGameVersion::SUPER_MONKEY_BALL_1:
+                json["gameVersion"] = "1";
+                break;
+            case EnumGameVersion::SUPER_MONKEY_BALL_2:
+                json["gameVersion"] = "2";
+                break;
+            case EnumGameVersion::SUPER_MONKEY_BALL_DELUXE:
+                json["gameVersion"] = "deluxe";
+                break;
+        }
+
+        return json;
+    }
+
+    bool BuildJob::fromJson(const QJsonObject &json, BuildJob &job, QString &error) {
+        job.configPath = json.value("config").toString();
+        job.settings.outputPath = json.value("output").toString();
+        job.settings.compressedOutputPath = json.value("compressedOutput").toString();
+
+        if (job.configPath.isEmpty()) {
+            error = "No config specified";
+            return false;
+        }
+
+        if (job.settings.outputPath.isEmpty() && job.settings.compressedOutputPath.isEmpty()) {
+            error = "No output file specified";
+            return false;
+        }
+
+        QString gameVersion = json.value("gameVersion").toString("2");
+        if (gameVersion == "1") {
+            job.settings.gameVersion = EnumGameVersion::SUPER_MONKEY_BALL_1;
+        } else if (gameVersion == "2") {
+            job.settings.gameVersion = EnumGameVersion::SUPER_MONKEY_BALL_2;
+        } else if (gameVersion == "deluxe") {
+            job.settings.gameVersion = EnumGameVersion::SUPER_MONKEY_BALL_DELUXE;
+        } else {
+            error = "Invalid game version " + gameVersion;
+            return false;
+        }
+
+        return true;
+    }
+
+    BuildServer::BuildServer(int maxConcurrentJobs, qint64 maxModelCacheBytes, QObject *parent) :
+        QObject(parent),
+        maxModelCacheBytes(maxModelCacheBytes) {
+        workerPool.setMaxThreadCount(qMax(maxConcurrentJobs, 1));
+        connect(&server, &QLocalServer::newConnection, this, &BuildServer::onNewConnection);
+    }
+
+    bool BuildServer::listen(const QString &name) {
+        //Clean up after a server that didn't shut down cleanly
+        QLocalServer::removeServer(name);
+
+        if (!server.listen(name)) {
+            qCritical().noquote() << "Failed to listen on" << name << "-" << server.errorString();
+            return false;
+        }
+
+        qInfo().noquote().nospace() << "Listening for jobs on " << server.fullServerName() << " (Up to " <<
+            workerPool.maxThreadCount() << " at once)";
+        return true;
+    }
+
+    WS2Lz::CollisionCache& BuildServer::getCollisionCache() {
+        return collisionCache;
+    }
+
+    void BuildServer::onNewConnection() {
+        while (QLocalSocket *socket = server.nextPendingConnection()) {
+            connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
+            connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+                //One job per connection - ignore anything after the first line
+                if (socket->property("jobStarted").toBool() || !socket->canReadLine()) return;
+                socket->setProperty("jobStarted", true);
+
+                startJob(socket, socket->readLine());
+            });
+        }
+    }
+
+    void BuildServer::startJob(QLocalSocket *socket, const QByteArray &request) {
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(request, &parseError);
+        BuildJob job;
+        QString error;
+
+        if (!doc.isObject()) {
+            error = "Invalid job JSON - " + parseError.errorString();
+        } else {
+            BuildJob::fromJson(doc.object(), job, error);
+        }
+
+        if (!error.isEmpty()) {
+            QJsonObject response;
+            response["status"] = "failed";
+            response["error"] = error;
+            sendResponse(socket, response);
+            return;
+        }
+
+        quint64 jobId = nextJobId++;
+        pendingJobs[jobId] = socket;
+        qInfo().noquote().nospace() << "Job " << jobId << " (" << job.configPath << ") queued";
+
+        JobTask *task = new JobTask();
+        task->server = this;
+        task->jobId = jobId;
+        task->job = job;
+        task->modelCache = &modelCache;
+        task->collisionCache = &collisionCache;
+        workerPool.start(task);
+    }
+
+    void BuildServer::onJobFinished(quint64 jobId, QByteArray response) {
+        //Jobs hold on to the models they use, so this only drops models no running job needs from the cache
+        modelCache.trimToSize(maxModelCacheBytes);
+
+        QPointer<QLocalSocket> socket = pendingJobs.take(jobId);
+        if (socket.isNull()) return; //The client gave up waiting
+
+        socket->write(response);
+        socket->write("\n");
+        socket->flush();
+        socket->disconnectFromServer();
+    }
+
+    void BuildServer::sendResponse(QLocalSocket *socket, const QJsonObject &response) {
+        socket->write(QJsonDocument(response).toJson(QJsonDocument::Compact));
+        socket->write("\n");
+        socket->flush();
+        socket->disconnectFromServer();
+    }
+
+    bool BuildServer::submitJob(const QString &name, const BuildJob &job, QJsonObject &response, QString &error) {
+        QLocalSocket socket;
+        socket.connectToServer(name);
+        if (!socket.waitForConnected()) {
+            error = "Failed to connect to " + name + " - " + socket.errorString();
+            return false;
+        }
+
+        socket.write(QJsonDocument(job.toJson()).toJson(QJsonDocument::Compact));
+        socket.write("\n");
+        socket.flush();
+
+        //Jobs can take a while - wait for as long as it takes
+        while (!socket.canReadLine()) {
+            if (!socket.waitForReadyRead(-1)) {
+                error = "Lost connection to " + name + " - " + socket.errorString();
+                return false;
+            }
+        }
+
+        QJsonDocument doc = QJsonDocument::fromJson(socket.readLine());
+        if (!doc.isObject()) {
+            error = "Invalid response from " + name;
+            return false;
+        }
+
+        response = doc.object();
+        return true;
+    }
+}
+
@@ -0,0 +1,132 @@
+#include "ws2lzfrontend/ModelCache.hpp"
+#include "ws2common/model/ModelLoader.hpp"
+#include <QMutexLocker>
+#include <QFileInfo>
+#include <QFile>
+#include <QSet>
+#include <algorithm>
+
+namespace WS2LzFrontend {
+    using namespace WS2Common;
+
+    LoadedModel::~LoadedModel() {
+        //resources contains the meshes too
+        qDeleteAll(resources);
+    }
+
+    QSharedPointer<const LoadedModel> ModelCache::getModel(
+            const QString &path,
+            Profiler *profiler,
+            const Model::MeshRequirements *requirements
+            ) {
+        QFileInfo fileInfo(path);
+        QString absolutePath = fileInfo.absoluteFilePath();
+
+        Model::MeshRequirements loadRequirements = requirements != nullptr ?
+            *requirements :
+            Model::MeshRequirements::everything();
+
+        {
+            QMutexLocker locker(&mutex);
+
+            auto it = models.find(absolutePath);
+            QSharedPointer<const LoadedModel> cached = it != models.end() ? it->model : QSharedPointer<const LoadedModel>();
+            if (!cached.isNull() && cached->lastModified == fileInfo.lastModified() && cached->size == fileInfo.size()) {
+                if (cached->requirements.covers(loadRequirements)) {
+                    it->lastUsed = ++useCounter;
+                    return cached;
+                }
+
+                //Something new is needed from an unchanged file - keep loading what was already needed too
+                loadRequirements.merge(cached->requirements);
+            }
+        }
+
+        //Not cached, or out of date - load it without holding the lock so other models can be fetched meanwhile
+        Profiler::Scope scope(profiler, "Load model: " + fileInfo.fileName(), "model");
+
+        LoadedModel *model = new LoadedModel();
+        model->requirements = loadRequirements;
+        model->lastModified = fileInfo.lastModified();
+        model->size = fileInfo.size();
+
+        QFile file(absolutePath);
+        try {
+            model->meshes = Model::ModelLoader::loadModel(file, &model->resources, nullptr, &model->requirements);
+        } catch (...) {
+            delete model;
+            throw;
+        }
+
+        foreach(const Resource::ResourceMesh *mesh, model->meshes) {
+            foreach(const Model::MeshSegment *segment, mesh->getMeshSegments()) {
+                model->byteSize += segment->getVertices().size() * sizeof(Model::Vertex);
+                model->byteSize += segment->getIndices().size() * sizeof(unsigned int);
+            }
+        }
+
+        QSharedPointer<const LoadedModel> loaded(model);
+
+        QMutexLocker locker(&mutex);
+        Entry &entry = models[absolutePath];
+        entry.model = loaded;
+        entry.lastUsed = ++useCounter;
+        return loaded;
+    }
+
+    void ModelCache::invalidate(const QString &path) {
+        QMutexLocker locker(&mutex);
+        models.remove(QFileInfo(path).absoluteFilePath());
+    }
+
+    void ModelCache::retainOnly(const QStringList &paths) {
+        QSet<QString> keep;
+        for (const QString &path : paths) keep.insert(QFileInfo(path).absoluteFilePath());
+
+        QMutexLocker locker(&mutex);
+        for (auto it = models.begin(); it != models.end();) {
+            if (keep.contains(it.key())) {
+                ++it;
+            } else {
+                it = models.erase(it);
+            }
+        }
+    }
+
+    void ModelCache::trimToSize(qint64 maxBytes) {
+        QMutexLocker locker(&mutex);
+
+        qint64 byteSize = 0;
+        QVector<QPair<quint64, QString>> byAge; //Last used, path
+        byAge.reserve(models.size());
+        for (auto it = models.constBegin(); it != models.constEnd(); ++it) {
+            byteSize += it->model->byteSize;
+            byAge.append(qMakePair(it->lastUsed, it.key()));
+        }
+
+        std::sort(byAge.begin(), byAge.end());
+        for (int i = 0; i < byAge.size() && byteSize > maxBytes; i++) {
+            byteSize -= models.value(byAge.at(i).second).model->byteSize;
+            models.remove(byAge.at(i).second);
+        }
+    }
+
+    void ModelCache::clear() {
+        QMutexLocker locker(&mutex);
+        models.clear();
+    }
+
+    int ModelCache::getCount() {
+        QMutexLocker locker(&mutex);
+        return models.size();
+    }
+
+    qint64 ModelCache::getByteSize() {
+        QMutexLocker locker(&mutex);
+
+        qint64 byteSize = 0;
+        foreach(const Entry &entry, models) byteSize += entry.model->byteSize;
+        return byteSize;
+    }
+}
+
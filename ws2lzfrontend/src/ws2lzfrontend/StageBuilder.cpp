@@ -0,0 +1,254 @@
+#include "ws2lzfrontend/StageBuilder.hpp"
+#include "ws2common/config/XMLConfigParser.hpp"
+#include "ws2common/exception/RuntimeException.hpp"
+#include "ws2common/MessageHandler.hpp"
+#include "ws2common/ThreadPoolUtils.hpp"
+#include "ws2lz/SMB2LzExporter.hpp"
+#include "ws2lz/LZCompressor.hpp"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QBuffer>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QHash>
+#include <QDebug>
+
+namespace WS2LzFrontend {
+    using namespace WS2Common;
+
+    StageBuilder::StageBuilder(ModelCache &modelCache, WS2Lz::CollisionCache *collisionCache) :
+        modelCache(modelCache),
+        collisionCache(collisionCache) {}
+
+    StageBuilder::~StageBuilder() {
+        delete stage;
+    }
+
+    void StageBuilder::setProfiler(Profiler *profiler) {
+        this->profiler = profiler;
+    }
+
+    bool StageBuilder::loadConfig(const QString &configPath) {
+        this->configPath = configPath;
+
+        qInfo() << "Parsing configuration...";
+        QFile configFile(configPath);
+        if (!configFile.open(QIODevice::ReadOnly)) {
+            qCritical().noquote() << "Failed to open configuration file" << configPath << "-" << configFile.errorString();
+            return false;
+        }
+
+        //Get the config file directory, for relative file paths in the config
+        QFileInfo configFileInfo(configFile);
+        QDir configFileDir = configFileInfo.dir();
+
+        //Parse straight from the file, rather than reading it all into a string first
+        Config::XMLConfigParser confParser;
+        Stage *newStage;
+        {
+            Profiler::Scope scope(profiler, "Parse configuration", "config");
+            newStage = confParser.parseStage(configFile, configFileDir);
+        }
+        configFile.close();
+        qInfo() << newStage->getRootNode();
+
+        delete stage;
+        stage = newStage;
+
+        return true;
+    }
+
+    namespace {
+        /**
+         * @brief Fetches a single model from a ModelCache on a thread pool
+         */
+        class LoadModelTask : public QRunnable {
+            public:
+                ModelCache *modelCache;
+                Profiler *profiler;
+                const Model::MeshRequirements *requirements;
+                QString path;
+                QSharedPointer<const LoadedModel> *model;
+                QString *error;
+                QSemaphore *finished;
+
+                /**
+                 * @brief The message prefix of the thread that started this task, so warnings are tagged the same
+                 */
+                QString messagePrefix;
+
+                virtual void run() override {
+                    MessagePrefixScope prefixScope(messagePrefix);
+
+                    try {
+                        *model = modelCache->getModel(path, profiler, requirements);
+                    } catch (const Exception::RuntimeException &e) {
+                        *error = e.getMessage();
+                    } catch (...) {
+                        *error = "Unknown error";
+                    }
+
+                    finished->release();
+                }
+        };
+    }
+
+    bool StageBuilder::loadModels() {
+        if (stage == nullptr) return false;
+
+        qInfo() << "Loading models...";
+        Profiler::Scope scope(profiler, "Load models", "model");
+
+        //Only load what the exporter will actually read - no unreferenced meshes, normals, UVs or textures
+        Model::MeshRequirements requirements = WS2Lz::SMB2LzExporter::getMeshRequirements(*stage);
+
+        //Each file is loaded once, even if the config lists it more than once
+        QStringList paths;
+        QStringList uniquePaths;
+        QHash<QString, int> uniquePathIndices;
+        foreach(QUrl url, stage->getModels()) {
+            QString path = url.toLocalFile(); //Assumes the URL is local //TODO: Allow network locations maybe
+            paths.append(path);
+            if (!uniquePathIndices.contains(path)) {
+                uniquePathIndices.insert(path, uniquePaths.size());
+                uniquePaths.append(path);
+            }
+        }
+
+        //Load all files at once - Assimp spends most of its time on a single thread per file
+        QVector<QSharedPointer<const LoadedModel>> uniqueModels(uniquePaths.size());
+        QVector<QString> errors(uniquePaths.size());
+        QSemaphore finished;
+        for (int i = 0; i < uniquePaths.size(); i++) {
+            LoadModelTask *task = new LoadModelTask();
+            task->modelCache = &modelCache;
+            task->profiler = profiler;
+            task->requirements = &requirements;
+            task->path = uniquePaths.at(i);
+            task->model = &uniqueModels[i];
+            task->error = &errors[i];
+            task->finished = &finished;
+            task->messagePrefix = MessagePrefixScope::getCurrentPrefix();
+            ThreadPoolUtils::startGlobal(task);
+        }
+
+        {
+            //If this is running on the global thread pool, don't hold up the loads by taking one of its threads
+            ThreadPoolUtils::WaitScope waitScope;
+            finished.acquire(uniquePaths.size());
+        }
+
+        //Report errors in config order, so the same error is reported as when loading one after another
+        for (int i = 0; i < uniquePaths.size(); i++) {
+            if (!errors.at(i).isNull()) {
+                qCritical().noquote() << "Error while loading model" << uniquePaths.at(i) << "-" << errors.at(i);
+                return false;
+            }
+        }
+
+        //Merge in config order, so that when files share a mesh name, the last file listed wins as it always has
+        QVector<QSharedPointer<const LoadedModel>> newLoadedModels;
+        QHash<QString, Resource::ResourceMesh*> newModels;
+        foreach(const QString &path, paths) {
+            QSharedPointer<const LoadedModel> model = uniqueModels.at(uniquePathIndices.value(path));
+
+            newLoadedModels.append(model);
+            foreach(Resource::ResourceMesh* mesh, model->meshes) {
+                newModels[mesh->getId()] = mesh; //TODO: Use some getMeshName function or something if I ever add that
+            }
+        }
+
+        //Only swap these over now, so the previous models stay alive until the new ones are all loaded
+        loadedModels = newLoadedModels;
+        models = newModels;
+
+        return true;
+    }
+
+    bool StageBuilder::exportStage(const ExportSettings &settings) {
+        if (stage == nullptr) return false;
+
+        qInfo() << "Exporting file...";
+        QBuffer buf;
+        buf.open(QIODevice::ReadWrite);
+        QDataStream dStream(&buf);
+
+        if (settings.gameVersion == EnumGameVersion::SUPER_MONKEY_BALL_1) {
+            qCritical() << "SMB 1 export not yet implemented";
+            return false;
+        } else if (settings.gameVersion == EnumGameVersion::SUPER_MONKEY_BALL_2) {
+            Profiler::Scope scope(profiler, "Export", "export");
+            WS2Lz::SMB2LzExporter exporter;
+
+            exporter.setModels(models);
+            exporter.setProfiler(profiler);
+            exporter.setCollisionCache(collisionCache);
+            exporter.generate(dStream, *stage);
+        }
+
+        buf.seek(0);
+        //Write the uncompressed file if requested
+        if (!settings.outputPath.isEmpty()) {
+            qInfo() << "Writing uncompressed file...";
+            Profiler::Scope scope(profiler, "Write uncompressed file", "output");
+            QFile o(settings.outputPath);
+            if (!o.open(QIODevice::WriteOnly)) {
+                qCritical().noquote() << "Failed to open output file" << settings.outputPath << "-" << o.errorString();
+                return false;
+            }
+            o.write(buf.data());
+            o.close();
+        }
+
+        if (!settings.compressedOutputPath.isEmpty()) {
+            qInfo() << "Writing compressed file... This may take a while";
+            QElapsedTimer timer; //Measure how long this operation takes - probably a little while
+            timer.start();
+            QFile o(settings.compressedOutputPath);
+            WS2Lz::LZCompressor compressor;
+            QByteArray compressed;
+            {
+                Profiler::Scope scope(profiler, "Compress", "compress");
+                compressed = compressor.compress(buf.data());
+            }
+            {
+                Profiler::Scope scope(profiler, "Write compressed file", "output");
+                if (!o.open(QIODevice::WriteOnly)) {
+                    qCritical().noquote() << "Failed to open output file" << settings.compressedOutputPath << "-" << o.errorString();
+                    return false;
+                }
+                o.write(compressed);
+                o.close();
+            }
+            qInfo().noquote().nospace() << "Finished compressing file in " << timer.nsecsElapsed() / 1000000000.0f << "s";
+        }
+
+        buf.close();
+
+        return true;
+    }
+
+    bool StageBuilder::build(const QString &configPath, const ExportSettings &settings) {
+        return loadConfig(configPath) && loadModels() && exportStage(settings);
+    }
+
+    const QString& StageBuilder::getConfigPath() const {
+        return configPath;
+    }
+
+    QStringList StageBuilder::getModelPaths() const {
+        QStringList paths;
+        if (stage == nullptr) return paths;
+
+        foreach(QUrl url, stage->getModels()) paths.append(url.toLocalFile());
+        return paths;
+    }
+
+    const Stage* StageBuilder::getStage() const {
+        return stage;
+    }
+}
+
@@ -0,0 +1,131 @@
+#include "ws2lzfrontend/Watcher.hpp"
+#include <QFileInfo>
+#include <QDir>
+#include <QDebug>
+
+namespace WS2LzFrontend {
+    Watcher::Watcher(
+            StageBuilder &builder,
+            ModelCache &modelCache,
+            const QString &configPath,
+            const ExportSettings &settings,
+            QObject *parent
+            ) :
+        QObject(parent),
+        builder(builder),
+        modelCache(modelCache),
+        configPath(QFileInfo(configPath).absoluteFilePath()),
+        settings(settings) {
+        debounceTimer.setSingleShot(true);
+        debounceTimer.setInterval(DEBOUNCE_MSECS);
+
+        connect(&fileWatcher, &QFileSystemWatcher::fileChanged, this, &Watcher::onFileChanged);
+        connect(&fileWatcher, &QFileSystemWatcher::directoryChanged, this, &Watcher::onDirectoryChanged);
+        connect(&debounceTimer, &QTimer::timeout, this, &Watcher::rebuild);
+    }
+
+    void Watcher::start() {
+        //Treat the initial build as if everything changed
+        configChanged = true;
+        latencyTimer.start();
+        rebuild();
+    }
+
+    void Watcher::updateWatchedFiles() {
+        QStringList paths;
+        paths.append(configPath);
+        foreach(const QString &modelPath, builder.getModelPaths()) paths.append(QFileInfo(modelPath).absoluteFilePath());
+
+        QStringList watchedFiles = fileWatcher.files();
+        QStringList watchedDirs = fileWatcher.directories();
+
+        foreach(const QString &path, paths) {
+            QFileInfo info(path);
+            if (info.exists() && !watchedFiles.contains(path)) fileWatcher.addPath(path);
+
+            QString dir = info.absolutePath();
+            if (!watchedDirs.contains(dir)) {
+                fileWatcher.addPath(dir);
+                watchedDirs.append(dir);
+            }
+        }
+
+        //Stop watching models the stage no longer uses
+        foreach(const QString &path, watchedFiles) {
+            if (!paths.contains(path)) fileWatcher.removePath(path);
+        }
+    }
+
+    void Watcher::markChanged(const QString &path) {
+        if (!configChanged && changedModels.isEmpty()) latencyTimer.start();
+
+        if (path == configPath) {
+            configChanged = true;
+        } else {
+            changedModels.insert(path);
+        }
+
+        debounceTimer.start(); //Restarts the timer if it's already running
+    }
+
+    void Watcher::onFileChanged(const QString &path) {
+        markChanged(path);
+    }
+
+    void Watcher::onDirectoryChanged(const QString &path) {
+        Q_UNUSED(path);
+
+        //Any watched file that exists but is no longer being watched was replaced
+        QStringList watchedFiles = fileWatcher.files();
+        QStringList paths;
+        paths.append(configPath);
+        foreach(const QString &modelPath, builder.getModelPaths()) paths.append(QFileInfo(modelPath).absoluteFilePath());
+
+        foreach(const QString &filePath, paths) {
+            if (!watchedFiles.contains(filePath) && QFileInfo::exists(filePath)) {
+                fileWatcher.addPath(filePath);
+                markChanged(filePath);
+            }
+        }
+    }
+
+    void Watcher::rebuild() {
+        rebuildCount++;
+        QElapsedTimer rebuildTimer;
+        rebuildTimer.start();
+
+        bool reparse = configChanged;
+        QSet<QString> reloaded = changedModels;
+        configChanged = false;
+        changedModels.clear();
+
+        //Changed models need reloading even if their modification time and size look the same
+        foreach(const QString &path, reloaded) modelCache.invalidate(path);
+
+        bool success = true;
+        if (reparse) success = builder.loadConfig(configPath);
+        if (success) success = builder.loadModels();
+        if (success) success = builder.exportStage(settings);
+
+        //Drop models the config no longer uses, and watch any new ones
+        modelCache.retainOnly(builder.getModelPaths());
+        updateWatchedFiles();
+
+        QStringList changes;
+        if (reparse) changes.append(QFileInfo(configPath).fileName());
+        foreach(const QString &path, reloaded) changes.append(QFileInfo(path).fileName());
+
+        if (success) {
+            qInfo().noquote().nospace() << "Rebuild #" << rebuildCount << " (" << changes.join(", ") << ") finished in " <<
+                rebuildTimer.nsecsElapsed() / 1000000000.0f << "s - " << latencyTimer.nsecsElapsed() / 1000000000.0f <<
+                "s after the change was noticed";
+        } else {
+            qCritical().noquote().nospace() << "Rebuild #" << rebuildCount << " (" << changes.join(", ") << ") failed after " <<
+                rebuildTimer.nsecsElapsed() / 1000000000.0f << "s";
+        }
+        qInfo().noquote() << "Watching for changes... (Press Ctrl+C to stop)";
+
+        emit rebuilt(success);
+    }
+}
+
@@ -1,20 +1,40 @@
 #include "ws2common/MessageHandler.hpp"
+#include "ws2common/Profiler.hpp"
 #include "ws2common/EnumGameVersion.hpp"
-#include "ws2common/config/XMLConfigParser.hpp"
 #include "ws2common/model/ModelLoader.hpp"
-#include "ws2lz/SMB2LzExporter.hpp"
-#include "ws2lz/LZCompressor.hpp"
+#include "ws2common/config/XMLConfigParser.hpp"
+#include "ws2lzfrontend/ModelCache.hpp"
+#include "ws2lzfrontend/StageBuilder.hpp"
+#include "ws2lzfrontend/Watcher.hpp"
+#include "ws2lzfrontend/BuildServer.hpp"
+#include "ws2lz/CollisionCache.hpp"
 #include <QCoreApplication>
 #include <QTranslator>
 #include <QCommandLineParser>
 #include <QFile>
-#include <QFileInfo>
 #include <QDir>
-#include <QBuffer>
-#include <QDataStream>
-#include <QHash>
+#include <QFileInfo>
+#include <QThread>
+#include <QJsonArray>
 #include <QDebug>
-#include <QElapsedTimer>
+
+/**
+ * @brief Writes recorded profiling data to a file
+ *
+ * @param profiler The profiler to write data from
+ * @param path The file to write to
+ * @param format The format to write in
+ */
+static void writeProfile(WS2Common::Profiler *profiler, const QString &path, WS2Common::Profiler::EnumOutputFormat format) {
+    QFile profileFile(path);
+    if (profileFile.open(QIODevice::WriteOnly)) {
+        profileFile.write(profiler->toJson(format));
+        profileFile.close();
+        qInfo().noquote() << "Wrote profile to" << profileFile.fileName();
+    } else {
+        qCritical().noquote() << "Failed to open profile output file" << profileFile.fileName();
+    }
+}
 
 int main(int argc, char *argv[]) {
     qInstallMessageHandler(WS2Common::messageHandler);
@@ -46,7 +66,20 @@ int main(int argc, char *argv[]) {
             {{"o", "output"}, QCoreApplication::translate("main", "Output path to an uncompressed LZ file."), QCoreApplication::translate("main", "uncompressed output file")},
             {{"s", "compressed-output"}, QCoreApplication::translate("main", "Output path to a compressed LZ file."), QCoreApplication::translate("main", "output file")},
             {{"g", "game-version"}, QCoreApplication::translate("main", "The version of SMB to generate an LZ file for (1/2/deluxe)."), QCoreApplication::translate("main", "version")},
-            {{"v", "verbose"}, QCoreApplication::translate("main", "Enable verbose logging")}
+            {{"v", "verbose"}, QCoreApplication::translate("main", "Enable verbose logging")},
+            {"profile", QCoreApplication::translate("main", "Record wall time, CPU time and peak memory usage for each export stage, and write it to a file."), QCoreApplication::translate("main", "profile output file")},
+            {"profile-format", QCoreApplication::translate("main", "The format to write profiling data in (json/trace). trace outputs Chrome trace events. Defaults to json."), QCoreApplication::translate("main", "format"), "json"},
+            {"collision-cache", QCoreApplication::translate("main", "Directory to cache optimized collision in. Item groups with unchanged collision since a previous export are reused from here instead of being optimized again."), QCoreApplication::translate("main", "cache directory")},
+            {"mesh-cache", QCoreApplication::translate("main", "Directory to cache imported models in. Unchanged models are read from here instead of being imported again."), QCoreApplication::translate("main", "cache directory")},
+            {"weld-vertices", QCoreApplication::translate("main", "Merge duplicate vertices and reorder triangles when importing models. This uses less memory, but collision triangles may be exported in a different order.")},
+            {"parallel-parse", QCoreApplication::translate("main", "Parse item groups in the configuration file in parallel. The whole file is read into memory first.")},
+            {"validate", QCoreApplication::translate("main", "Only check the configuration file for errors, without loading models or exporting. Each error is printed with its line and column.")},
+            {{"w", "watch"}, QCoreApplication::translate("main", "Keep running, and export again whenever the configuration file or any models it uses change. Only what changed is reloaded.")},
+            {"serve", QCoreApplication::translate("main", "Run as a build server, accepting export jobs over a local socket. Models and optimized collision are kept cached between jobs.")},
+            {"submit", QCoreApplication::translate("main", "Send the export to a running build server (See --serve) instead of exporting in this process.")},
+            {"socket", QCoreApplication::translate("main", "The name of the local socket used by --serve and --submit."), QCoreApplication::translate("main", "name"), "ws2lzfrontend"},
+            {"jobs", QCoreApplication::translate("main", "With --serve, the maximum number of export jobs to run at once. Defaults to the number of CPU cores."), QCoreApplication::translate("main", "count")},
+            {"model-cache-size", QCoreApplication::translate("main", "With --serve, roughly how much memory models cached between jobs may take up, in MiB. The least recently used models are dropped past this."), QCoreApplication::translate("main", "MiB"), "1024"}
             });
 
     parser.process(app);
@@ -68,12 +101,66 @@ int main(int argc, char *argv[]) {
     //Check for verbose logging
     WS2Common::setDebugLoggingEnabled(parser.isSet("v"));
 
+    WS2Common::Model::ModelLoader::setVertexWeldingEnabled(parser.isSet("weld-vertices"));
+    WS2Common::Config::XMLConfigParser::setParallelParsingEnabled(parser.isSet("parallel-parse"));
+    if (parser.isSet("mesh-cache")) WS2Common::Model::ModelLoader::setMeshCacheDirectory(parser.value("mesh-cache"));
+
+    if (parser.isSet("serve")) {
+        //Build server mode - jobs supply their own config and output paths
+        int maxJobs = QThread::idealThreadCount();
+        if (parser.isSet("jobs")) {
+            bool jobsOk;
+            maxJobs = parser.value("jobs").toInt(&jobsOk);
+            if (!jobsOk || maxJobs < 1) {
+                qCritical().noquote() << QCoreApplication::translate("main", "Invalid job count specified. Use --help for more info.");
+                return EXIT_FAILURE;
+            }
+        }
+
+        bool modelCacheSizeOk;
+        qint64 modelCacheMiB = parser.value("model-cache-size").toLongLong(&modelCacheSizeOk);
+        if (!modelCacheSizeOk || modelCacheMiB < 0) {
+            qCritical().noquote() << QCoreApplication::translate("main", "Invalid model cache size specified. Use --help for more info.");
+            return EXIT_FAILURE;
+        }
+
+        WS2LzFrontend::BuildServer server(maxJobs, modelCacheMiB * 1024 * 1024);
+        if (parser.isSet("collision-cache")) server.getCollisionCache().setCacheDirectory(parser.value("collision-cache"));
+        if (!server.listen(parser.value("socket"))) return EXIT_FAILURE;
+
+        return app.exec();
+    }
+
     //Check for a valid input
     if (!parser.isSet("c")) {
         qCritical().noquote() << QCoreApplication::translate("main", "No confiuration file specified. Use --help for more info.");
         return EXIT_FAILURE;
     }
 
+    if (parser.isSet("validate")) {
+        QString configPath = parser.value("c");
+        QFile configFile(configPath);
+        if (!configFile.open(QIODevice::ReadOnly)) {
+            qCritical().noquote() << QCoreApplication::translate("main", "Failed to open configuration file %1").arg(configPath);
+            return EXIT_FAILURE;
+        }
+
+        QVector<WS2Common::Config::XMLConfigParser::ValidationError> errors =
+            WS2Common::Config::XMLConfigParser::validateStage(configFile, QFileInfo(configFile).dir());
+
+        foreach(const WS2Common::Config::XMLConfigParser::ValidationError &error, errors) {
+            qCritical().noquote() << QString("%1:%2:%3: %4").arg(configPath).arg(error.line).arg(error.column).arg(error.message);
+        }
+
+        if (!errors.isEmpty()) {
+            qCritical().noquote() << QCoreApplication::translate("main", "%n error(s) found", "", errors.size());
+            return EXIT_FAILURE;
+        }
+
+        qInfo().noquote() << QCoreApplication::translate("main", "No errors found");
+        return EXIT_SUCCESS;
+    }
+
     //Check for a valid output
     if (!(parser.isSet("o") || parser.isSet("s"))) {
         qCritical().noquote() << QCoreApplication::translate("main", "No output file specified. Use --help for more info.");
@@ -98,79 +185,93 @@ int main(int argc, char *argv[]) {
         }
     }
 
-    qInfo() << "Reading configuration...";
-    QFile configFile(parser.value("c"));
-    configFile.open(QIODevice::ReadOnly | QIODevice::Text);
-    QString config = configFile.readAll();
-    configFile.close();
-
-    //Get the config file directory, for relative file paths in the config
-    QFileInfo configFileInfo(configFile);
-    QDir configFileDir = configFileInfo.dir();
-
-    qInfo() << "Parsing configuration...";
-    WS2Common::Config::XMLConfigParser confParser;
-    WS2Common::Stage *stage = confParser.parseStage(config, configFileDir);
-    qInfo() << stage->getRootNode();
-
-    qInfo() << "Loading models...";
-    //resources is only really used to conserve some memory, by preventing the creation of duplicate textures
-    QMutex resourcesMutex;
-    QVector<WS2Common::Resource::AbstractResource*> resources;
-    QHash<QString, WS2Common::Resource::ResourceMesh*> models; //name, mesh - Using a hashmap as it will have a quicker lookup
-
-    //Load each model
-    foreach(QUrl url, stage->getModels()) {
-        QFile file(url.toLocalFile()); //Assumes the URL is local //TODO: Allow network locations maybe
-        QVector<WS2Common::Resource::ResourceMesh*> meshVec = WS2Common::Model::ModelLoader::loadModel(file, &resources, &resourcesMutex);
-        foreach(WS2Common::Resource::ResourceMesh* mesh, meshVec) {
-            models[mesh->getId()] = mesh; //TODO: Use some getMeshName function or something if I ever add that
+    if (parser.isSet("submit")) {
+        //Thin client - the server may have a different working directory, so send absolute paths
+        WS2LzFrontend::BuildJob job;
+        job.configPath = QFileInfo(parser.value("c")).absoluteFilePath();
+        job.settings.gameVersion = gameVersion;
+        if (parser.isSet("o")) job.settings.outputPath = QFileInfo(parser.value("o")).absoluteFilePath();
+        if (parser.isSet("s")) job.settings.compressedOutputPath = QFileInfo(parser.value("s")).absoluteFilePath();
+
+        QJsonObject response;
+        QString error;
+        if (!WS2LzFrontend::BuildServer::submitJob(parser.value("socket"), job, response, error)) {
+            qCritical().noquote() << error;
+            return EXIT_FAILURE;
         }
-    }
 
-    qInfo() << "Exporting file...";
-    QBuffer buf;
-    buf.open(QIODevice::ReadWrite);
-    QDataStream dStream(&buf);
+        foreach(const QJsonValue &timing, response.value("timings").toArray()) {
+            QJsonObject stage = timing.toObject();
+            qInfo().noquote().nospace() << "    " << stage.value("name").toString() << ": " <<
+                stage.value("wallMs").toDouble() << "ms";
+        }
 
-    if (gameVersion == WS2Common::EnumGameVersion::SUPER_MONKEY_BALL_1) {
-        qCritical() << "SMB 1 export not yet implemented";
-        return EXIT_FAILURE;
-    } else if (gameVersion == WS2Common::EnumGameVersion::SUPER_MONKEY_BALL_2) {
-        WS2Lz::SMB2LzExporter exporter;
+        if (response.value("status").toString() != "ok") {
+            qCritical().noquote() << QCoreApplication::translate("main", "Build server job failed:") << response.value("error").toString();
+            return EXIT_FAILURE;
+        }
 
-        exporter.setModels(models);
-        exporter.generate(dStream, *stage);
+        qInfo().noquote().nospace() << "Build server job finished in " << response.value("wallSeconds").toDouble() << "s";
+        return EXIT_SUCCESS;
     }
 
-    buf.seek(0);
-    //Write the uncompressed file if requested
-    if (parser.isSet("o")) {
-        qInfo() << "Writing uncompressed file...";
-        QFile o(parser.value("o"));
-        o.open(QIODevice::WriteOnly);
-        o.write(buf.data());
-        o.close();
+    //Check if we should profile each stage
+    WS2Common::Profiler *profiler = nullptr;
+    WS2Common::Profiler::EnumOutputFormat profileFormat = WS2Common::Profiler::EnumOutputFormat::JSON;
+    if (parser.isSet("profile")) {
+        if (parser.value("profile-format") == "json") {
+            profileFormat = WS2Common::Profiler::EnumOutputFormat::JSON;
+        } else if (parser.value("profile-format") == "trace") {
+            profileFormat = WS2Common::Profiler::EnumOutputFormat::TRACE_EVENT;
+        } else {
+            qCritical().noquote() << QCoreApplication::translate("main", "Invalid profile format specified. Use --help for more info.");
+            return EXIT_FAILURE;
+        }
+
+        profiler = new WS2Common::Profiler();
     }
 
-    if (parser.isSet("s")) {
-        qInfo() << "Writing compressed file... This may take a while";
-        QElapsedTimer timer; //Measure how long this operation takes - probably a little while
-        timer.start();
-        QFile o(parser.value("s"));
-        WS2Lz::LZCompressor compressor;
-        o.open(QIODevice::WriteOnly);
-        o.write(compressor.compress(buf.data()));
-        o.close();
-        qInfo().noquote().nospace() << "Finished compressing file in " << timer.nsecsElapsed() / 1000000000.0f << "s";
+    WS2LzFrontend::ExportSettings settings;
+    settings.gameVersion = gameVersion;
+    if (parser.isSet("o")) settings.outputPath = parser.value("o");
+    if (parser.isSet("s")) settings.compressedOutputPath = parser.value("s");
+
+    WS2LzFrontend::ModelCache modelCache;
+    WS2Lz::CollisionCache collisionCache;
+    if (parser.isSet("collision-cache")) collisionCache.setCacheDirectory(parser.value("collision-cache"));
+
+    //Only use the collision cache for a single export if it's persisted - there's nothing to reuse otherwise
+    bool useCollisionCache = parser.isSet("watch") || parser.isSet("collision-cache");
+    WS2LzFrontend::StageBuilder builder(modelCache, useCollisionCache ? &collisionCache : nullptr);
+    builder.setProfiler(profiler);
+
+    if (parser.isSet("watch")) {
+        WS2LzFrontend::Watcher watcher(builder, modelCache, parser.value("c"), settings);
+
+        if (profiler != nullptr) {
+            //Write a profile of each rebuild, replacing the last one
+            QObject::connect(&watcher, &WS2LzFrontend::Watcher::rebuilt, [&](bool) {
+                writeProfile(profiler, parser.value("profile"), profileFormat);
+                profiler->clear();
+            });
+        }
+
+        watcher.start();
+        int ret = app.exec();
+
+        delete profiler;
+        return ret;
     }
 
-    buf.close();
+    bool success = builder.build(parser.value("c"), settings);
+
+    //Write out profiling data if requested
+    if (profiler != nullptr) writeProfile(profiler, parser.value("profile"), profileFormat);
 
     //Cleanup
-    delete stage;
-    qDeleteAll(resources);
-    //No need to qDeleteAll(models) - The resources vector contains the models that are all deleted
+    delete profiler;
+
+    if (!success) return EXIT_FAILURE;
 
     return EXIT_SUCCESS;
 }